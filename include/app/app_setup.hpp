@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <memory>
 #include <optional>
 #include <string>
@@ -15,9 +16,38 @@ namespace app {
 auto ParsePipeName(const std::vector<std::string>& args)
     -> std::optional<std::string>;
 
+/// Output format of `--check`
+enum class CheckFormat { kJson, kSarif };
+
+struct CheckOptions {
+  std::string workspace = ".";
+  CheckFormat format = CheckFormat::kJson;
+  /// Compilation threads; 0 uses all hardware threads
+  size_t jobs = 0;
+};
+
+/// Parse `--check [<workspace dir>] [--format=json|sarif] [--jobs=<n>]`
+/// Returns nullopt if args[1] is not --check or an option is invalid
+auto ParseCheckOptions(const std::vector<std::string>& args)
+    -> std::optional<CheckOptions>;
+
+struct IndexOptions {
+  std::string workspace = ".";
+  /// Artifact path; the server's default location if unset
+  std::optional<std::string> out;
+  /// Compilation threads; 0 uses all hardware threads
+  size_t jobs = 0;
+};
+
+/// Parse `index [<workspace dir>] [--out <file>] [--jobs=<n>]`
+/// Returns nullopt if args[1] is not index or an option is invalid
+auto ParseIndexOptions(const std::vector<std::string>& args)
+    -> std::optional<IndexOptions>;
+
 /// Setup structured logging with named loggers
 /// Returns configured loggers for transport, jsonrpc, and slangd components
-auto SetupLoggers()
+/// Logs go to stdout unless `to_stderr` (stdout carries `--check` output)
+auto SetupLoggers(bool to_stderr = false)
     -> std::unordered_map<std::string, std::shared_ptr<spdlog::logger>>;
 
 }  // namespace app
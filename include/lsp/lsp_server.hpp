@@ -44,6 +44,18 @@ class LspServer {
  protected:
   void RegisterHandlers();
 
+  // Called after the standard handlers are registered. Servers register
+  // their custom requests here (see RegisterCustomMethodCall).
+  virtual void RegisterExtensionHandlers() {
+  }
+
+  // Register custom request handler (for server-specific extensions)
+  template <typename Params, typename Result, typename Handler>
+  void RegisterCustomMethodCall(const std::string& method, Handler handler) {
+    endpoint_->RegisterMethodCall<Params, Result, LspError>(
+        method, std::move(handler));
+  }
+
  private:
   std::shared_ptr<spdlog::logger> logger_;
   std::unique_ptr<jsonrpc::endpoint::RpcEndpoint> endpoint_;
@@ -196,7 +208,14 @@ class LspServer {
 
   // TODO(hankhsu1996): Go to Type Definition
   // TODO(hankhsu1996): Go to Implementation
-  // TODO(hankhsu1996): Find References
+
+  // Find References Request
+  virtual auto OnReferences(ReferenceParams /*unused*/)
+      -> asio::awaitable<std::expected<ReferenceResult, LspError>> {
+    co_return LspError::UnexpectedFromCode(
+        LspErrorCode::kMethodNotImplemented, "OnReferences is not implemented");
+  }
+
   // TODO(hankhsu1996): Prepare Call Hierarchy
   // TODO(hankhsu1996): Call Hierarchy Incoming Calls
   // TODO(hankhsu1996): Call Hierarchy Outgoing Calls
@@ -272,7 +291,14 @@ class LspServer {
   // TODO(hankhsu1996): Prepare Rename
   // TODO(hankhsu1996): Linked Editing Range
 
-  // TODO(hankhsu1996): Workspace Symbols
+  // Workspace Symbols Request
+  virtual auto OnWorkspaceSymbols(WorkspaceSymbolParams /*unused*/)
+      -> asio::awaitable<std::expected<WorkspaceSymbolResult, LspError>> {
+    co_return LspError::UnexpectedFromCode(
+        LspErrorCode::kMethodNotImplemented,
+        "OnWorkspaceSymbols is not implemented");
+  }
+
   // TODO(hankhsu1996): Workspace Symbol Resolve
   // TODO(hankhsu1996): Get Configuration
   // TODO(hankhsu1996): Did Change Configuration
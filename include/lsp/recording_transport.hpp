@@ -0,0 +1,85 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <asio.hpp>
+#include <jsonrpc/error/error.hpp>
+#include <jsonrpc/transport/transport.hpp>
+#include <spdlog/spdlog.h>
+
+namespace lsp {
+
+// One line of a recording
+struct RecordedMessage {
+  enum class Direction : uint8_t {
+    kIn,   // Client -> server
+    kOut,  // Server -> client
+  };
+
+  // Since the transport was created
+  std::chrono::microseconds time{0};
+  Direction direction = Direction::kIn;
+  // Raw JSON-RPC message, without framing
+  std::string message;
+};
+
+// Reads a file written by RecordingTransport
+auto ReadRecording(const std::filesystem::path& path)
+    -> std::expected<std::vector<RecordedMessage>, std::string>;
+
+// RecordingTransport: Forwards to another transport and appends every
+// message, with its direction and a timestamp, to a JSON Lines file:
+//
+//   {"timeUs":1234,"direction":"in","message":"{\"jsonrpc\":\"2.0\",...}"}
+//
+// Lines are flushed as they are written, so a crashed session still leaves
+// a usable recording. Enabled in slangd with SLANGD_RECORD=<path>; replayed
+// by //tools/replay.
+class RecordingTransport : public jsonrpc::transport::Transport {
+ public:
+  RecordingTransport(
+      asio::any_io_executor executor,
+      std::unique_ptr<jsonrpc::transport::Transport> inner,
+      const std::filesystem::path& path,
+      std::shared_ptr<spdlog::logger> logger = nullptr);
+
+  auto Start()
+      -> asio::awaitable<std::expected<void, jsonrpc::error::RpcError>>
+      override;
+
+  auto SendMessage(std::string message)
+      -> asio::awaitable<std::expected<void, jsonrpc::error::RpcError>>
+      override;
+
+  auto ReceiveMessage()
+      -> asio::awaitable<std::expected<std::string, jsonrpc::error::RpcError>>
+      override;
+
+  auto Close()
+      -> asio::awaitable<std::expected<void, jsonrpc::error::RpcError>>
+      override;
+
+  void CloseNow() override;
+
+ private:
+  auto Append(RecordedMessage::Direction direction, const std::string& message)
+      -> void;
+
+  std::unique_ptr<jsonrpc::transport::Transport> inner_;
+  std::chrono::steady_clock::time_point start_;
+
+  std::mutex mutex_;
+  std::ofstream out_;
+
+  std::shared_ptr<spdlog::logger> logger_;
+};
+
+}  // namespace lsp
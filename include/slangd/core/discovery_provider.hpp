@@ -61,9 +61,12 @@ class WorkspaceDiscoveryProvider : public DiscoveryProviderBase {
       -> std::vector<CanonicalPath> override;
 
  private:
-  // Recursively find SystemVerilog files in a directory
-  [[nodiscard]] auto FindSystemVerilogFilesInDirectory(
-      const CanonicalPath& directory) const -> std::vector<CanonicalPath>;
+  // Walk the roots in parallel and collect SystemVerilog files, skipping
+  // hidden directories and subtrees fully excluded by PathExclude
+  [[nodiscard]] auto FindSystemVerilogFiles(
+      const CanonicalPath& workspace_root,
+      const std::vector<CanonicalPath>& roots,
+      const SlangdConfigFile& config) const -> std::vector<CanonicalPath>;
 
   std::shared_ptr<spdlog::logger> logger_;
 };
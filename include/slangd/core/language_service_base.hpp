@@ -1,11 +1,13 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <vector>
 
 #include <asio.hpp>
 #include <lsp/basic.hpp>
 #include <lsp/document_features.hpp>
+#include <lsp/document_sync.hpp>
 #include <lsp/error.hpp>
 #include <lsp/workspace.hpp>
 
@@ -49,6 +51,17 @@ class LanguageServiceBase {
       -> asio::awaitable<
           std::expected<std::vector<lsp::Location>, LspError>> = 0;
 
+  // Find all references to the symbol at the given position
+  virtual auto GetReferences(
+      std::string uri, lsp::Position position, bool include_declaration)
+      -> asio::awaitable<
+          std::expected<std::vector<lsp::Location>, LspError>> = 0;
+
+  // Search declarations across the workspace by name
+  virtual auto GetWorkspaceSymbols(std::string query)
+      -> asio::awaitable<
+          std::expected<std::vector<lsp::WorkspaceSymbol>, LspError>> = 0;
+
   // Get document symbol hierarchy
   virtual auto GetDocumentSymbols(std::string uri) -> asio::awaitable<
       std::expected<std::vector<lsp::DocumentSymbol>, LspError>> = 0;
@@ -65,19 +78,22 @@ class LanguageServiceBase {
       std::string uri, lsp::FileChangeType change_type)
       -> asio::awaitable<void> = 0;
 
-  // Document lifecycle events (protocol-level)
+  // Document lifecycle events (protocol-level). `request_id` identifies the
+  // LSP message in traces; work started for it is tagged with the same ID.
   // Called when document is opened in editor
   virtual auto OnDocumentOpened(
-      std::string uri, std::string content, int version)
+      std::string uri, std::string content, int version, uint64_t request_id)
       -> asio::awaitable<void> = 0;
 
-  // Called when document content changes (typing/editing)
+  // Called when document content changes (typing/editing). Changes are
+  // incremental or full-text events, applied in order.
   virtual auto OnDocumentChanged(
-      std::string uri, std::string content, int version)
-      -> asio::awaitable<void> = 0;
+      std::string uri, std::vector<lsp::TextDocumentContentChangeEvent> changes,
+      int version, uint64_t request_id) -> asio::awaitable<void> = 0;
 
   // Called when document is saved
-  virtual auto OnDocumentSaved(std::string uri) -> asio::awaitable<void> = 0;
+  virtual auto OnDocumentSaved(std::string uri, uint64_t request_id)
+      -> asio::awaitable<void> = 0;
 
   // Called when document is closed in editor
   virtual auto OnDocumentClosed(std::string uri) -> void = 0;
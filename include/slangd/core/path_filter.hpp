@@ -0,0 +1,66 @@
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <regex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+
+namespace slangd {
+
+// PathFilter: PathMatch/PathExclude patterns compiled once per config.
+//
+// Patterns are ECMAScript regexes matched against the whole relative path.
+// Most real patterns only use literals and `.*` (`.*/generated/.*`,
+// `rtl/.*\.sv$`); those compile to a list of literal segments matched in
+// linear time without std::regex. Anything else (alternation, classes,
+// quantified literals) falls back to a std::regex built once.
+class PathFilter {
+ public:
+  PathFilter() = default;
+
+  // Invalid patterns are logged and make the filter include everything
+  static auto Compile(
+      const std::vector<std::string>& path_match,
+      const std::vector<std::string>& path_exclude,
+      std::shared_ptr<spdlog::logger> logger = nullptr) -> PathFilter;
+
+  // Include if path matches any PathMatch (when given) and no PathExclude
+  [[nodiscard]] auto ShouldInclude(std::string_view relative_path) const
+      -> bool;
+
+  // True if every path under `relative_dir` is excluded, so discovery can
+  // skip the directory without listing it. Conservative: only PathExclude
+  // globs ending in `.*` (e.g. `.*/generated/.*`) are considered.
+  [[nodiscard]] auto ExcludesDirectory(std::string_view relative_dir) const
+      -> bool;
+
+  // Number of patterns using the regex fallback
+  [[nodiscard]] auto RegexFallbackCount() const -> size_t;
+
+ private:
+  // Literal segments separated by `.*`. A NUL character in a segment stands
+  // for `.` (any single character); paths never contain NUL.
+  struct Glob {
+    std::vector<std::string> segments;
+  };
+
+  struct Pattern {
+    std::optional<Glob> glob;
+    std::optional<std::regex> regex;
+
+    [[nodiscard]] auto Matches(std::string_view path) const -> bool;
+  };
+
+  static auto ParseGlob(std::string_view pattern) -> std::optional<Glob>;
+  static auto MatchGlob(const Glob& glob, std::string_view path) -> bool;
+
+  std::vector<Pattern> match_;
+  std::vector<Pattern> exclude_;
+  bool fail_open_ = false;
+};
+
+}  // namespace slangd
@@ -6,6 +6,7 @@
 
 #include <spdlog/spdlog.h>
 
+#include "slangd/core/path_filter.hpp"
 #include "slangd/utils/canonical_path.hpp"
 
 namespace slangd {
@@ -77,6 +78,13 @@ class SlangdConfigFile {
   [[nodiscard]] auto ShouldIncludeFile(std::string_view relative_path) const
       -> bool;
 
+  // True if PathExclude rules out every file under the directory (relative to
+  // workspace root with forward slashes), so discovery can prune it
+  [[nodiscard]] auto ExcludesDirectory(std::string_view relative_dir) const
+      -> bool {
+    return path_filter_.ExcludesDirectory(relative_dir);
+  }
+
   // Helper methods
   [[nodiscard]] auto HasFileSources() const -> bool {
     return !file_lists_.paths.empty() || !files_.empty();
@@ -105,6 +113,9 @@ class SlangdConfigFile {
   // Path filtering conditions
   PathCondition path_condition_;
 
+  // path_condition_ compiled once at load time
+  PathFilter path_filter_;
+
   // Auto-discovery flag (default: enabled)
   bool auto_discover_ = true;
 
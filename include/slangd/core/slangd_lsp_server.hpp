@@ -38,9 +38,18 @@ class SlangdLspServer : public lsp::LspServer {
   // Workspace folder from initialize request
   std::optional<lsp::WorkspaceFolder> workspace_folder_;
 
+  // Sequence number of the last traced LSP message (see utils::Tracer).
+  // The JSON-RPC layer does not expose message IDs to handlers, and
+  // notifications have none; handlers pass RequestScope::Id() explicitly to
+  // the work they start.
+  uint64_t last_request_id_ = 0;
+
   // Helper method to determine if a path is a config file
   static auto IsConfigFile(const std::string& path) -> bool;
 
+  // $/slangd/* requests
+  auto RegisterExtensionHandlers() -> void override;
+
  protected:
   // Initialize Request
   auto OnInitialize(lsp::InitializeParams params) -> asio::awaitable<
@@ -82,6 +91,15 @@ class SlangdLspServer : public lsp::LspServer {
   auto OnGotoDefinition(lsp::DefinitionParams params) -> asio::awaitable<
       std::expected<lsp::DefinitionResult, lsp::LspError>> override;
 
+  // Find References Request
+  auto OnReferences(lsp::ReferenceParams params) -> asio::awaitable<
+      std::expected<lsp::ReferenceResult, lsp::LspError>> override;
+
+  // Workspace Symbols Request
+  auto OnWorkspaceSymbols(lsp::WorkspaceSymbolParams params)
+      -> asio::awaitable<
+          std::expected<lsp::WorkspaceSymbolResult, lsp::LspError>> override;
+
   // DidChangeWatchedFiles Notification
   auto OnDidChangeWatchedFiles(lsp::DidChangeWatchedFilesParams params)
       -> asio::awaitable<std::expected<void, lsp::LspError>> override;
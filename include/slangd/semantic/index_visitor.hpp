@@ -101,16 +101,13 @@ class IndexVisitor
   void AddEntry(SemanticEntry entry);
   void AddDefinition(
       const slang::ast::Symbol& symbol, std::string_view name,
-      lsp::Location def_loc, const slang::ast::Scope* parent_scope,
-      const slang::ast::Scope* children_scope = nullptr);
+      lsp::Location def_loc);
   void AddReference(
       const slang::ast::Symbol& symbol, std::string_view name,
-      slang::SourceRange ref_range, lsp::Location def_loc,
-      const slang::ast::Scope* parent_scope);
+      slang::SourceRange ref_range, lsp::Location def_loc);
   void AddReferenceWithLspDefinition(
       const slang::ast::Symbol& symbol, std::string_view name,
-      lsp::Range ref_range, lsp::Location def_loc,
-      const slang::ast::Scope* parent_scope);
+      lsp::Range ref_range, lsp::Location def_loc);
   void TraverseType(const slang::ast::Type& type);
   void IndexClassSpecialization(
       const slang::ast::ClassType& class_type,
@@ -3,6 +3,7 @@
 #include <expected>
 #include <memory>
 #include <optional>
+#include <stop_token>
 #include <utility>
 #include <vector>
 
@@ -13,8 +14,11 @@
 #include <slang/ast/Symbol.h>
 #include <slang/text/SourceLocation.h>
 #include <slang/text/SourceManager.h>
+#include <slang/util/Hash.h>
 #include <spdlog/spdlog.h>
 
+#include "slangd/utils/string_interner.hpp"
+
 namespace slangd::services {
 class PreambleManager;
 }
@@ -30,20 +34,20 @@ class IndexVisitor;
 //
 // INVARIANT: All entries in a SemanticIndex have source locations in the same
 // file (the file being indexed). Symbols from included files are filtered out.
+//
+// Strings (definition URI, name) are interned in the owning SemanticIndex:
+// thousands of entries share a handful of URIs and names, so entries hold
+// 32-bit IDs instead of their own std::string copies.
 struct SemanticEntry {
   // LSP coordinates (reference location always in current_file_uri)
   lsp::Range ref_range;
-  lsp::Location def_loc;  // Definition location (range + URI)
+  lsp::Range def_range;  // Definition range in the file def_uri
 
-  // Symbol information
-  const slang::ast::Symbol* symbol;
-  lsp::SymbolKind lsp_kind;
-  std::string name;
+  // Interned strings (see SemanticIndex::GetString)
+  utils::StringInterner::Id def_uri;
+  utils::StringInterner::Id name;
 
-  // Hierarchy for DocumentSymbol tree
-  const slang::ast::Scope* parent;
-  const slang::ast::Scope* children_scope;  // For non-Scope symbols like
-                                            // GenericClassDef
+  lsp::SymbolKind lsp_kind;
 
   // Reference tracking
   bool is_definition;
@@ -57,12 +61,16 @@ namespace slangd::semantic {
 // system that processes ALL symbol types for complete LSP coverage
 class SemanticIndex {
  public:
+  // `stop_token` is polled between definitions and between top-level members
+  // while indexing; once stop is requested the build returns an error.
+  // Slang's forceElaborate of one definition body is not interruptible.
   static auto FromCompilation(
       slang::ast::Compilation& compilation,
       const slang::SourceManager& source_manager,
       const std::string& current_file_uri, slang::BufferID current_file_buffer,
       const services::PreambleManager* preamble_manager = nullptr,
-      std::shared_ptr<spdlog::logger> logger = spdlog::default_logger())
+      std::shared_ptr<spdlog::logger> logger = spdlog::default_logger(),
+      std::stop_token stop_token = {})
       -> std::expected<std::unique_ptr<SemanticIndex>, std::string>;
 
   // Query methods
@@ -74,12 +82,29 @@ class SemanticIndex {
     return source_manager_.get();
   }
 
-  // Unified semantic entries access
+  // Unified semantic entries access (sorted by ref_range.start)
   [[nodiscard]] auto GetSemanticEntries() const
       -> const std::vector<SemanticEntry>& {
     return semantic_entries_;
   }
 
+  // Resolve an interned string ID of an entry
+  [[nodiscard]] auto GetString(utils::StringInterner::Id id) const
+      -> std::string_view {
+    return strings_.Get(id);
+  }
+
+  [[nodiscard]] auto GetName(const SemanticEntry& entry) const
+      -> std::string_view {
+    return strings_.Get(entry.name);
+  }
+
+  [[nodiscard]] auto GetDefinitionLocation(const SemanticEntry& entry) const
+      -> lsp::Location;
+
+  // Approximate heap bytes held by the index
+  [[nodiscard]] auto MemoryUsage() const -> size_t;
+
   // Find definition using LSP coordinates (no SourceManager needed)
   [[nodiscard]] auto LookupDefinitionAt(
       const std::string& uri, lsp::Position position) const
@@ -99,33 +124,61 @@ class SemanticIndex {
  private:
   explicit SemanticIndex(
       const slang::SourceManager& source_manager, std::string current_file_uri,
+      slang::BufferID current_file_buffer,
       std::shared_ptr<spdlog::logger> logger)
       : source_manager_(source_manager),
         current_file_uri_(std::move(current_file_uri)),
+        current_file_buffer_(current_file_buffer),
         logger_(logger ? logger : spdlog::default_logger()) {
   }
 
-  // Returns false for preamble symbols (separate compilation)
-  static auto IsInCurrentFile(
-      const slang::ast::Symbol& symbol, const std::string& current_file_uri,
-      const slang::SourceManager& source_manager,
-      const services::PreambleManager* preamble_manager) -> bool;
-
-  static auto IsInCurrentFile(
-      slang::SourceLocation loc, const std::string& current_file_uri,
-      const slang::SourceManager& source_manager) -> bool;
+  // File membership by BufferID. The current file's buffer is known up
+  // front; any other buffer (macro expansions, includes) is resolved by
+  // file name once and memoized, so each check is a hash lookup instead of
+  // building and normalizing a URI.
+  class CurrentFileFilter {
+   public:
+    CurrentFileFilter(
+        const slang::SourceManager& source_manager,
+        const std::string& current_file_uri,
+        slang::BufferID current_file_buffer,
+        const services::PreambleManager* preamble_manager = nullptr);
+
+    // Returns false for preamble symbols (separate compilation)
+    auto Contains(const slang::ast::Symbol& symbol) -> bool;
+
+    auto Contains(slang::SourceLocation loc) -> bool;
+
+   private:
+    std::reference_wrapper<const slang::SourceManager> source_manager_;
+    std::string normalized_uri_;
+    const slang::ast::Compilation* preamble_compilation_ = nullptr;
+    slang::flat_hash_map<uint32_t, bool> buffers_;
+  };
+
+  // Sort entries and build the lookup array once indexing is done
+  auto Finalize() -> void;
 
   // Unified storage for definitions and references
   std::vector<SemanticEntry> semantic_entries_;
 
+  // ref_range.start of each entry, parallel to semantic_entries_. Kept
+  // separate so the LookupDefinitionAt binary search touches 8 bytes per
+  // probe instead of a whole entry.
+  std::vector<lsp::Position> ref_starts_;
+
+  // Definition URIs and names referenced by entries
+  utils::StringInterner strings_;
+
   std::reference_wrapper<const slang::SourceManager> source_manager_;
 
   // All entries must have source locations in this file
   std::string current_file_uri_;
+  slang::BufferID current_file_buffer_;
 
   std::shared_ptr<spdlog::logger> logger_;
 
-  // IndexVisitor needs access to semantic_entries_ and logger_
+  // IndexVisitor needs access to semantic_entries_, strings_ and logger_
   friend class IndexVisitor;
 };
 
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstddef>
+#include <expected>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <asio.hpp>
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+
+#include "lsp/basic.hpp"
+#include "slangd/utils/canonical_path.hpp"
+#include "slangd/utils/priority_scheduler.hpp"
+
+namespace slangd::services {
+
+struct FileCheckResult {
+  CanonicalPath path;
+  std::vector<lsp::Diagnostic> diagnostics;
+  // False if the file could not be read or its session failed to build
+  bool checked = false;
+};
+
+struct BatchCheckSummary {
+  size_t files = 0;
+  size_t unchecked = 0;
+  size_t errors = 0;
+  size_t warnings = 0;
+};
+
+// BatchChecker: Diagnostics of every project source file without an editor
+// (`slangd --check`).
+//
+// The preamble is built once, then one worker per scheduler thread pulls
+// files and checks each in a transient overlay session (see
+// SessionManager::SweepFiles), so files are elaborated in parallel against
+// the shared preamble. A file gets the same diagnostics
+// the editor would publish after opening it unchanged.
+class BatchChecker {
+ public:
+  BatchChecker(
+      asio::any_io_executor executor, CanonicalPath workspace_root,
+      size_t thread_count, std::shared_ptr<spdlog::logger> logger = nullptr);
+
+  // Loads the workspace config and checks all source files. `on_result`
+  // runs on the executor as files finish (completion order). Call once:
+  // the scheduler is joined when the run ends.
+  auto Run(std::function<void(const FileCheckResult&)> on_result)
+      -> asio::awaitable<BatchCheckSummary>;
+
+ private:
+  asio::any_io_executor executor_;
+  CanonicalPath workspace_root_;
+  std::shared_ptr<utils::PriorityScheduler> scheduler_;
+  std::shared_ptr<spdlog::logger> logger_;
+};
+
+// {"uri":"file:///...","checked":true,"diagnostics":[<LSP Diagnostic>,...]}
+auto ToJson(const FileCheckResult& result) -> nlohmann::json;
+
+// SARIF 2.1.0 log with one run and one result per diagnostic
+auto ToSarif(const std::vector<FileCheckResult>& results) -> nlohmann::json;
+
+}  // namespace slangd::services
@@ -4,16 +4,21 @@
 #include <optional>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include <asio.hpp>
+#include <lsp/document_sync.hpp>
 
 #include "slangd/core/document_state.hpp"
 #include "slangd/services/open_document_tracker.hpp"
+#include "slangd/utils/text_buffer.hpp"
 
 namespace slangd::services {
 
 // Thread-safe document state manager for language service layer
-// Manages document content and version tracking with strand synchronization
+// Manages document content and version tracking with strand synchronization.
+// Content is kept in a chunked TextBuffer so incremental edits don't copy the
+// whole document; Get() materializes a contiguous copy.
 class DocumentStateManager {
  public:
   explicit DocumentStateManager(
@@ -24,6 +29,12 @@ class DocumentStateManager {
   auto Update(std::string uri, std::string content, int version)
       -> asio::awaitable<void>;
 
+  // Apply didChange content changes in order. Returns false if the document
+  // isn't open (changes are dropped).
+  auto ApplyChanges(
+      std::string uri, std::vector<lsp::TextDocumentContentChangeEvent> changes,
+      int version) -> asio::awaitable<bool>;
+
   // Get document state if it exists
   auto Get(std::string uri) -> asio::awaitable<std::optional<DocumentState>>;
 
@@ -37,8 +48,13 @@ class DocumentStateManager {
   auto GetAllUris() -> asio::awaitable<std::vector<std::string>>;
 
  private:
+  struct Document {
+    utils::TextBuffer text;
+    int version;
+  };
+
   // Document storage
-  std::unordered_map<std::string, DocumentState> documents_;
+  std::unordered_map<std::string, Document> documents_;
 
   // Strand for thread-safe access
   asio::strand<asio::any_io_executor> strand_;
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "lsp/basic.hpp"
+#include "slangd/syntax/index_collector.hpp"
+#include "slangd/utils/mapped_file.hpp"
+
+namespace slangd::services {
+
+// FileIndex: Immutable index shard of one source file.
+//
+// The in-memory form is the on-disk form: a header followed by fixed-size
+// record arrays and a string blob. A shard built from syntax owns its bytes;
+// a shard loaded from the cache directory (or an IndexArtifact) is an mmap
+// of the file and needs no parsing or allocation beyond this object.
+//
+// Layout (native endianness, 4-byte aligned records):
+//   Header
+//   NameRef[name_count]              sorted by name text
+//   SymbolRecord[symbol_count]       in source order
+//   OccurrenceRecord[occurrence_count] sorted by (name, position)
+//   char strings[string_bytes]       source path, then names
+class FileIndex {
+ public:
+  static constexpr uint32_t kMagic = 0x58494C53;  // "SLIX"
+  static constexpr uint32_t kVersion = 2;
+  static constexpr uint32_t kNoName = UINT32_MAX;
+
+  struct Header {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t content_hash;
+    // Preamble options (include dirs, defines) the syntax was parsed with
+    uint64_t options_key;
+    uint32_t path_length;
+    uint32_t name_count;
+    uint32_t symbol_count;
+    uint32_t occurrence_count;
+    uint32_t string_bytes;
+    uint32_t reserved;
+  };
+
+  struct NameRef {
+    uint32_t offset;
+    uint32_t length;
+  };
+
+  struct SymbolRecord {
+    uint32_t name;
+    uint32_t container;  // kNoName at file scope
+    uint32_t kind;       // lsp::SymbolKind
+    int32_t line;
+    int32_t start_character;
+    int32_t end_character;
+  };
+
+  struct OccurrenceRecord {
+    uint32_t name;
+    uint32_t is_definition;
+    int32_t line;
+    int32_t start_character;
+    int32_t end_character;
+  };
+
+  // Serialize collected entries of the file at `path`
+  static auto Build(
+      std::string_view path, uint64_t content_hash, uint64_t options_key,
+      const syntax::IndexedFile& file) -> std::shared_ptr<const FileIndex>;
+
+  // Map a shard written by Save(). nullptr if it is missing, corrupt, from
+  // another format version, or was built for other content or options.
+  static auto Load(
+      const std::filesystem::path& shard_path, std::string_view path,
+      uint64_t content_hash, uint64_t options_key)
+      -> std::shared_ptr<const FileIndex>;
+
+  // View a shard image inside a larger mapping (see IndexArtifact); `owner`
+  // keeps that mapping alive. nullptr if the image is invalid.
+  static auto FromBytes(
+      std::shared_ptr<const void> owner, std::span<const std::byte> bytes)
+      -> std::shared_ptr<const FileIndex>;
+
+  // Write atomically (temp file + rename)
+  [[nodiscard]] auto Save(const std::filesystem::path& shard_path) const
+      -> bool;
+
+  // The serialized shard, as written by Save()
+  [[nodiscard]] auto GetBytes() const -> std::span<const std::byte> {
+    return bytes_;
+  }
+
+  [[nodiscard]] auto GetPath() const -> std::string_view;
+  [[nodiscard]] auto GetContentHash() const -> uint64_t {
+    return header_->content_hash;
+  }
+  [[nodiscard]] auto GetOptionsKey() const -> uint64_t {
+    return header_->options_key;
+  }
+
+  // Built from this content with these options
+  [[nodiscard]] auto Matches(uint64_t content_hash, uint64_t options_key) const
+      -> bool {
+    return header_->content_hash == content_hash &&
+           header_->options_key == options_key;
+  }
+
+  [[nodiscard]] auto GetName(uint32_t id) const -> std::string_view;
+  [[nodiscard]] auto GetSymbols() const -> std::span<const SymbolRecord> {
+    return symbols_;
+  }
+
+  // All occurrences of `name`, in source order
+  [[nodiscard]] auto FindOccurrences(std::string_view name) const
+      -> std::span<const OccurrenceRecord>;
+
+  template <typename Record>
+  static auto ToRange(const Record& record) -> lsp::Range {
+    return lsp::Range{
+        .start = {.line = record.line, .character = record.start_character},
+        .end = {.line = record.line, .character = record.end_character}};
+  }
+
+  // Heap bytes held (zero for mapped shards, which live in the page cache)
+  [[nodiscard]] auto MemoryUsage() const -> size_t {
+    return owned_.capacity();
+  }
+  [[nodiscard]] auto IsMapped() const -> bool {
+    return owned_.empty();
+  }
+
+ private:
+  FileIndex() = default;
+
+  // Point the record views into `bytes`; false if the layout is invalid
+  auto Attach(std::span<const std::byte> bytes) -> bool;
+
+  std::vector<std::byte> owned_;
+  utils::MappedFile mapped_;
+  std::shared_ptr<const void> owner_;
+
+  std::span<const std::byte> bytes_;
+  const Header* header_ = nullptr;
+  std::span<const NameRef> names_;
+  std::span<const SymbolRecord> symbols_;
+  std::span<const OccurrenceRecord> occurrences_;
+  std::string_view strings_;
+};
+
+}  // namespace slangd::services
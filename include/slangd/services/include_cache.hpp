@@ -0,0 +1,110 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <slang/text/SourceLocation.h>
+#include <spdlog/spdlog.h>
+
+#include "slangd/utils/canonical_path.hpp"
+
+// Forward declarations
+namespace slang {
+class SourceManager;
+}  // namespace slang
+
+namespace slangd::services {
+
+// IncludeCache: Process-wide cache of include file contents for overlays.
+//
+// Every overlay build parses into a fresh SourceManager, so without this
+// each `include of the edited file is read from disk again per keystroke.
+// After a build, Record() keeps the contents of the files it included
+// (shared by content hash) and which ones `uri` used. The next build of
+// `uri` calls Seed() first: the contents are assigned to the new
+// SourceManager under their resolved paths, where the preprocessor finds
+// them without opening the files.
+//
+// Only file contents are shared. Slang's tokens point into buffers owned by
+// one SourceManager, so includes are still lexed per build.
+//
+// Seed() checks each entry against the file's current mtime and size, so
+// includes outside the workspace (which the file watcher does not cover)
+// are read again once they change. Watcher events (Invalidate) drop entries
+// early and keep a build that raced a change from caching it.
+//
+// Thread safety: all methods may be called from parallel overlay builds.
+class IncludeCache {
+ public:
+  struct Stats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    size_t entries = 0;
+    size_t bytes = 0;
+  };
+
+  // Default limit for cached include bytes
+  static constexpr size_t kDefaultMaxBytes = size_t{256} * 1024 * 1024;
+
+  explicit IncludeCache(
+      std::shared_ptr<spdlog::logger> logger = nullptr,
+      size_t max_bytes = kDefaultMaxBytes);
+
+  // Assign the cached includes of `uri`'s last build to `source_manager`
+  // (before anything is parsed into it), dropping those whose file changed
+  // on disk since. Returns the generation to pass to Record() for this
+  // build.
+  auto Seed(const std::string& uri, slang::SourceManager& source_manager)
+      -> uint64_t;
+
+  // Remember the files included while parsing `uri` into `source_manager`.
+  // New contents are only kept if nothing was invalidated since Seed(), as
+  // the build may have read a file before its change event.
+  auto Record(
+      const std::string& uri, const slang::SourceManager& source_manager,
+      uint64_t generation) -> void;
+
+  // File watcher notification: the next build reads `path` from disk again
+  auto Invalidate(const CanonicalPath& path) -> void;
+
+  // `uri` was closed: forget its includes, and the contents no other
+  // overlay includes
+  auto Forget(const std::string& uri) -> void;
+
+  auto Clear() -> void;
+
+  [[nodiscard]] auto GetStats() const -> Stats;
+
+ private:
+  struct Entry {
+    uint64_t content_hash = 0;
+    std::shared_ptr<const std::string> text;
+    // The file when `text` was recorded
+    std::filesystem::file_time_type mtime;
+    uintmax_t size = 0;
+  };
+
+  auto EraseLocked(
+      std::unordered_map<std::string, Entry>::iterator it) -> void;
+
+  mutable std::mutex mutex_;
+  // Resolved include path -> contents
+  std::unordered_map<std::string, Entry> entries_;
+  // Content hash -> contents, so identical files share one copy
+  std::unordered_map<uint64_t, std::weak_ptr<const std::string>> blobs_;
+  // Overlay URI -> include paths of its last build
+  std::unordered_map<std::string, std::vector<std::string>> includes_;
+  // Bumped by Invalidate()
+  uint64_t generation_ = 0;
+  size_t max_bytes_;
+  Stats stats_;
+
+  std::shared_ptr<spdlog::logger> logger_;
+};
+
+}  // namespace slangd::services
@@ -0,0 +1,170 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <slang/util/Hash.h>
+
+#include "slangd/services/file_index.hpp"
+#include "slangd/services/reference_index.hpp"
+#include "slangd/utils/canonical_path.hpp"
+#include "slangd/utils/mapped_file.hpp"
+
+namespace slangd::services {
+
+class WorkspaceIndex;
+
+// IndexArtifact: Every FileIndex shard of a workspace, and the references
+// each file binds (the background reference sweep), in one file. Built
+// offline (`slangd index --out <file>`, e.g. once per commit in CI) and
+// loaded by the server instead of collecting shards and compiling every
+// file for references itself.
+//
+// Paths are stored relative to the workspace root, and so are definition
+// URIs inside it, so the artifact can be used from another checkout. A
+// shard or reference list is only used for a file whose content hash (and,
+// for shards, preamble options) match; other files are indexed locally
+// (see WorkspaceIndex::Build and LanguageService::ScheduleReferenceSweep).
+//
+// Layout (native endianness, sections 8-byte aligned):
+//   Header
+//   Entry[file_count]        sorted by path
+//   char paths[path_bytes]   workspace-relative paths
+//   per file: shard image as written by FileIndex::Save(), then its
+//   references (ReferencesHeader, ReferenceRecord[], DefUriRef[], strings)
+// `checksum` is XXH64 of everything after the header. A file with another
+// magic, version or checksum is rejected as a whole.
+class IndexArtifact {
+ public:
+  static constexpr uint32_t kMagic = 0x41494C53;  // "SLIA"
+  static constexpr uint32_t kVersion = 3;
+
+  struct Header {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t checksum;
+    uint32_t file_count;
+    uint32_t path_bytes;
+    uint64_t total_bytes;
+    // PreambleManager::GetHeaderFingerprint() of the swept preamble
+    uint64_t header_fingerprint;
+  };
+
+  struct Entry {
+    uint32_t path_offset;
+    uint32_t path_length;
+    uint64_t content_hash;
+    uint64_t shard_offset;
+    uint64_t shard_size;
+    // Zero size if the file could not be compiled
+    uint64_t references_offset;
+    uint64_t references_size;
+  };
+
+  struct ReferencesHeader {
+    uint32_t def_uri_count;
+    uint32_t reference_count;
+    uint32_t string_bytes;
+    uint32_t reserved;
+  };
+
+  struct ReferenceRecord {
+    uint32_t def_uri;
+    uint32_t is_declaration;
+    int32_t def_start_line;
+    int32_t def_start_character;
+    int32_t def_end_line;
+    int32_t def_end_character;
+    int32_t start_line;
+    int32_t start_character;
+    int32_t end_line;
+    int32_t end_character;
+  };
+
+  struct DefUriRef {
+    uint32_t offset;
+    uint32_t length;
+    // Stored relative to the workspace root URI
+    uint32_t relative;
+    uint32_t reserved;
+  };
+
+  // Swept references by file URI
+  using References =
+      slang::flat_hash_map<std::string, ReferenceIndex::FileReferences>;
+
+  // SLANGD_INDEX_ARTIFACT if set, otherwise
+  // <workspace>/.cache/slangd/index.slia
+  static auto DefaultPath(const CanonicalPath& workspace_root)
+      -> std::filesystem::path;
+
+  // Write the shards of `index` and their `references`, swept under a
+  // preamble with `header_fingerprint`, atomically (temp file + rename).
+  // Returns the number of files written.
+  static auto Write(
+      const WorkspaceIndex& index, const References& references,
+      uint64_t header_fingerprint, const CanonicalPath& workspace_root,
+      const std::filesystem::path& path) -> std::expected<size_t, std::string>;
+
+  // Map and verify an artifact, resolving its paths against
+  // `workspace_root`
+  static auto Open(
+      const std::filesystem::path& path, const CanonicalPath& workspace_root)
+      -> std::expected<std::shared_ptr<const IndexArtifact>, std::string>;
+
+  // Shard of the file at `path` if it was built from content with this
+  // hash under these preamble options, else nullptr
+  [[nodiscard]] auto Find(
+      std::string_view path, uint64_t content_hash, uint64_t options_key) const
+      -> std::shared_ptr<const FileIndex>;
+
+  // References swept from the file at `path` if it had content with this
+  // hash under these preamble options, with definition URIs resolved
+  // against the local workspace
+  [[nodiscard]] auto FindReferences(
+      std::string_view path, uint64_t content_hash, uint64_t options_key) const
+      -> std::optional<ReferenceIndex::FileReferences>;
+
+  // Every shard stored with references (so swept by `slangd index`), by
+  // absolute local path
+  auto ForEachSweptShard(
+      const std::function<void(
+          std::string_view path, std::shared_ptr<const FileIndex> shard)>&
+          callback) const -> void;
+
+  [[nodiscard]] auto FileCount() const -> size_t {
+    return files_.size();
+  }
+
+  [[nodiscard]] auto GetHeaderFingerprint() const -> uint64_t {
+    return header_fingerprint_;
+  }
+
+ private:
+  IndexArtifact() = default;
+
+  // Entry of the file at `path` if its content hash matches, else nullptr
+  [[nodiscard]] auto FindEntry(
+      std::string_view path, uint64_t content_hash) const -> const Entry*;
+  [[nodiscard]] auto ShardOf(const Entry& entry) const
+      -> std::shared_ptr<const FileIndex>;
+
+  // Shared with the shards handed out by Find()
+  std::shared_ptr<const utils::MappedFile> mapped_;
+  // Absolute local path of each entry, sorted by path
+  std::vector<std::pair<std::string, const Entry*>> files_;
+  uint64_t header_fingerprint_ = 0;
+  // Prefix of workspace-relative definition URIs
+  std::string root_uri_prefix_;
+};
+
+}  // namespace slangd::services
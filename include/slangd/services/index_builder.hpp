@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+#include <expected>
+#include <filesystem>
+#include <memory>
+#include <string>
+
+#include <asio.hpp>
+#include <spdlog/spdlog.h>
+
+#include "slangd/utils/canonical_path.hpp"
+#include "slangd/utils/priority_scheduler.hpp"
+
+namespace slangd::services {
+
+struct IndexBuildSummary {
+  // Files in the artifact
+  size_t files = 0;
+  // Files stored with swept references
+  size_t swept = 0;
+  size_t bytes = 0;
+};
+
+// IndexBuilder: An IndexArtifact of a workspace without an editor
+// (`slangd index`).
+//
+// Builds the preamble, collects every file's shard (WorkspaceIndex::Build
+// with no previous snapshot or cache), then runs the server's reference
+// sweep over every file (SessionManager::SweepFiles) with all scheduler
+// threads. The sweep is the expensive part of a cold start, and what the
+// artifact saves its users (see LanguageService::LoadIndexArtifact).
+class IndexBuilder {
+ public:
+  IndexBuilder(
+      asio::any_io_executor executor, CanonicalPath workspace_root,
+      size_t thread_count, std::shared_ptr<spdlog::logger> logger = nullptr);
+
+  // Loads the workspace config, indexes all files and writes the artifact
+  // to `path`. Call once: the scheduler is joined when the run ends.
+  auto Run(std::filesystem::path path)
+      -> asio::awaitable<std::expected<IndexBuildSummary, std::string>>;
+
+ private:
+  asio::any_io_executor executor_;
+  CanonicalPath workspace_root_;
+  std::shared_ptr<utils::PriorityScheduler> scheduler_;
+  std::shared_ptr<spdlog::logger> logger_;
+};
+
+}  // namespace slangd::services
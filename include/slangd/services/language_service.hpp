@@ -11,11 +11,16 @@
 #include "slangd/core/language_service_base.hpp"
 #include "slangd/core/project_layout_service.hpp"
 #include "slangd/services/document_state_manager.hpp"
+#include "slangd/services/include_cache.hpp"
 #include "slangd/services/open_document_tracker.hpp"
 #include "slangd/services/overlay_session.hpp"
+#include "slangd/services/preamble_cache.hpp"
 #include "slangd/services/preamble_manager.hpp"
+#include "slangd/services/reference_index.hpp"
 #include "slangd/services/session_manager.hpp"
+#include "slangd/services/workspace_index.hpp"
 #include "slangd/utils/broadcast_event.hpp"
+#include "slangd/utils/priority_scheduler.hpp"
 
 namespace slangd::services {
 
@@ -29,6 +34,9 @@ class LanguageService : public LanguageServiceBase {
       asio::any_io_executor executor,
       std::shared_ptr<spdlog::logger> logger = nullptr);
 
+  // Joins the scheduler it owns before the services posting to it go away
+  ~LanguageService() override;
+
   // LanguageServiceBase implementation
   auto InitializeWorkspace(std::string workspace_uri)
       -> asio::awaitable<void> override;
@@ -44,19 +52,31 @@ class LanguageService : public LanguageServiceBase {
   auto GetDocumentSymbols(std::string uri) -> asio::awaitable<std::expected<
       std::vector<lsp::DocumentSymbol>, lsp::error::LspError>> override;
 
+  auto GetReferences(
+      std::string uri, lsp::Position position, bool include_declaration)
+      -> asio::awaitable<std::expected<
+          std::vector<lsp::Location>, lsp::error::LspError>> override;
+
+  auto GetWorkspaceSymbols(std::string query)
+      -> asio::awaitable<std::expected<
+          std::vector<lsp::WorkspaceSymbol>, lsp::error::LspError>> override;
+
   auto HandleConfigChange() -> asio::awaitable<void> override;
 
   auto HandleSourceFileChange(std::string uri, lsp::FileChangeType change_type)
       -> asio::awaitable<void> override;
 
   // Document lifecycle events
-  auto OnDocumentOpened(std::string uri, std::string content, int version)
+  auto OnDocumentOpened(
+      std::string uri, std::string content, int version, uint64_t request_id)
       -> asio::awaitable<void> override;
 
-  auto OnDocumentChanged(std::string uri, std::string content, int version)
-      -> asio::awaitable<void> override;
+  auto OnDocumentChanged(
+      std::string uri, std::vector<lsp::TextDocumentContentChangeEvent> changes,
+      int version, uint64_t request_id) -> asio::awaitable<void> override;
 
-  auto OnDocumentSaved(std::string uri) -> asio::awaitable<void> override;
+  auto OnDocumentSaved(std::string uri, uint64_t request_id)
+      -> asio::awaitable<void> override;
 
   auto OnDocumentClosed(std::string uri) -> void override;
 
@@ -77,17 +97,68 @@ class LanguageService : public LanguageServiceBase {
   auto CreateDiagnosticHook(std::string uri, int version)
       -> std::function<void(const CompilationState&)>;
 
+  // Session hook feeding the document's references into the overlay layer
+  // of reference_index_
+  auto CreateReferenceHook(std::string uri)
+      -> std::function<void(const OverlaySession&)>;
+
   // Workspace rebuild helpers (preamble + overlays on file change)
   auto RebuildWorkspace() -> asio::awaitable<void>;
   auto ScheduleWorkspaceRebuild() -> void;
 
-  // Session rebuild helpers (per-document on typing)
-  auto RebuildSessionWithDiagnostics(std::string uri) -> asio::awaitable<void>;
-  auto ScheduleSessionRebuild(std::string uri) -> void;
+  // Map the offline-built index artifact of the workspace, if there is one
+  auto LoadIndexArtifact() -> asio::awaitable<void>;
+
+  // Rebuild workspace_index_ from the current preamble in the background,
+  // then sweep references against it
+  auto ScheduleWorkspaceIndexBuild() -> void;
+
+  // Re-index references (saved content) into the background layer of
+  // reference_index_, for the files of `index` affected since the last
+  // completed sweep (all files on the first sweep or after a header
+  // change). `header_fingerprint` is that of the preamble `index` was built
+  // from. Restarts on every call.
+  auto ScheduleReferenceSweep(
+      std::shared_ptr<const WorkspaceIndex> index, uint64_t header_fingerprint)
+      -> void;
+
+  // Before the first sweep: take the artifact's references for the files of
+  // `index` it was built from, and make its files the sweep base, so only
+  // files affected since then are swept
+  auto ImportArtifactReferences(std::shared_ptr<const WorkspaceIndex> index)
+      -> asio::awaitable<void>;
+
+  // Session rebuild helpers (per-document on typing). `request_id` is the
+  // didChange message the rebuild is for.
+  auto RebuildSessionWithDiagnostics(std::string uri, uint64_t request_id)
+      -> asio::awaitable<void>;
+  auto ScheduleSessionRebuild(std::string uri, uint64_t request_id) -> void;
 
   // Core dependencies
   std::shared_ptr<ProjectLayoutService> layout_service_;
   std::shared_ptr<const PreambleManager> preamble_manager_;
+  // Syntax trees reused across preamble rebuilds
+  std::shared_ptr<PreambleCache> preamble_cache_;
+  // Include contents reused across overlay rebuilds
+  std::shared_ptr<IncludeCache> include_cache_;
+  // Cross-file symbol index of the preamble files (nullptr until the first
+  // background build finishes). Only the latest scheduled build is kept.
+  std::shared_ptr<const WorkspaceIndex> workspace_index_;
+  uint64_t workspace_index_generation_ = 0;
+  // Shards and references built by `slangd index` (nullptr if absent or
+  // invalid); files whose content differs are indexed locally
+  std::shared_ptr<const IndexArtifact> index_artifact_;
+  // Result cap for workspace/symbol (clients filter further as you type)
+  static constexpr size_t kMaxWorkspaceSymbols = 256;
+  // Symbol -> reference locations (overlay sessions + background sweep)
+  ReferenceIndex reference_index_;
+  uint64_t reference_sweep_generation_ = 0;
+  // Snapshot and header fingerprint the last completed sweep covered
+  std::shared_ptr<const WorkspaceIndex> swept_index_;
+  uint64_t swept_header_fingerprint_ = 0;
+  // Sweep sessions elaborate at speculative priority; a quarter of the
+  // threads leaves the rest for preamble and interactive work
+  static constexpr size_t kSweepThreadDivisor = 4;
   std::shared_ptr<spdlog::logger> logger_;
   asio::any_io_executor executor_;
   CanonicalPath workspace_root_;
@@ -108,13 +179,17 @@ class LanguageService : public LanguageServiceBase {
   // available)
   utils::BroadcastEvent workspace_ready_;
 
-  // Background thread pool for parse diagnostics
-  std::unique_ptr<asio::thread_pool> compilation_pool_;
-
-  // Thread pool size: use half of hardware threads with minimum of 1
-  static auto GetThreadPoolSize() -> size_t {
-    auto hw_threads = std::thread::hardware_concurrency();
-    return std::max(size_t{1}, static_cast<size_t>(hw_threads) / 2);
+  // Single prioritized worker pool for preamble builds, parse diagnostics
+  // and overlay sessions (shared with session_manager_)
+  std::shared_ptr<utils::PriorityScheduler> scheduler_;
+
+  // Most recently opened/edited document; its builds run as kFocused,
+  // other open documents as kVisible
+  std::string focused_uri_;
+  [[nodiscard]] auto PriorityFor(const std::string& uri) const
+      -> utils::TaskPriority {
+    return uri == focused_uri_ ? utils::TaskPriority::kFocused
+                               : utils::TaskPriority::kVisible;
   }
 
   // Callback for publishing diagnostics (set by LSP server layer)
@@ -135,6 +210,8 @@ class LanguageService : public LanguageServiceBase {
   // Session rebuild debouncing and concurrency protection (per-URI)
   std::map<std::string, asio::steady_timer> session_rebuild_timers_;
   std::map<std::string, RebuildState> session_rebuild_state_;
+  // Change message the kPendingNext rebuild is for
+  std::map<std::string, uint64_t> session_rebuild_next_request_;
   static constexpr auto kSessionDebounceDelay = std::chrono::milliseconds(500);
 };
 
@@ -9,6 +9,7 @@
 
 #include "slangd/core/project_layout_service.hpp"
 #include "slangd/semantic/semantic_index.hpp"
+#include "slangd/services/include_cache.hpp"
 #include "slangd/services/preamble_manager.hpp"
 
 namespace slangd::services {
@@ -29,15 +30,24 @@ class OverlaySession {
       std::shared_ptr<spdlog::logger> logger = spdlog::default_logger())
       -> std::shared_ptr<OverlaySession>;
 
+  // With an include cache, includes of the previous build of `uri` are
+  // taken from it instead of the filesystem
   static auto BuildCompilation(
       std::string uri, std::string content,
       std::shared_ptr<ProjectLayoutService> layout_service,
       std::shared_ptr<const PreambleManager> preamble_manager,
-      std::shared_ptr<spdlog::logger> logger = spdlog::default_logger())
+      std::shared_ptr<spdlog::logger> logger = spdlog::default_logger(),
+      std::shared_ptr<IncludeCache> include_cache = nullptr)
       -> std::tuple<
           std::shared_ptr<slang::SourceManager>,
           std::unique_ptr<slang::ast::Compilation>, slang::BufferID>;
 
+  // True if elaborating this compilation may mutate shared preamble state
+  // (see PreambleManager::RootSymbol::mutable_on_use). Such overlays must
+  // not be elaborated concurrently with each other.
+  static auto RequiresSerialElaboration(
+      const slang::ast::Compilation& compilation) -> bool;
+
   static auto CreateFromParts(
       std::shared_ptr<slang::SourceManager> source_manager,
       std::shared_ptr<slang::ast::Compilation> compilation,
@@ -58,6 +68,11 @@ class OverlaySession {
     return *semantic_index_;
   }
 
+  // Bytes held: the compilation's arena (elaborated AST, as of this call),
+  // source buffers and the semantic index. Syntax trees own separate arenas
+  // and are not counted.
+  [[nodiscard]] auto MemoryUsage() const -> size_t;
+
   [[nodiscard]] auto GetCompilation() const -> slang::ast::Compilation& {
     return *compilation_;
   }
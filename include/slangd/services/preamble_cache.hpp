@@ -0,0 +1,135 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+
+#include "slangd/utils/canonical_path.hpp"
+
+// Forward declarations
+namespace slang {
+class SourceManager;
+namespace syntax {
+class SyntaxTree;
+}
+}  // namespace slang
+
+namespace slangd::services {
+
+// PreambleCache: Content-addressed cache of parsed preamble syntax trees.
+//
+// Entries are keyed by file path + content hash, and the whole cache is keyed
+// by an options fingerprint (defines + include directories). Trees are parsed
+// into a cache-owned SourceManager ("generation") so that they can be re-added
+// to every rebuilt preamble Compilation without reparsing.
+//
+// A Slang SourceManager caches file contents by path and never re-reads them,
+// so a generation is only reused while every path it has loaded is unchanged.
+// Any content change (or a change to an untracked file, e.g. an include)
+// starts a new generation and the next build reparses everything.
+//
+// Unchanged files are detected by path + mtime + size without reading them;
+// everything else is read and hashed.
+//
+// Thread safety: Lookup/Insert may be called from parallel parse tasks.
+class PreambleCache {
+ public:
+  struct Stats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0;
+    uint64_t generations = 0;
+    size_t entries = 0;
+    size_t live_bytes = 0;
+    size_t dead_bytes = 0;
+  };
+
+  // Default limit for source bytes held by one generation (live + dead)
+  static constexpr size_t kDefaultMaxBytes = size_t{512} * 1024 * 1024;
+
+  explicit PreambleCache(
+      std::shared_ptr<spdlog::logger> logger = nullptr,
+      size_t max_bytes = kDefaultMaxBytes);
+
+  // Fingerprint of all options that affect parsing
+  static auto ComputeOptionsKey(
+      const std::vector<CanonicalPath>& include_dirs,
+      const std::vector<std::string>& defines) -> uint64_t;
+
+  // Start a preamble build. Returns the SourceManager that all trees of this
+  // build must be parsed into. Starts a new generation if the options changed
+  // or the current generation was invalidated.
+  auto BeginBuild(uint64_t options_key)
+      -> std::shared_ptr<slang::SourceManager>;
+
+  // Fast path: the tracked content hash if mtime and size still match and the
+  // file wasn't invalidated since. nullopt means the file must be hashed.
+  [[nodiscard]] auto ProbeHash(
+      const CanonicalPath& path, std::filesystem::file_time_type mtime,
+      size_t size) const -> std::optional<uint64_t>;
+
+  // Returns true if the current generation already loaded `path` with
+  // different content. The caller must then restart with a new generation.
+  [[nodiscard]] auto HasConflict(
+      const CanonicalPath& path, uint64_t content_hash) const -> bool;
+
+  // Discard the current generation (used after HasConflict)
+  auto StartNewGeneration() -> std::shared_ptr<slang::SourceManager>;
+
+  // Returns the cached tree for this exact content, or nullptr. A hit
+  // refreshes the tracked mtime (e.g. after a touch without edits).
+  auto Lookup(
+      const CanonicalPath& path, uint64_t content_hash,
+      std::filesystem::file_time_type mtime)
+      -> std::shared_ptr<slang::syntax::SyntaxTree>;
+
+  auto Insert(
+      const CanonicalPath& path, uint64_t content_hash, size_t content_size,
+      std::filesystem::file_time_type mtime,
+      std::shared_ptr<slang::syntax::SyntaxTree> tree) -> void;
+
+  // Finish a build: evict entries not used by it and schedule a new
+  // generation if dead buffers dominate or the byte budget is exceeded
+  auto EndBuild() -> void;
+
+  // File watcher notification. Tracked paths are re-hashed on the next build;
+  // untracked paths (includes) invalidate the generation.
+  auto Invalidate(const CanonicalPath& path) -> void;
+
+  auto Clear() -> void;
+
+  [[nodiscard]] auto GetStats() const -> Stats;
+
+ private:
+  struct Entry {
+    uint64_t content_hash = 0;
+    size_t content_size = 0;
+    std::filesystem::file_time_type mtime;
+    std::shared_ptr<slang::syntax::SyntaxTree> tree;
+    uint64_t last_used_build = 0;
+    // Set by Invalidate(): skip the mtime fast path on the next build
+    bool dirty = false;
+  };
+
+  auto ResetGenerationLocked() -> void;
+
+  mutable std::mutex mutex_;
+  std::unordered_map<std::string, Entry> entries_;
+  std::shared_ptr<slang::SourceManager> source_manager_;
+  uint64_t options_key_ = 0;
+  uint64_t build_counter_ = 0;
+  bool generation_valid_ = false;
+  size_t max_bytes_;
+  Stats stats_;
+
+  std::shared_ptr<spdlog::logger> logger_;
+};
+
+}  // namespace slangd::services
@@ -1,8 +1,11 @@
 #pragma once
 
+#include <cstdint>
 #include <expected>
 #include <memory>
+#include <optional>
 #include <string>
+#include <string_view>
 #include <tuple>
 #include <utility>
 #include <vector>
@@ -14,6 +17,7 @@
 #include <spdlog/spdlog.h>
 
 #include "slangd/core/project_layout_service.hpp"
+#include "slangd/services/preamble_cache.hpp"
 #include "slangd/utils/canonical_path.hpp"
 
 // Forward declarations
@@ -39,14 +43,33 @@ namespace slangd::services {
 // Use CreateFromProjectLayout() factory method for convenience.
 class PreambleManager {
  public:
+  // Root-level package and/or definition that overlay compilations bind by
+  // name. The definition entry is copied out of the preamble's definitionMap
+  // at build time.
+  struct RootSymbol {
+    std::string_view name;
+    const slang::ast::PackageSymbol* package = nullptr;
+    std::optional<std::pair<std::vector<const slang::ast::Symbol*>, bool>>
+        definition;
+    // Other root symbols named in this symbol's syntax
+    std::vector<uint32_t> dependencies;
+    // Using this symbol still mutates preamble state (generic class
+    // specializations in its package, nested classes or compilation unit),
+    // so overlays binding it must elaborate serially
+    bool mutable_on_use = false;
+  };
+
   // Default constructor
   PreambleManager() = default;
 
   // Factory method
+  // With a long-lived cache, unchanged syntax trees from earlier builds are
+  // reused instead of reparsed (see PreambleCache)
   [[nodiscard]] static auto CreateFromProjectLayout(
       std::shared_ptr<ProjectLayoutService> layout_service,
       asio::any_io_executor compilation_executor,
-      std::shared_ptr<spdlog::logger> logger = spdlog::default_logger())
+      std::shared_ptr<spdlog::logger> logger = spdlog::default_logger(),
+      std::shared_ptr<PreambleCache> cache = nullptr)
       -> asio::awaitable<
           std::expected<std::shared_ptr<PreambleManager>, std::string>>;
 
@@ -64,6 +87,29 @@ class PreambleManager {
       std::tuple<std::string_view, const slang::ast::Scope*>,
       std::pair<std::vector<const slang::ast::Symbol*>, bool>>&;
 
+  // Root symbols named in `names`, plus everything their syntax (transitively)
+  // refers to. Overlays bind only these instead of copying the whole maps.
+  [[nodiscard]] auto CollectReachableSymbols(
+      const slang::flat_hash_set<std::string_view>& names) const
+      -> std::vector<const RootSymbol*>;
+
+  // Hash of options + (path, content hash) of every source file and every
+  // header they included. Equal fingerprints mean equivalent preambles, so
+  // a rebuild can be skipped.
+  [[nodiscard]] auto GetContentFingerprint() const -> uint64_t;
+
+  // The headers' part of the content fingerprint
+  [[nodiscard]] auto GetHeaderFingerprint() const -> uint64_t {
+    return header_fingerprint_;
+  }
+
+  // Hash of include directories and defines (see
+  // PreambleCache::ComputeOptionsKey); anything derived from the syntax
+  // trees is only valid under the same key
+  [[nodiscard]] auto GetOptionsKey() const -> uint64_t {
+    return options_key_;
+  }
+
   // Include directories and defines from ProjectLayoutService
   [[nodiscard]] auto GetIncludeDirectories() const
       -> const std::vector<CanonicalPath>&;
@@ -76,13 +122,29 @@ class PreambleManager {
   [[nodiscard]] auto GetCompilation() const -> const slang::ast::Compilation&;
 
  private:
+  // Build root_symbols_ and the name -> symbol dependency edges
+  auto BuildRootSymbols(asio::any_io_executor executor)
+      -> asio::awaitable<void>;
+
+  // Force lazy state of packages, compilation units and definition parent
+  // scopes (types, parameter values, imports) so that overlays can
+  // elaborate against the preamble concurrently, and set mutable_on_use
+  // where that is not enough
+  auto PreElaborate() -> void;
+
   std::vector<CanonicalPath> include_directories_;
   std::vector<std::string> defines_;
+  uint64_t options_key_ = 0;
+  uint64_t content_fingerprint_ = 0;
+  uint64_t header_fingerprint_ = 0;
 
   // Preamble compilation objects
   std::shared_ptr<slang::ast::Compilation> preamble_compilation_;
   std::shared_ptr<slang::SourceManager> source_manager_;
 
+  std::vector<RootSymbol> root_symbols_;
+  slang::flat_hash_map<std::string_view, uint32_t> root_symbol_ids_;
+
   // Logger
   std::shared_ptr<spdlog::logger> logger_;
 };
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <slang/util/Hash.h>
+
+#include "lsp/basic.hpp"
+#include "slangd/utils/string_interner.hpp"
+
+namespace slangd::semantic {
+class SemanticIndex;
+}
+
+namespace slangd::services {
+
+// ReferenceIndex: Reverse index from symbol identity (definition URI +
+// range) to every location that resolves to it.
+//
+// Each file contributes the (reference, definition) pairs of its semantic
+// index in one of two layers:
+// - kBackground: sweep over the preamble files (saved content)
+// - kOverlay: open document sessions (unsaved content)
+// An overlay contribution hides the file's background one until removed.
+//
+// Lookup is one hash probe for the symbol's posting list (files that
+// mention it) plus a binary search per file, independent of the total
+// number of references.
+//
+// Not thread-safe: owned and used on the LanguageService executor.
+class ReferenceIndex {
+ public:
+  enum class Layer : uint8_t { kBackground, kOverlay };
+
+  struct Reference {
+    uint32_t def_uri;  // Index into FileReferences::def_uris
+    lsp::Range def_range;
+    lsp::Range range;
+    bool is_declaration;
+  };
+
+  // One file's contribution, detached from the session it came from
+  struct FileReferences {
+    std::vector<std::string> def_uris;
+    std::vector<Reference> references;
+  };
+
+  // Extract all entries of a session's semantic index
+  static auto Collect(const semantic::SemanticIndex& index) -> FileReferences;
+
+  // Replace the layer's contribution of `uri`
+  auto Update(std::string_view uri, Layer layer, FileReferences references)
+      -> void;
+
+  auto Remove(std::string_view uri, Layer layer) -> void;
+
+  // Drop background contributions of files not in `uris` (left the
+  // workspace since the last sweep)
+  auto RetainBackground(const slang::flat_hash_set<std::string>& uris)
+      -> void;
+
+  // Locations resolving to the definition at `def_uri`/`def_range`
+  [[nodiscard]] auto FindReferences(
+      std::string_view def_uri, const lsp::Range& def_range,
+      bool include_declaration) const -> std::vector<lsp::Location>;
+
+  [[nodiscard]] auto ReferenceCount() const -> size_t;
+
+ private:
+  struct SymbolKey {
+    uint32_t def_uri;  // strings_ ID
+    lsp::Range def_range;
+
+    auto operator==(const SymbolKey& other) const -> bool {
+      return def_uri == other.def_uri &&
+             def_range.start == other.def_range.start &&
+             def_range.end == other.def_range.end;
+    }
+  };
+
+  struct SymbolKeyHash {
+    auto operator()(const SymbolKey& key) const -> size_t;
+  };
+
+  struct StoredReference {
+    SymbolKey key;
+    lsp::Range range;
+    bool is_declaration;
+  };
+
+  struct File {
+    std::string uri;
+    // Sorted by key, so one symbol's references are contiguous
+    std::optional<std::vector<StoredReference>> background;
+    std::optional<std::vector<StoredReference>> overlay;
+
+    [[nodiscard]] auto Active() const
+        -> const std::optional<std::vector<StoredReference>>& {
+      return overlay ? overlay : background;
+    }
+  };
+
+  static auto KeyLess(const SymbolKey& a, const SymbolKey& b) -> bool;
+
+  // Posting maintenance for the keys of both layers of a file
+  auto AddPostings(uint32_t file_id, const File& file) -> void;
+  auto RemovePostings(uint32_t file_id, const File& file) -> void;
+
+  utils::StringInterner strings_;
+  std::vector<File> files_;
+  slang::flat_hash_map<std::string, uint32_t> file_ids_;
+  // Symbol -> files with a contribution (any layer) mentioning it
+  slang::flat_hash_map<SymbolKey, std::vector<uint32_t>, SymbolKeyHash>
+      postings_;
+};
+
+}  // namespace slangd::services
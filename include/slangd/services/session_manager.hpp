@@ -1,7 +1,10 @@
 #pragma once
 
-#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
 #include <memory>
+#include <stop_token>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -9,16 +12,20 @@
 #include <asio/any_io_executor.hpp>
 #include <asio/awaitable.hpp>
 #include <asio/cancellation_signal.hpp>
-#include <asio/thread_pool.hpp>
 #include <slang/ast/Compilation.h>
 #include <slang/text/SourceManager.h>
 #include <spdlog/spdlog.h>
 
 #include "slangd/core/project_layout_service.hpp"
+#include "slangd/services/include_cache.hpp"
 #include "slangd/services/open_document_tracker.hpp"
 #include "slangd/services/overlay_session.hpp"
 #include "slangd/services/preamble_manager.hpp"
 #include "slangd/utils/broadcast_event.hpp"
+#include "slangd/utils/metrics.hpp"
+#include "slangd/utils/position_mapper.hpp"
+#include "slangd/utils/priority_scheduler.hpp"
+#include "slangd/utils/serial_gate.hpp"
 #include "slangd/utils/shared_task.hpp"
 
 namespace slangd::services {
@@ -34,6 +41,15 @@ struct CompilationState {
 using CompilationReadyHook = std::function<void(const CompilationState&)>;
 using SessionReadyHook = std::function<void(const OverlaySession&)>;
 
+// SessionManager::SweepFiles tuning
+struct SweepOptions {
+  // Files in flight at once; 0 for one per scheduler thread
+  size_t max_workers = 0;
+  // Checked on the executor before each file: the sweep stops taking new
+  // files once it returns false
+  std::function<bool()> keep_going;
+};
+
 // Session creation phase tracking
 enum class SessionPhase {
   kElaborationComplete,  // Phase 1: Diagnostics can run
@@ -45,6 +61,9 @@ enum class SessionPhase {
 // - LSP features read sessions (GetSession)
 // - Cache by URI only (not content hash) for stable typing performance
 // - Concurrent requests for same URI share a single pending creation
+// - The previous indexed session keeps serving WithSnapshot until the new
+//   version is indexed (stale-while-revalidate)
+// - Stored sessions are bounded by a memory budget (see EnforceMemoryBudget)
 class SessionManager {
  public:
   explicit SessionManager(
@@ -52,9 +71,15 @@ class SessionManager {
       std::shared_ptr<ProjectLayoutService> layout_service,
       std::shared_ptr<const PreambleManager> preamble_manager,
       std::shared_ptr<OpenDocumentTracker> open_tracker,
-      std::shared_ptr<spdlog::logger> logger);
+      std::shared_ptr<utils::PriorityScheduler> scheduler,
+      std::shared_ptr<IncludeCache> include_cache,
+      std::shared_ptr<spdlog::logger> logger,
+      size_t memory_budget = DefaultMemoryBudget());
 
-  ~SessionManager();
+  // SLANGD_SESSION_MEMORY_MB if set, otherwise kDefaultMemoryBudgetMB
+  static auto DefaultMemoryBudget() -> size_t;
+
+  ~SessionManager() = default;
 
   // Non-copyable, non-movable
   SessionManager(const SessionManager&) = delete;
@@ -65,11 +90,14 @@ class SessionManager {
   // Document event handlers (ONLY these create/invalidate sessions)
   // Optional hooks execute during session creation (before caching) - useful
   // for server-push features like diagnostics that need guaranteed execution
+  // Priority picks the scheduler class the build competes in; the build's
+  // trace span carries `request_id` (the LSP message that caused it)
   auto UpdateSession(
       std::string uri, std::string content, int version,
+      utils::TaskPriority priority,
       std::optional<CompilationReadyHook> on_compilation_ready = std::nullopt,
-      std::optional<SessionReadyHook> on_session_ready = std::nullopt)
-      -> asio::awaitable<void>;
+      std::optional<SessionReadyHook> on_session_ready = std::nullopt,
+      uint64_t request_id = 0) -> asio::awaitable<void>;
 
   auto InvalidateSessions(std::vector<std::string> uris) -> void;
 
@@ -78,6 +106,11 @@ class SessionManager {
   // Prevents old sessions from holding preamble references during rebuild
   auto InvalidateAllSessions() -> asio::awaitable<void>;
 
+  // Stop accepting session updates and wait for this manager's session tasks
+  // (they capture `this`). Call before destroying the manager; the scheduler
+  // is left running for its owner to join.
+  auto Shutdown() -> asio::awaitable<void>;
+
   // Cancel pending session compilation (called when document is closed)
   auto CancelPendingSession(std::string uri) -> void;
 
@@ -92,6 +125,27 @@ class SessionManager {
       std::shared_ptr<const PreambleManager> preamble_manager)
       -> asio::awaitable<void>;
 
+  // Build an uncached session for `uri` (background indexing of files that
+  // may not be open), run `callback` on the scheduler thread, then drop it.
+  // Uses the same preamble and serial elaboration rule as UpdateSession.
+  // Returns false if the session could not be built.
+  auto WithTransientSession(
+      std::string uri, std::string content, utils::TaskPriority priority,
+      std::function<void(const OverlaySession&)> callback)
+      -> asio::awaitable<bool>;
+
+  // Read each file in `uris` from disk and run WithTransientSession on it,
+  // one file per worker at a time. Workers only wait on their own session,
+  // so throughput follows the scheduler's thread count. `on_session(i, s)`
+  // runs on a scheduler thread with the session of uris[i]; `on_file(i,
+  // built)` then runs on the executor, with `built` false if the file could
+  // not be read or its session failed.
+  auto SweepFiles(
+      const std::vector<std::string>& uris, utils::TaskPriority priority,
+      std::function<void(size_t, const OverlaySession&)> on_session,
+      std::function<void(size_t, bool)> on_file, SweepOptions options = {})
+      -> asio::awaitable<void>;
+
   // Callback-based session access - prevents shared_ptr escape
   // Executes callback on session_strand_ with const reference to session
   // Returns std::expected with callback result or error message
@@ -100,6 +154,17 @@ class SessionManager {
       -> asio::awaitable<std::expected<
           std::invoke_result_t<Fn, const OverlaySession&>, std::string>>;
 
+  // Like WithSession, but never waits for a rebuild: while a newer version
+  // is still being built, runs `callback` on the previous indexed session
+  // with a mapper from the current document text to that session's text.
+  // Otherwise the mapper is the identity. For read-only navigation queries.
+  template <typename Fn>
+  auto WithSnapshot(std::string uri, Fn callback)
+      -> asio::awaitable<std::expected<
+          std::invoke_result_t<
+              Fn, const OverlaySession&, const utils::PositionMapper&>,
+          std::string>>;
+
   // Callback-based compilation state access (Phase 1 - diagnostics)
   // Executes callback on session_strand_ with const reference to compilation
   // state Returns std::expected with callback result or error message
@@ -115,33 +180,78 @@ class SessionManager {
     utils::BroadcastEvent compilation_ready;
     // Phase 2: Indexing complete (symbols/definitions can proceed)
     utils::BroadcastEvent session_ready;
-    int version;                         // LSP document version
-    std::atomic<bool> cancelled{false};  // Lock-free cancellation flag
+    int version;  // LSP document version
+    // Lock-free cancellation flag, also polled inside elaboration/indexing
+    std::stop_source cancellation;
 
     // Optional hooks that execute during session creation (before caching)
     // Useful for server-push features like diagnostics that need guaranteed
     // execution
     std::optional<CompilationReadyHook> on_compilation_ready;
     std::optional<SessionReadyHook> on_session_ready;
+    // Message the build was started for, 0 if none (see utils::Tracer)
+    uint64_t request_id = 0;
 
     explicit PendingCreation(asio::any_io_executor executor, int doc_version);
   };
 
   auto StartSessionCreation(
       std::string uri, std::string content, int version,
+      utils::TaskPriority priority,
       std::shared_ptr<const PreambleManager> preamble_manager,
       std::shared_ptr<ProjectLayoutService> layout_service,
       std::optional<CompilationReadyHook> on_compilation_ready,
-      std::optional<SessionReadyHook> on_session_ready)
+      std::optional<SessionReadyHook> on_session_ready, uint64_t request_id)
       -> std::shared_ptr<PendingCreation>;
 
+  // Elaborate and index an overlay compilation at `priority`, holding
+  // serial_gate_ when it requires serial elaboration. Stops early once
+  // `stop_token` is requested.
+  auto BuildSemanticIndex(
+      const std::string& uri, slang::ast::Compilation& compilation,
+      const slang::SourceManager& source_manager,
+      slang::BufferID main_buffer_id, const PreambleManager* preamble_manager,
+      utils::TaskPriority priority, std::stop_token stop_token = {})
+      -> asio::awaitable<std::expected<
+          std::unique_ptr<semantic::SemanticIndex>, std::string>>;
+
   // Session entry with version and phase tracking
   struct SessionEntry {
     std::shared_ptr<OverlaySession> session;
     int version;
     SessionPhase phase;
+    // Eviction inputs (see EnforceMemoryBudget)
+    size_t footprint = 0;
+    std::chrono::milliseconds build_time{0};
+    double retention = 0.0;
+  };
+
+  // Previous Phase 2 session of a document whose new version is building
+  struct StaleSession {
+    std::shared_ptr<OverlaySession> session;
+    int version;
+    // Current document text -> session text
+    utils::PositionMapper mapper;
+    // Counts against the memory budget like a stored session
+    size_t footprint = 0;
   };
 
+  // GreedyDual-Size retention: current inflation plus rebuild time per MB,
+  // refreshed on every access. Cheap-to-rebuild, large and long-unused
+  // sessions have the lowest values.
+  auto Touch(SessionEntry& entry) -> void;
+
+  // Evict until the total footprint of stored and stale sessions fits the
+  // budget: stale sessions first (only a stopgap until their replacement is
+  // indexed), then stored sessions of closed documents, then open ones,
+  // lowest retention first within each group. The stored session of
+  // `keep_uri` is never evicted. Runs on session_strand_.
+  auto EnforceMemoryBudget(const std::string& keep_uri) -> void;
+
+  // Report map sizes and stored bytes as session.* gauges (see
+  // utils::Metrics). Runs on session_strand_ after the maps change.
+  auto PublishGauges() -> void;
+
   // Dependencies
   asio::any_io_executor executor_;
   std::shared_ptr<spdlog::logger> logger_;
@@ -163,20 +273,34 @@ class SessionManager {
 
   // Protected by session_strand_:
   SessionMap sessions_;
+  // At most one per document, dropped once its replacement is indexed,
+  // fails or is cancelled
+  std::unordered_map<std::string, StaleSession> stale_;
   PendingMap pending_;
   TimerMap cleanup_timers_;
   std::vector<std::shared_ptr<utils::SharedTask>> active_session_tasks_;
+  bool shut_down_ = false;
   static constexpr auto kCleanupDelay = std::chrono::seconds(5);
 
-  // Background compilation pool (multi-threaded for preamble parsing
-  // parallelism)
-  std::unique_ptr<asio::thread_pool> compilation_pool_;
-
-  // Strand for serializing overlay elaboration on compilation pool
-  // Overlay elaboration triggers lazy operations on shared preamble symbols
-  // Serialization prevents concurrent preamble access (Slang is
-  // single-threaded)
-  asio::strand<asio::any_io_executor> overlay_strand_;
+  // Stored session memory budget in bytes
+  size_t memory_budget_;
+  // GreedyDual-Size inflation: retention of the last evicted session
+  double retention_inflation_ = 0.0;
+  static constexpr size_t kDefaultMemoryBudgetMB = 1024;
+
+  // Shared compilation scheduler (owned with LanguageService)
+  std::shared_ptr<utils::PriorityScheduler> scheduler_;
+
+  // Include contents reused across rebuilds of open documents
+  std::shared_ptr<IncludeCache> include_cache_;
+
+  // Serializes overlay elaboration that still triggers lazy operations on
+  // shared preamble symbols (OverlaySession::RequiresSerialElaboration).
+  // Preamble scopes are pre-elaborated, so most overlays elaborate in
+  // parallel. Unlike a strand, each holder keeps its own priority, so
+  // speculative sweeps never run at interactive priority or queue ahead of
+  // open documents.
+  utils::SerialGate serial_gate_;
 };
 
 // Template method implementations
@@ -191,6 +315,8 @@ auto SessionManager::WithSession(std::string uri, Fn callback)
   // Fast path: Check storage
   if (auto it = sessions_.find(uri); it != sessions_.end()) {
     if (it->second.phase >= SessionPhase::kIndexingComplete) {
+      utils::Metrics::Instance().GetCounter("session.hits").Add();
+      Touch(it->second);
       // Execute callback synchronously on strand with const reference
       // Session cannot be removed while we hold strand
       auto result = callback(*it->second.session);
@@ -201,6 +327,7 @@ auto SessionManager::WithSession(std::string uri, Fn callback)
   // Slow path: Wait for Phase 2 completion
   if (auto it = pending_.find(uri); it != pending_.end()) {
     logger_->debug("Session wait (indexing): {}", uri);
+    utils::Metrics::Instance().GetCounter("session.misses").Add();
 
     auto pending = it->second;
     // Release strand during wait
@@ -212,6 +339,7 @@ auto SessionManager::WithSession(std::string uri, Fn callback)
     if (auto session_it = sessions_.find(uri);
         session_it != sessions_.end() &&
         session_it->second.phase >= SessionPhase::kIndexingComplete) {
+      Touch(session_it->second);
       auto result = callback(*session_it->second.session);
       co_return result;
     }
@@ -226,9 +354,36 @@ auto SessionManager::WithSession(std::string uri, Fn callback)
   }
 
   logger_->info("Session not found: {}", uri);
+  utils::Metrics::Instance().GetCounter("session.not_found").Add();
   co_return std::unexpected("Session not found");
 }
 
+template <typename Fn>
+auto SessionManager::WithSnapshot(std::string uri, Fn callback)
+    -> asio::awaitable<std::expected<
+        std::invoke_result_t<
+            Fn, const OverlaySession&, const utils::PositionMapper&>,
+        std::string>> {
+  co_await asio::post(session_strand_, asio::use_awaitable);
+
+  // A stale entry exists only while its replacement is not yet indexed
+  if (auto it = stale_.find(uri); it != stale_.end()) {
+    logger_->debug(
+        "Session snapshot: {} (version {}, rebuild pending)", uri,
+        it->second.version);
+    // Answered without waiting, so it counts as a hit
+    auto& metrics = utils::Metrics::Instance();
+    metrics.GetCounter("session.hits").Add();
+    metrics.GetCounter("session.stale_served").Add();
+    co_return callback(*it->second.session, it->second.mapper);
+  }
+
+  co_return co_await WithSession(
+      std::move(uri), [&callback](const OverlaySession& session) {
+        return callback(session, utils::PositionMapper{});
+      });
+}
+
 template <typename Fn>
 auto SessionManager::WithCompilationState(std::string uri, Fn callback)
     -> asio::awaitable<std::expected<
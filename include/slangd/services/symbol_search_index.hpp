@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "slangd/services/file_index.hpp"
+
+namespace slangd::services {
+
+// SymbolSearchIndex: Case-insensitive substring search over the declaration
+// names of a set of FileIndex shards (workspace/symbol).
+//
+// Names are case-folded once into a single blob. Every trigram of a folded
+// name is posted to the names containing it, in a sorted CSR layout (keys,
+// offsets, entry IDs). A query of three or more characters intersects the
+// postings of its trigrams and verifies the few survivors; shorter queries
+// scan the folded blob, which is small and contiguous.
+//
+// Results are ranked exact > prefix > substring, then shorter names first.
+// Immutable after Build, so concurrent queries are safe.
+class SymbolSearchIndex {
+ public:
+  struct Hit {
+    uint32_t file;    // Index into the shards passed to Build
+    uint32_t symbol;  // Index into that shard's GetSymbols()
+  };
+
+  SymbolSearchIndex() = default;
+
+  static auto Build(std::span<const FileIndex* const> files)
+      -> SymbolSearchIndex;
+
+  // Best `limit` matches for `query`. An empty query matches every name.
+  [[nodiscard]] auto Search(std::string_view query, size_t limit) const
+      -> std::vector<Hit>;
+
+  [[nodiscard]] auto Size() const -> size_t {
+    return entries_.size();
+  }
+
+  [[nodiscard]] auto MemoryUsage() const -> size_t;
+
+ private:
+  struct Entry {
+    Hit hit;
+    uint32_t offset;  // Folded name in folded_
+    uint32_t length;
+  };
+
+  [[nodiscard]] auto FoldedName(const Entry& entry) const -> std::string_view {
+    return std::string_view(folded_).substr(entry.offset, entry.length);
+  }
+
+  // Entry IDs of names containing `trigram`, ascending
+  [[nodiscard]] auto Postings(uint32_t trigram) const
+      -> std::span<const uint32_t>;
+
+  std::vector<Entry> entries_;
+  std::string folded_;
+
+  std::vector<uint32_t> trigrams_;         // Sorted, unique
+  std::vector<uint32_t> posting_offsets_;  // trigrams_.size() + 1
+  std::vector<uint32_t> postings_;
+};
+
+}  // namespace slangd::services
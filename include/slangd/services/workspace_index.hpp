@@ -0,0 +1,115 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <asio/any_io_executor.hpp>
+#include <asio/awaitable.hpp>
+#include <spdlog/spdlog.h>
+
+#include "lsp/basic.hpp"
+#include "lsp/workspace.hpp"
+#include "slangd/services/file_index.hpp"
+#include "slangd/services/index_artifact.hpp"
+#include "slangd/services/preamble_manager.hpp"
+#include "slangd/services/symbol_search_index.hpp"
+#include "slangd/utils/canonical_path.hpp"
+
+namespace slangd::services {
+
+// WorkspaceIndex: Immutable snapshot of declarations and identifier
+// occurrences of every preamble source file, for cross-file queries without
+// compiling each file.
+//
+// Built from the preamble's syntax trees, one task per file on the given
+// executor (syntax is immutable, so shards are collected in parallel). Each
+// file is a FileIndex shard keyed by content hash and preamble options key:
+// - unchanged since the previous snapshot: the shard is shared as is
+// - shard for this content in the IndexArtifact (built offline): mapped
+// - shard for this content in the cache directory: mapped from disk
+// - otherwise: collected from syntax and written back to the cache
+// so after an edit only the changed files are re-collected.
+//
+// Occurrences are matched by name (see syntax::IndexedOccurrence).
+// Declaration names are searchable through a SymbolSearchIndex built with
+// the snapshot.
+class WorkspaceIndex {
+ public:
+  struct Stats {
+    size_t files = 0;
+    size_t reused = 0;     // Shared with the previous snapshot
+    size_t imported = 0;   // Mapped from the IndexArtifact
+    size_t loaded = 0;     // Mapped from the cache directory
+    size_t collected = 0;  // Walked from syntax
+  };
+
+  WorkspaceIndex() = default;
+
+  // An empty `cache_dir` disables persistence
+  static auto Build(
+      std::shared_ptr<const PreambleManager> preamble,
+      std::shared_ptr<const WorkspaceIndex> previous,
+      std::filesystem::path cache_dir, asio::any_io_executor executor,
+      std::shared_ptr<spdlog::logger> logger = nullptr,
+      std::shared_ptr<const IndexArtifact> artifact = nullptr)
+      -> asio::awaitable<std::shared_ptr<const WorkspaceIndex>>;
+
+  // The files `artifact` holds references for, as a base for
+  // FilesAffectedSince() (no symbol search)
+  static auto FromArtifact(const IndexArtifact& artifact)
+      -> std::shared_ptr<const WorkspaceIndex>;
+
+  // <workspace>/.cache/slangd/index
+  static auto DefaultCacheDirectory(const CanonicalPath& workspace_root)
+      -> std::filesystem::path;
+
+  // Occurrences of `name` in all files (declarations included on request)
+  [[nodiscard]] auto FindOccurrences(
+      std::string_view name, bool include_declarations) const
+      -> std::vector<lsp::Location>;
+
+  // URIs of files whose bound references may differ from when `previous`
+  // was current, sorted: files whose shard changed or is new, plus files
+  // naming a declaration of a changed or removed file (by name, so a
+  // superset of the files that really depend on the change)
+  [[nodiscard]] auto FilesAffectedSince(const WorkspaceIndex& previous) const
+      -> std::vector<std::string>;
+
+  // Declarations whose name contains `query` (case-insensitive), best
+  // `limit` matches first
+  [[nodiscard]] auto SearchSymbols(std::string_view query, size_t limit) const
+      -> std::vector<lsp::WorkspaceSymbol>;
+
+  // Shard of the file with this URI, or nullptr
+  [[nodiscard]] auto GetFile(std::string_view uri) const -> const FileIndex*;
+
+  auto ForEachFile(
+      const std::function<void(std::string_view uri, const FileIndex&)>&
+          callback) const -> void;
+
+  [[nodiscard]] auto GetStats() const -> const Stats& {
+    return stats_;
+  }
+
+  // Heap bytes held by shards built in memory (mapped shards excluded)
+  [[nodiscard]] auto MemoryUsage() const -> size_t;
+
+ private:
+  struct File {
+    std::string uri;
+    std::shared_ptr<const FileIndex> index;
+  };
+
+  // Sorted by URI
+  std::vector<File> files_;
+  // Hits refer to files_ slots
+  SymbolSearchIndex symbol_search_;
+  Stats stats_;
+};
+
+}  // namespace slangd::services
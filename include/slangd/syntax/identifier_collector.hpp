@@ -0,0 +1,20 @@
+#pragma once
+
+#include <string_view>
+
+#include <slang/util/Hash.h>
+
+namespace slang::syntax {
+class SyntaxNode;
+}
+
+namespace slangd::syntax {
+
+// Adds the text of every identifier token under `node` to `names`.
+// Macro expansions and included files are part of the tree, so names that
+// only appear through them are collected too.
+auto CollectIdentifiers(
+    const slang::syntax::SyntaxNode& node,
+    slang::flat_hash_set<std::string_view>& names) -> void;
+
+}  // namespace slangd::syntax
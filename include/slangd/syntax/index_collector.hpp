@@ -0,0 +1,44 @@
+#pragma once
+
+#include <string_view>
+#include <vector>
+
+#include "lsp/basic.hpp"
+
+namespace slang::syntax {
+class SyntaxTree;
+}
+
+namespace slangd::syntax {
+
+// Declaration found in a file (module, class, function, variable, ...)
+struct IndexedSymbol {
+  std::string_view name;
+  // Name of the enclosing module/package/interface/class/subroutine, empty
+  // at file scope
+  std::string_view container;
+  lsp::SymbolKind kind;
+  lsp::Range range;  // Name token
+};
+
+// Identifier token in the file. Resolution is by name only: the workspace
+// index answers "which files mention X", and callers that need exact
+// binding confirm candidates with a semantic session.
+struct IndexedOccurrence {
+  std::string_view name;
+  lsp::Range range;
+  bool is_definition;
+};
+
+struct IndexedFile {
+  std::vector<IndexedSymbol> symbols;
+  std::vector<IndexedOccurrence> occurrences;
+};
+
+// Collect declarations and identifier occurrences of the tree's own source
+// buffer (tokens from includes and macro expansions are skipped). Syntax
+// only, so it is safe to run on many trees of one compilation in parallel.
+// Names view the tree's source text.
+auto CollectIndexEntries(const slang::syntax::SyntaxTree& tree) -> IndexedFile;
+
+}  // namespace slangd::syntax
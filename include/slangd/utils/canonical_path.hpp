@@ -15,6 +15,10 @@ class CanonicalPath {
   explicit CanonicalPath(std::filesystem::path path);
 
   static auto FromUri(std::string_view uri) -> CanonicalPath;
+
+  // Wrap a path that is already absolute and canonical (e.g. built from a
+  // canonical directory and a directory entry name) without touching disk
+  static auto FromNormalized(std::filesystem::path path) -> CanonicalPath;
   static auto CurrentPath() -> CanonicalPath;
 
   auto ToUri() const -> std::string;
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+
+#include "slangd/utils/canonical_path.hpp"
+
+namespace slangd::utils {
+
+struct DirectoryWalkOptions {
+  // Called for each subdirectory before descending; false prunes the subtree.
+  // Called concurrently from several threads.
+  std::function<bool(const std::filesystem::path& directory)> should_descend;
+
+  // Called with each file name; true collects the file. Called concurrently.
+  std::function<bool(std::string_view file_name)> should_collect;
+
+  // Worker threads (0 = hardware concurrency)
+  size_t num_threads = 0;
+};
+
+// Walk directory trees in parallel and collect matching files.
+//
+// Entry types come from readdir's d_type (filled from getdents), so regular
+// files and directories cost no stat call; only DT_UNKNOWN entries and
+// symlinks are stat'ed. Symlinked directories are not followed. Each worker
+// owns a deque of pending directories and steals from the others when empty,
+// so one huge subtree is spread across all workers.
+//
+// Roots must be canonical; collected regular files are then canonical too and
+// skip re-normalization. Results are sorted.
+auto WalkDirectories(
+    const std::vector<CanonicalPath>& roots,
+    const DirectoryWalkOptions& options,
+    std::shared_ptr<spdlog::logger> logger = nullptr)
+    -> std::vector<CanonicalPath>;
+
+}  // namespace slangd::utils
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+namespace slangd::utils {
+
+// Stable 64-bit content hash (XXH64 algorithm)
+// Stable across runs and platforms, so results may be persisted
+auto HashBytes(std::string_view data, uint64_t seed = 0) -> uint64_t;
+
+// Mix another value into an existing hash (order-dependent)
+auto HashCombine(uint64_t hash, uint64_t value) -> uint64_t;
+
+}  // namespace slangd::utils
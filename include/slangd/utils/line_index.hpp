@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+#include "lsp/basic.hpp"
+
+namespace slangd::utils {
+
+// LineIndex: Line start offsets of an immutable buffer.
+//
+// Built once with a memchr newline scan (vectorized in libc); afterwards
+// position -> offset is a table lookup and offset -> position a binary
+// search, instead of rescanning the buffer from the top on every request.
+//
+// Columns are byte offsets within the line, matching Slang's column numbers.
+class LineIndex {
+ public:
+  LineIndex() : LineIndex(std::string_view{}) {
+  }
+  explicit LineIndex(std::string_view text);
+
+  [[nodiscard]] auto LineCount() const -> size_t {
+    return line_starts_.size();
+  }
+
+  // Byte offset of an LSP position. Columns past the end of the line clamp
+  // to the line end; lines past the end of the buffer clamp to its end.
+  [[nodiscard]] auto OffsetAt(const lsp::Position& position) const -> size_t;
+
+  // LSP position of a byte offset (clamped to the buffer size)
+  [[nodiscard]] auto PositionAt(size_t offset) const -> lsp::Position;
+
+ private:
+  std::vector<size_t> line_starts_;
+  size_t size_ = 0;
+};
+
+}  // namespace slangd::utils
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <optional>
+#include <span>
+
+namespace slangd::utils {
+
+// MappedFile: Read-only memory mapping of a whole file (move-only).
+//
+// Pages are loaded lazily by the kernel and shared with the page cache, so
+// large read-mostly data (index shards) costs no heap and no parse on load.
+class MappedFile {
+ public:
+  MappedFile() = default;
+
+  // nullopt if the file can't be opened or is empty
+  static auto Open(const std::filesystem::path& path)
+      -> std::optional<MappedFile>;
+
+  MappedFile(const MappedFile&) = delete;
+  auto operator=(const MappedFile&) -> MappedFile& = delete;
+  MappedFile(MappedFile&& other) noexcept;
+  auto operator=(MappedFile&& other) noexcept -> MappedFile&;
+  ~MappedFile();
+
+  [[nodiscard]] auto Data() const -> std::span<const std::byte> {
+    return {static_cast<const std::byte*>(address_), size_};
+  }
+
+ private:
+  MappedFile(void* address, size_t size) : address_(address), size_(size) {
+  }
+
+  auto Reset() -> void;
+
+  void* address_ = nullptr;
+  size_t size_ = 0;
+};
+
+}  // namespace slangd::utils
@@ -0,0 +1,147 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+#include <nlohmann/json.hpp>
+
+namespace slangd::utils {
+
+// Counter: Monotonic event count
+class Counter {
+ public:
+  auto Add(uint64_t n = 1) -> void {
+    value_.fetch_add(n, std::memory_order_relaxed);
+  }
+
+  [[nodiscard]] auto Value() const -> uint64_t {
+    return value_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  std::atomic<uint64_t> value_{0};
+};
+
+// Gauge: Last reported level (queue depth, bytes in use)
+class Gauge {
+ public:
+  auto Set(int64_t value) -> void {
+    value_.store(value, std::memory_order_relaxed);
+  }
+
+  [[nodiscard]] auto Value() const -> int64_t {
+    return value_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  std::atomic<int64_t> value_{0};
+};
+
+// Histogram: Lock-free log-linear histogram (HDR style) of unsigned values.
+//
+// Values below kSubBuckets get one bucket each; above that every power of
+// two is split into kSubBuckets equal buckets, so reported percentiles are
+// within 1/kSubBuckets (6.25%) of a recorded value over the whole uint64_t
+// range, with a fixed 8 KB of counters.
+class Histogram {
+ public:
+  struct Summary {
+    uint64_t count = 0;
+    uint64_t sum = 0;
+    uint64_t min = 0;
+    uint64_t max = 0;
+    uint64_t p50 = 0;
+    uint64_t p90 = 0;
+    uint64_t p99 = 0;
+  };
+
+  static constexpr size_t kSubBucketBits = 4;
+  static constexpr size_t kSubBuckets = size_t{1} << kSubBucketBits;
+  static constexpr size_t kBucketCount =
+      kSubBuckets * (64 - kSubBucketBits + 1);
+
+  auto Record(uint64_t value) -> void;
+
+  [[nodiscard]] auto Summarize() const -> Summary;
+
+  static auto BucketIndex(uint64_t value) -> size_t;
+
+  // Largest value that falls into bucket `index`
+  static auto BucketUpperBound(size_t index) -> uint64_t;
+
+ private:
+  std::array<std::atomic<uint64_t>, kBucketCount> buckets_{};
+  std::atomic<uint64_t> sum_{0};
+  std::atomic<uint64_t> min_{UINT64_MAX};
+  std::atomic<uint64_t> max_{0};
+};
+
+// LatencyTimer: Records the lifetime of a scope in microseconds
+class LatencyTimer {
+ public:
+  explicit LatencyTimer(Histogram& histogram)
+      : histogram_(histogram), start_(std::chrono::steady_clock::now()) {
+  }
+  ~LatencyTimer();
+
+  LatencyTimer(const LatencyTimer&) = delete;
+  LatencyTimer(LatencyTimer&&) = delete;
+  auto operator=(const LatencyTimer&) -> LatencyTimer& = delete;
+  auto operator=(LatencyTimer&&) -> LatencyTimer& = delete;
+
+ private:
+  Histogram& histogram_;
+  std::chrono::steady_clock::time_point start_;
+};
+
+// Metrics: Process-wide registry of named counters, gauges and histograms,
+// served by the $/slangd/stats request.
+//
+// Components update their metrics as they go; nothing is sampled at export
+// time except process-level values (RSS, uptime). Names are dotted, with a
+// unit suffix for histograms and sized gauges ("session.parse_us",
+// "session.stored_bytes"). A "<cache>.hits"/"<cache>.misses" counter pair is
+// also exported as a hit rate.
+class Metrics {
+ public:
+  static auto Instance() -> Metrics&;
+
+  // Created on first use; references stay valid for the process lifetime,
+  // so hot paths can look them up once
+  auto GetCounter(std::string_view name) -> Counter&;
+  auto GetGauge(std::string_view name) -> Gauge&;
+  auto GetHistogram(std::string_view name) -> Histogram&;
+
+  [[nodiscard]] auto ExportJson() const -> nlohmann::json;
+
+  // Resident set size (from /proc/self/statm), 0 where unavailable
+  static auto ResidentBytes() -> size_t;
+
+  Metrics(const Metrics&) = delete;
+  Metrics(Metrics&&) = delete;
+  auto operator=(const Metrics&) -> Metrics& = delete;
+  auto operator=(Metrics&&) -> Metrics& = delete;
+  ~Metrics() = default;
+
+ private:
+  Metrics() = default;
+
+  template <typename T>
+  using Registry = std::map<std::string, std::unique_ptr<T>, std::less<>>;
+
+  mutable std::mutex mutex_;
+  Registry<Counter> counters_;
+  Registry<Gauge> gauges_;
+  Registry<Histogram> histograms_;
+  std::chrono::steady_clock::time_point start_ =
+      std::chrono::steady_clock::now();
+};
+
+}  // namespace slangd::utils
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <optional>
+#include <string_view>
+
+#include "lsp/basic.hpp"
+
+namespace slangd::utils {
+
+// PositionMapper: Maps positions between two versions of a document.
+//
+// The difference is reduced to one changed region (common prefix and suffix
+// are unchanged), which is exact for a single edit and conservative for
+// several: positions before the region are kept, positions after it shift
+// by the edit's line/column delta, and positions inside it have no
+// counterpart. A default-constructed mapper is the identity.
+//
+// Columns are byte offsets within the line, matching LineIndex.
+class PositionMapper {
+ public:
+  PositionMapper() = default;
+  PositionMapper(std::string_view old_text, std::string_view new_text);
+
+  // Position in the new text -> position in the old text
+  [[nodiscard]] auto ToOld(const lsp::Position& position) const
+      -> std::optional<lsp::Position>;
+
+  // Position in the old text -> position in the new text
+  [[nodiscard]] auto ToNew(const lsp::Position& position) const
+      -> std::optional<lsp::Position>;
+
+  // Both ends must map, and into the same side of the changed region
+  [[nodiscard]] auto ToNew(const lsp::Range& range) const
+      -> std::optional<lsp::Range>;
+
+  [[nodiscard]] auto IsIdentity() const -> bool {
+    return old_end_ == change_start_ && new_end_ == change_start_;
+  }
+
+ private:
+  struct Point {
+    int line = 0;
+    int character = 0;
+
+    auto operator<=>(const Point&) const = default;
+  };
+
+  [[nodiscard]] auto Map(
+      const lsp::Position& position, Point from_end, Point to_end) const
+      -> std::optional<lsp::Position>;
+
+  // Changed region: [change_start_, old_end_) in the old text and
+  // [change_start_, new_end_) in the new text
+  Point change_start_;
+  Point old_end_;
+  Point new_end_;
+};
+
+}  // namespace slangd::utils
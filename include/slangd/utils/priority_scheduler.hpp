@@ -0,0 +1,143 @@
+#pragma once
+
+#include <array>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <asio/execution.hpp>
+#include <asio/execution_context.hpp>
+#include <spdlog/spdlog.h>
+
+#include "slangd/utils/metrics.hpp"
+
+namespace slangd::utils {
+
+// Scheduling classes, highest priority first
+enum class TaskPriority : uint8_t {
+  kFocused,      // Document the user is editing or just opened
+  kVisible,      // Other open documents
+  kBackground,   // Preamble builds
+  kSpeculative,  // Prefetch work nobody is waiting for yet
+};
+
+// PriorityScheduler: Single worker pool for all CPU-bound compilation work.
+//
+// Every task is queued under a priority class, and an idle worker always
+// takes the oldest task of the highest non-empty class. Running tasks are
+// never interrupted, but an overlay build posted while thousands of preamble
+// parse tasks are queued starts as soon as the next worker frees up.
+//
+// Tasks are coarse (one file parse, one overlay elaboration), so a single
+// shared queue balances load across workers without per-thread deques.
+//
+// Executor() models an asio executor, so it works with asio::post,
+// co_spawn, strands and anything taking asio::any_io_executor.
+class PriorityScheduler : public asio::execution_context {
+ public:
+  static constexpr size_t kPriorityCount = 4;
+
+  class Executor {
+   public:
+    Executor(PriorityScheduler& scheduler, TaskPriority priority) noexcept
+        : scheduler_(&scheduler), priority_(priority) {
+    }
+
+    [[nodiscard]] auto query(asio::execution::context_t) const noexcept
+        -> PriorityScheduler& {
+      return *scheduler_;
+    }
+
+    static constexpr auto query(asio::execution::blocking_t) noexcept
+        -> asio::execution::blocking_t {
+      return asio::execution::blocking.never;
+    }
+
+    [[nodiscard]] auto require(asio::execution::blocking_t::never_t)
+        const noexcept -> Executor {
+      return *this;
+    }
+
+    template <typename Function>
+    auto execute(Function&& function) const -> void {
+      scheduler_->Enqueue(
+          priority_,
+          std::move_only_function<void()>(std::forward<Function>(function)));
+    }
+
+    [[nodiscard]] auto GetPriority() const noexcept -> TaskPriority {
+      return priority_;
+    }
+
+    friend auto operator==(const Executor&, const Executor&) noexcept
+        -> bool = default;
+
+   private:
+    PriorityScheduler* scheduler_;
+    TaskPriority priority_;
+  };
+
+  explicit PriorityScheduler(
+      size_t num_threads, std::shared_ptr<spdlog::logger> logger = nullptr);
+
+  // Joins the workers (queued work still runs)
+  ~PriorityScheduler();
+
+  // Non-copyable, non-movable
+  PriorityScheduler(const PriorityScheduler&) = delete;
+  auto operator=(const PriorityScheduler&) -> PriorityScheduler& = delete;
+  PriorityScheduler(PriorityScheduler&&) = delete;
+  auto operator=(PriorityScheduler&&) -> PriorityScheduler& = delete;
+
+  [[nodiscard]] auto GetExecutor(TaskPriority priority) -> Executor {
+    return {*this, priority};
+  }
+
+  // Wait until all queued and running tasks (including tasks they post) are
+  // done, then stop the workers. Idempotent. Only the owner should call it:
+  // tasks posted afterwards never run.
+  auto Join() -> void;
+
+  [[nodiscard]] auto ThreadCount() const -> size_t {
+    return thread_count_;
+  }
+
+  // Default size: all hardware threads but one (left for the LSP loop)
+  static auto DefaultThreadCount() -> size_t;
+
+ private:
+  auto Enqueue(TaskPriority priority, std::move_only_function<void()> task)
+      -> void;
+  auto WorkerLoop() -> void;
+
+  // Report queue depth to the metrics registry (mutex_ held)
+  auto PublishLocked() -> void;
+
+  // One FIFO per priority class, indexed by TaskPriority
+  std::array<std::deque<std::move_only_function<void()>>, kPriorityCount>
+      queues_;
+  size_t pending_ = 0;
+  size_t running_ = 0;
+  bool draining_ = false;
+  // Workers joined
+  bool stopped_ = false;
+
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  std::vector<std::thread> workers_;
+  size_t thread_count_;
+
+  Gauge& queued_gauge_;
+  Gauge& running_gauge_;
+
+  std::shared_ptr<spdlog::logger> logger_;
+};
+
+}  // namespace slangd::utils
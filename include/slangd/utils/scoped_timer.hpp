@@ -1,6 +1,7 @@
 #pragma once
 
 #include <chrono>
+#include <cstdint>
 #include <memory>
 #include <string>
 
@@ -8,6 +9,8 @@
 
 namespace slangd::utils {
 
+// ScopedTimer: Logs the duration of a scope at debug level and records it
+// as a span in utils::Tracer (see tracer.hpp)
 class ScopedTimer {
  public:
   ScopedTimer(const ScopedTimer&) = default;
@@ -26,6 +29,7 @@ class ScopedTimer {
 
  private:
   std::chrono::steady_clock::time_point start_;
+  uint32_t thread_;
   std::string operation_name_;
   std::shared_ptr<spdlog::logger> logger_;
 };
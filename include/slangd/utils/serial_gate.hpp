@@ -0,0 +1,111 @@
+#pragma once
+
+#include <array>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+#include <asio/any_io_executor.hpp>
+#include <asio/awaitable.hpp>
+#include <asio/use_awaitable.hpp>
+
+#include "slangd/utils/broadcast_event.hpp"
+#include "slangd/utils/priority_scheduler.hpp"
+
+namespace slangd::utils {
+
+// SerialGate: Async mutual exclusion with priority hand-off.
+//
+// Like a strand, at most one holder runs at a time. Unlike a strand it is
+// not bound to one executor: holders keep running at their own priority,
+// and a released gate goes to the oldest waiter of the highest priority
+// class. So speculative work can hold the gate without jumping ahead of
+// other background work, and delays focused work by at most the one job
+// that is already running.
+//
+// Usage:
+//   auto lease = co_await gate.Acquire(priority);
+//   co_await asio::post(scheduler.GetExecutor(priority), asio::use_awaitable);
+//   ...  // exclusive until `lease` is destroyed
+class SerialGate {
+ public:
+  // Releases the gate when destroyed
+  class Lease {
+   public:
+    explicit Lease(SerialGate& gate) : gate_(&gate) {
+    }
+    Lease(const Lease&) = delete;
+    Lease(Lease&& other) noexcept
+        : gate_(std::exchange(other.gate_, nullptr)) {
+    }
+    auto operator=(const Lease&) -> Lease& = delete;
+    auto operator=(Lease&&) -> Lease& = delete;
+    ~Lease() {
+      if (gate_ != nullptr) {
+        gate_->Release();
+      }
+    }
+
+   private:
+    SerialGate* gate_;
+  };
+
+  // Waiters are resumed on `executor`
+  explicit SerialGate(asio::any_io_executor executor)
+      : executor_(std::move(executor)) {
+  }
+
+  SerialGate(const SerialGate&) = delete;
+  SerialGate(SerialGate&&) = delete;
+  auto operator=(const SerialGate&) -> SerialGate& = delete;
+  auto operator=(SerialGate&&) -> SerialGate& = delete;
+  ~SerialGate() = default;
+
+  auto Acquire(TaskPriority priority) -> asio::awaitable<Lease> {
+    std::shared_ptr<BroadcastEvent> turn;
+    {
+      std::lock_guard lock(mutex_);
+      if (!held_) {
+        held_ = true;
+        co_return Lease(*this);
+      }
+      turn = std::make_shared<BroadcastEvent>(executor_);
+      waiters_[static_cast<size_t>(priority)].push_back(turn);
+    }
+    // Release() handed the gate over without clearing held_
+    co_await turn->AsyncWait(asio::use_awaitable);
+    co_return Lease(*this);
+  }
+
+ private:
+  auto Release() -> void {
+    std::shared_ptr<BroadcastEvent> next;
+    {
+      std::lock_guard lock(mutex_);
+      for (auto& queue : waiters_) {
+        if (!queue.empty()) {
+          next = std::move(queue.front());
+          queue.pop_front();
+          break;
+        }
+      }
+      if (!next) {
+        held_ = false;
+        return;
+      }
+    }
+    next->Set();
+  }
+
+  asio::any_io_executor executor_;
+  std::mutex mutex_;
+  bool held_ = false;
+  // One FIFO per TaskPriority, highest priority first
+  std::array<
+      std::deque<std::shared_ptr<BroadcastEvent>>,
+      PriorityScheduler::kPriorityCount>
+      waiters_;
+};
+
+}  // namespace slangd::utils
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include <slang/util/Hash.h>
+
+namespace slangd::utils {
+
+// StringInterner: Deduplicated string storage addressed by 32-bit IDs.
+//
+// Strings live in a deque, so their addresses (and the map keys viewing
+// them) survive both growth and moving the interner. Not copyable.
+class StringInterner {
+ public:
+  using Id = uint32_t;
+
+  StringInterner() = default;
+  StringInterner(const StringInterner&) = delete;
+  auto operator=(const StringInterner&) -> StringInterner& = delete;
+  StringInterner(StringInterner&&) noexcept = default;
+  auto operator=(StringInterner&&) noexcept -> StringInterner& = default;
+  ~StringInterner() = default;
+
+  // ID of `text`, adding it on first use
+  auto Intern(std::string_view text) -> Id;
+
+  // ID of `text` if already interned
+  [[nodiscard]] auto Find(std::string_view text) const -> std::optional<Id>;
+
+  [[nodiscard]] auto Get(Id id) const -> std::string_view {
+    return strings_[id];
+  }
+
+  [[nodiscard]] auto Size() const -> size_t {
+    return strings_.size();
+  }
+
+  // Approximate heap bytes held (strings + lookup table)
+  [[nodiscard]] auto MemoryUsage() const -> size_t;
+
+ private:
+  std::deque<std::string> strings_;
+  slang::flat_hash_map<std::string_view, Id> ids_;
+};
+
+}  // namespace slangd::utils
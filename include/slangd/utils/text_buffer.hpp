@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "lsp/basic.hpp"
+
+namespace slangd::utils {
+
+// TextBuffer: Editable document text stored as a list of small chunks.
+//
+// Incremental LSP edits only touch the chunks around the edited range, so a
+// keystroke in a 20k-line file costs O(chunk + number of chunks) instead of
+// copying the whole file. ToString() materializes a contiguous copy when a
+// consumer (parser, compilation) actually needs one.
+//
+// Positions are LSP positions: 0-based line and UTF-16 code unit column.
+// Out-of-range positions are clamped to the end of the line / document.
+class TextBuffer {
+ public:
+  TextBuffer() = default;
+  explicit TextBuffer(std::string_view text);
+
+  // Replace the text in `range` with `text`
+  auto Replace(const lsp::Range& range, std::string_view text) -> void;
+
+  // Replace the whole document
+  auto Assign(std::string_view text) -> void;
+
+  [[nodiscard]] auto ToString() const -> std::string;
+
+  [[nodiscard]] auto Size() const -> size_t {
+    return size_;
+  }
+
+  [[nodiscard]] auto ChunkCount() const -> size_t {
+    return chunks_.size();
+  }
+
+  // Byte offset of an LSP position (clamped)
+  [[nodiscard]] auto OffsetAt(const lsp::Position& position) const -> size_t;
+
+ private:
+  // Chunks are split at kChunkSize and merged when an edit leaves a chunk
+  // smaller than kMinChunkSize
+  static constexpr size_t kChunkSize = size_t{4} * 1024;
+  static constexpr size_t kMinChunkSize = kChunkSize / 4;
+
+  struct Chunk {
+    std::string text;
+    size_t newlines = 0;
+  };
+
+  static auto MakeChunk(std::string_view text) -> Chunk;
+
+  // Split `text` into chunks appended to `out`
+  static auto SplitInto(std::string_view text, std::vector<Chunk>& out)
+      -> void;
+
+  std::vector<Chunk> chunks_;
+  size_t size_ = 0;
+};
+
+}  // namespace slangd::utils
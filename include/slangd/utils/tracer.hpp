@@ -0,0 +1,111 @@
+#pragma once
+
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace slangd::utils {
+
+// Tracer: Process-wide recorder of timed spans, exported as Chrome trace
+// JSON (Trace Event Format, opened by ui.perfetto.dev and chrome://tracing).
+//
+// Each thread appends finished spans to its own fixed-size ring buffer, so
+// recording costs a clock read and an uncontended lock, and a long-running
+// server keeps only the most recent kSpansPerThread spans per thread.
+// Buffers of exited threads are reused by new threads.
+//
+// Spans that begin and end on one thread become complete ("X") events.
+// Request spans and spans that moved threads (coroutines resumed elsewhere)
+// become async begin/end pairs, since they can overlap other spans.
+class Tracer {
+ public:
+  struct Span {
+    std::string name;
+    // Static string (e.g. "timer", "request")
+    std::string_view category;
+    int64_t start_us = 0;
+    int64_t end_us = 0;
+    uint32_t begin_thread = 0;
+    uint32_t end_thread = 0;
+    // Server-assigned sequence number of an LSP message, 0 if none
+    uint64_t request_id = 0;
+  };
+
+  static constexpr size_t kSpansPerThread = 4096;
+
+  static auto Instance() -> Tracer&;
+
+  // Steady clock timestamp in microseconds
+  static auto NowMicros() -> int64_t;
+
+  // Small sequential ID of the calling thread
+  static auto CurrentThreadId() -> uint32_t;
+
+  // Name shown for the calling thread in exported traces
+  auto SetThreadName(std::string name) -> void;
+
+  auto Record(Span span) -> void;
+
+  [[nodiscard]] auto SpanCount() const -> size_t;
+
+  [[nodiscard]] auto ExportChromeTrace() const -> std::string;
+
+  // Writes ExportChromeTrace() to `path`; returns the number of spans
+  auto WriteChromeTrace(const std::filesystem::path& path) const
+      -> std::expected<size_t, std::string>;
+
+  // <temp dir>/slangd-trace-<pid>.json
+  static auto DefaultTracePath() -> std::filesystem::path;
+
+  Tracer(const Tracer&) = delete;
+  Tracer(Tracer&&) = delete;
+  auto operator=(const Tracer&) -> Tracer& = delete;
+  auto operator=(Tracer&&) -> Tracer& = delete;
+  ~Tracer() = default;
+
+ private:
+  Tracer() = default;
+
+  struct ThreadBuffer {
+    mutable std::mutex mutex;
+    std::vector<Span> spans;
+    // Ring position of the next write once `spans` is full
+    size_t next = 0;
+    uint32_t thread_id = 0;
+    std::string thread_name;
+    bool retired = false;
+  };
+
+  // Released (marked retired) when its thread exits
+  class LocalHandle;
+
+  auto LocalBuffer() -> ThreadBuffer&;
+  auto Snapshot() const -> std::vector<std::shared_ptr<ThreadBuffer>>;
+
+  mutable std::mutex registry_mutex_;
+  std::vector<std::shared_ptr<ThreadBuffer>> buffers_;
+};
+
+// TraceSpan: RAII span recorded into Tracer::Instance() when destroyed
+class TraceSpan {
+ public:
+  explicit TraceSpan(
+      std::string name, std::string_view category = "span",
+      uint64_t request_id = 0);
+  ~TraceSpan();
+
+  TraceSpan(const TraceSpan&) = delete;
+  TraceSpan(TraceSpan&&) = delete;
+  auto operator=(const TraceSpan&) -> TraceSpan& = delete;
+  auto operator=(TraceSpan&&) -> TraceSpan& = delete;
+
+ private:
+  Tracer::Span span_;
+};
+
+}  // namespace slangd::utils
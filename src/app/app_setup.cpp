@@ -1,6 +1,7 @@
 #include "app/app_setup.hpp"
 
 #include <array>
+#include <charconv>
 #include <cstdlib>
 #include <string_view>
 #include <unordered_map>
@@ -57,7 +58,78 @@ auto ParsePipeName(const std::vector<std::string>& args)
   return args[1].substr(kPipePrefix.length());
 }
 
-auto SetupLoggers()
+auto ParseCheckOptions(const std::vector<std::string>& args)
+    -> std::optional<CheckOptions> {
+  constexpr std::string_view kFormatPrefix = "--format=";
+  constexpr std::string_view kJobsPrefix = "--jobs=";
+  if (args.size() < 2 || args[1] != "--check") {
+    return std::nullopt;
+  }
+
+  CheckOptions options;
+  bool has_workspace = false;
+  for (size_t i = 2; i < args.size(); ++i) {
+    std::string_view arg = args[i];
+    if (arg.starts_with(kFormatPrefix)) {
+      auto format = arg.substr(kFormatPrefix.length());
+      if (format == "json") {
+        options.format = CheckFormat::kJson;
+      } else if (format == "sarif") {
+        options.format = CheckFormat::kSarif;
+      } else {
+        return std::nullopt;
+      }
+    } else if (arg.starts_with(kJobsPrefix)) {
+      auto jobs = arg.substr(kJobsPrefix.length());
+      auto [end, ec] =
+          std::from_chars(jobs.data(), jobs.data() + jobs.size(), options.jobs);
+      if (ec != std::errc{} || end != jobs.data() + jobs.size()) {
+        return std::nullopt;
+      }
+    } else if (!arg.starts_with("--") && !has_workspace) {
+      options.workspace = arg;
+      has_workspace = true;
+    } else {
+      return std::nullopt;
+    }
+  }
+  return options;
+}
+
+auto ParseIndexOptions(const std::vector<std::string>& args)
+    -> std::optional<IndexOptions> {
+  constexpr std::string_view kOutPrefix = "--out=";
+  constexpr std::string_view kJobsPrefix = "--jobs=";
+  if (args.size() < 2 || args[1] != "index") {
+    return std::nullopt;
+  }
+
+  IndexOptions options;
+  bool has_workspace = false;
+  for (size_t i = 2; i < args.size(); ++i) {
+    std::string_view arg = args[i];
+    if (arg == "--out" && i + 1 < args.size()) {
+      options.out = args[++i];
+    } else if (arg.starts_with(kOutPrefix)) {
+      options.out = std::string(arg.substr(kOutPrefix.length()));
+    } else if (arg.starts_with(kJobsPrefix)) {
+      auto jobs = arg.substr(kJobsPrefix.length());
+      auto [end, ec] =
+          std::from_chars(jobs.data(), jobs.data() + jobs.size(), options.jobs);
+      if (ec != std::errc{} || end != jobs.data() + jobs.size()) {
+        return std::nullopt;
+      }
+    } else if (!arg.starts_with("--") && !has_workspace) {
+      options.workspace = arg;
+      has_workspace = true;
+    } else {
+      return std::nullopt;
+    }
+  }
+  return options;
+}
+
+auto SetupLoggers(bool to_stderr)
     -> std::unordered_map<std::string, std::shared_ptr<spdlog::logger>> {
   const auto user_log_level = GetLogLevelFromEnv();
   spdlog::set_level(user_log_level);
@@ -71,7 +143,8 @@ auto SetupLoggers()
   std::unordered_map<std::string, std::shared_ptr<spdlog::logger>> loggers;
 
   for (const auto& config : kLoggerConfigs) {
-    auto logger = spdlog::stdout_color_mt(std::string(config.name));
+    auto logger = to_stderr ? spdlog::stderr_color_mt(std::string(config.name))
+                            : spdlog::stdout_color_mt(std::string(config.name));
     const auto level =
         (config.name == "slangd") ? user_log_level : config.level;
     ConfigureLogger(logger, level);
@@ -75,6 +75,7 @@ void LspServer::RegisterHandlers() {
   RegisterLanguageFeatureHandlers();
   RegisterWorkspaceFeatureHandlers();
   RegisterWindowFeatureHandlers();
+  RegisterExtensionHandlers();
 }
 
 void LspServer::RegisterLifecycleHandlers() {
@@ -168,7 +169,13 @@ void LspServer::RegisterLanguageFeatureHandlers() {
 
   // TODO(hankhsu1996): Go to Type Definition
   // TODO(hankhsu1996): Go to Implementation
-  // TODO(hankhsu1996): Find References
+
+  // Find References Request
+  endpoint_->RegisterMethodCall<ReferenceParams, ReferenceResult, LspError>(
+      "textDocument/references", [this](const ReferenceParams& params) {
+        return OnReferences(params);
+      });
+
   // TODO(hankhsu1996): Prepare Call Hierarchy
   // TODO(hankhsu1996): Call Hierarchy Incoming Calls
   // TODO(hankhsu1996): Call Hierarchy Outgoing Calls
@@ -216,7 +223,13 @@ void LspServer::RegisterLanguageFeatureHandlers() {
 }
 
 void LspServer::RegisterWorkspaceFeatureHandlers() {
-  // TODO(hankhsu1996): Workspace Symbols
+  // Workspace Symbols Request
+  endpoint_->RegisterMethodCall<
+      WorkspaceSymbolParams, WorkspaceSymbolResult, LspError>(
+      "workspace/symbol", [this](const WorkspaceSymbolParams& params) {
+        return OnWorkspaceSymbols(params);
+      });
+
   // TODO(hankhsu1996): Workspace Symbol Resolve
   // TODO(hankhsu1996): Get Configuration
   // TODO(hankhsu1996): Did Change Configuration
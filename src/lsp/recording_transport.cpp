@@ -0,0 +1,121 @@
+#include "lsp/recording_transport.hpp"
+
+#include <nlohmann/json.hpp>
+
+namespace lsp {
+
+namespace {
+
+constexpr std::string_view kIn = "in";
+constexpr std::string_view kOut = "out";
+
+}  // namespace
+
+auto ReadRecording(const std::filesystem::path& path)
+    -> std::expected<std::vector<RecordedMessage>, std::string> {
+  std::ifstream in(path);
+  if (!in) {
+    return std::unexpected("Cannot open " + path.string());
+  }
+
+  std::vector<RecordedMessage> messages;
+  std::string line;
+  size_t line_number = 0;
+  while (std::getline(in, line)) {
+    ++line_number;
+    if (line.empty()) {
+      continue;
+    }
+    auto json = nlohmann::json::parse(line, nullptr, false);
+    if (json.is_discarded() || !json.contains("timeUs") ||
+        !json.contains("direction") || !json.contains("message")) {
+      // A crashed recorder may leave a truncated last line
+      return std::unexpected(
+          path.string() + ":" + std::to_string(line_number) +
+          ": malformed recording line");
+    }
+    messages.push_back(
+        RecordedMessage{
+            .time = std::chrono::microseconds(json["timeUs"].get<int64_t>()),
+            .direction = json["direction"] == kOut
+                             ? RecordedMessage::Direction::kOut
+                             : RecordedMessage::Direction::kIn,
+            .message = json["message"].get<std::string>()});
+  }
+  return messages;
+}
+
+RecordingTransport::RecordingTransport(
+    asio::any_io_executor executor,
+    std::unique_ptr<jsonrpc::transport::Transport> inner,
+    const std::filesystem::path& path, std::shared_ptr<spdlog::logger> logger)
+    : jsonrpc::transport::Transport(std::move(executor)),
+      inner_(std::move(inner)),
+      start_(std::chrono::steady_clock::now()),
+      out_(path, std::ios::out | std::ios::trunc),
+      logger_(logger ? logger : spdlog::default_logger()) {
+  if (out_) {
+    logger_->info("Recording LSP traffic to {}", path.string());
+  } else {
+    logger_->error(
+        "Cannot open {}, LSP traffic is not recorded", path.string());
+  }
+}
+
+auto RecordingTransport::Start()
+    -> asio::awaitable<std::expected<void, jsonrpc::error::RpcError>> {
+  co_return co_await inner_->Start();
+}
+
+auto RecordingTransport::SendMessage(std::string message)
+    -> asio::awaitable<std::expected<void, jsonrpc::error::RpcError>> {
+  Append(RecordedMessage::Direction::kOut, message);
+  co_return co_await inner_->SendMessage(std::move(message));
+}
+
+auto RecordingTransport::ReceiveMessage()
+    -> asio::awaitable<std::expected<std::string, jsonrpc::error::RpcError>> {
+  auto message = co_await inner_->ReceiveMessage();
+  if (message) {
+    Append(RecordedMessage::Direction::kIn, *message);
+  }
+  co_return message;
+}
+
+auto RecordingTransport::Close()
+    -> asio::awaitable<std::expected<void, jsonrpc::error::RpcError>> {
+  {
+    std::lock_guard lock(mutex_);
+    out_.flush();
+  }
+  co_return co_await inner_->Close();
+}
+
+void RecordingTransport::CloseNow() {
+  {
+    std::lock_guard lock(mutex_);
+    out_.flush();
+  }
+  inner_->CloseNow();
+}
+
+auto RecordingTransport::Append(
+    RecordedMessage::Direction direction, const std::string& message) -> void {
+  auto time = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - start_);
+  nlohmann::json line{
+      {"timeUs", time.count()},
+      {"direction",
+       direction == RecordedMessage::Direction::kOut ? kOut : kIn},
+      {"message", message}};
+
+  std::lock_guard lock(mutex_);
+  if (out_) {
+    // Invalid UTF-8 from the client must not break the recording
+    out_ << line.dump(-1, ' ', false, nlohmann::json::error_handler_t::replace)
+         << '\n'
+         << std::flush;
+  }
+}
+
+}  // namespace lsp
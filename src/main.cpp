@@ -1,21 +1,179 @@
+#include <algorithm>
+#include <csignal>
+#include <cstdlib>
+#include <expected>
+#include <filesystem>
+#include <iostream>
 #include <memory>
+#include <optional>
 #include <string>
+#include <string_view>
+#include <thread>
 #include <vector>
 
 #include <asio.hpp>
+#include <fmt/format.h>
 #include <jsonrpc/endpoint/endpoint.hpp>
 #include <jsonrpc/transport/framed_pipe_transport.hpp>
+#include <nlohmann/json.hpp>
 #include <spdlog/spdlog.h>
 
 #include "app/app_setup.hpp"
 #include "app/crash_handler.hpp"
+#include "lsp/recording_transport.hpp"
 #include "slangd/core/slangd_lsp_server.hpp"
+#include "slangd/services/batch_checker.hpp"
+#include "slangd/services/index_artifact.hpp"
+#include "slangd/services/index_builder.hpp"
 #include "slangd/services/language_service.hpp"
+#include "slangd/utils/canonical_path.hpp"
+#include "slangd/utils/tracer.hpp"
 
 using jsonrpc::endpoint::RpcEndpoint;
 using jsonrpc::transport::FramedPipeTransport;
+using jsonrpc::transport::Transport;
+using lsp::RecordingTransport;
+using slangd::CanonicalPath;
 using slangd::SlangdLspServer;
+using slangd::services::BatchChecker;
+using slangd::services::BatchCheckSummary;
+using slangd::services::FileCheckResult;
+using slangd::services::IndexArtifact;
+using slangd::services::IndexBuilder;
+using slangd::services::IndexBuildSummary;
 using slangd::services::LanguageService;
+using slangd::utils::Tracer;
+
+namespace {
+
+// SIGUSR1 writes the buffered trace spans to Tracer::DefaultTracePath()
+// (same as the $/slangd/dumpTrace request)
+void WaitForTraceSignal(asio::signal_set& signals) {
+  signals.async_wait([&signals](std::error_code ec, int /*signal*/) {
+    if (ec) {
+      return;
+    }
+    auto path = Tracer::DefaultTracePath();
+    if (auto result = Tracer::Instance().WriteChromeTrace(path)) {
+      spdlog::info("Wrote {} trace spans to {}", *result, path.string());
+    } else {
+      spdlog::error("Trace dump failed: {}", result.error());
+    }
+    WaitForTraceSignal(signals);
+  });
+}
+
+// Command-line modes log to stderr, at warn level unless SPDLOG_LEVEL is
+// set, so CI output stays readable
+auto SetupCommandLoggers() -> std::shared_ptr<spdlog::logger> {
+  setenv("SPDLOG_LEVEL", "warn", 0);
+  auto loggers = app::SetupLoggers(true);
+  spdlog::set_default_logger(loggers["slangd"]);
+  Tracer::Instance().SetThreadName("main");
+  return loggers["slangd"];
+}
+
+// The workspace of a command-line mode, or nullopt (logged) if invalid
+auto ResolveWorkspace(const std::string& workspace)
+    -> std::optional<CanonicalPath> {
+  auto path = std::filesystem::absolute(workspace);
+  if (!std::filesystem::is_directory(path)) {
+    spdlog::error("Not a directory: {}", path.string());
+    return std::nullopt;
+  }
+  return CanonicalPath(path);
+}
+
+// Nothing else runs in command-line modes, so use every hardware thread
+auto ResolveJobs(size_t jobs) -> size_t {
+  return jobs > 0 ? jobs : std::max(std::thread::hardware_concurrency(), 1U);
+}
+
+// `--check`: diagnostics of every project file, without an editor. JSON
+// output is one line per file with diagnostics, streamed as files finish;
+// SARIF is one document written at the end. Exits 1 on any error.
+auto RunCheck(const app::CheckOptions& options) -> int {
+  auto logger = SetupCommandLoggers();
+  auto workspace = ResolveWorkspace(options.workspace);
+  if (!workspace) {
+    return 1;
+  }
+
+  asio::io_context io_context;
+  BatchChecker checker(
+      io_context.get_executor(), *workspace, ResolveJobs(options.jobs),
+      logger);
+
+  auto dump = [](const nlohmann::json& json, int indent) {
+    return json.dump(
+        indent, ' ', false, nlohmann::json::error_handler_t::replace);
+  };
+  std::vector<FileCheckResult> sarif_results;
+  BatchCheckSummary summary;
+  asio::co_spawn(
+      io_context,
+      [&]() -> asio::awaitable<void> {
+        summary = co_await checker.Run([&](const FileCheckResult& result) {
+          if (result.checked && result.diagnostics.empty()) {
+            return;
+          }
+          if (options.format == app::CheckFormat::kSarif) {
+            sarif_results.push_back(result);
+          } else {
+            std::cout << dump(ToJson(result), -1) << '\n' << std::flush;
+          }
+        });
+      },
+      asio::detached);
+  io_context.run();
+
+  if (options.format == app::CheckFormat::kSarif) {
+    std::cout << dump(ToSarif(sarif_results), 2) << '\n';
+  }
+  std::cerr << fmt::format(
+      "{} files checked: {} errors, {} warnings{}\n",
+      summary.files - summary.unchecked, summary.errors, summary.warnings,
+      summary.unchecked > 0
+          ? fmt::format(", {} files failed", summary.unchecked)
+          : "");
+  return summary.errors > 0 || summary.unchecked > 0 ? 1 : 0;
+}
+
+// `index`: write an IndexArtifact of the workspace (see IndexBuilder), for
+// servers on other machines to load
+auto RunIndex(const app::IndexOptions& options) -> int {
+  auto logger = SetupCommandLoggers();
+  auto workspace = ResolveWorkspace(options.workspace);
+  if (!workspace) {
+    return 1;
+  }
+  auto out = options.out ? std::filesystem::absolute(*options.out)
+                         : IndexArtifact::DefaultPath(*workspace);
+
+  asio::io_context io_context;
+  IndexBuilder builder(
+      io_context.get_executor(), *workspace, ResolveJobs(options.jobs),
+      logger);
+
+  std::expected<IndexBuildSummary, std::string> result =
+      std::unexpected("Index build did not finish");
+  asio::co_spawn(
+      io_context,
+      [&]() -> asio::awaitable<void> { result = co_await builder.Run(out); },
+      asio::detached);
+  io_context.run();
+
+  if (!result) {
+    spdlog::error("{}", result.error());
+    return 1;
+  }
+  std::cerr << fmt::format(
+      "Wrote index of {} files ({} with references) to {} ({} KB)\n",
+      result->files, result->swept, out.string(), result->bytes / 1024);
+  return 0;
+}
+
+}  // namespace
 
 auto main(int argc, char* argv[]) -> int {
   // Initialize debugging features
@@ -24,9 +182,32 @@ auto main(int argc, char* argv[]) -> int {
 
   // Parse command-line arguments
   const std::vector<std::string> args(argv, argv + argc);
+  if (args.size() >= 2 && args[1] == "--check") {
+    auto check_options = app::ParseCheckOptions(args);
+    if (!check_options) {
+      spdlog::error(
+          "Usage: <executable> --check [<workspace dir>] "
+          "[--format=json|sarif] [--jobs=<n>]");
+      return 1;
+    }
+    return RunCheck(*check_options);
+  }
+  if (args.size() >= 2 && args[1] == "index") {
+    auto index_options = app::ParseIndexOptions(args);
+    if (!index_options) {
+      spdlog::error(
+          "Usage: <executable> index [<workspace dir>] [--out <file>] "
+          "[--jobs=<n>]");
+      return 1;
+    }
+    return RunIndex(*index_options);
+  }
+
   auto pipe_name_opt = app::ParsePipeName(args);
   if (!pipe_name_opt) {
-    spdlog::error("Usage: <executable> --pipe=<pipe name>");
+    spdlog::error(
+        "Usage: <executable> --pipe=<pipe name> | --check [<workspace dir>] "
+        "| index [<workspace dir>] [--out <file>]");
     return 1;
   }
   const std::string pipe_name = pipe_name_opt.value();
@@ -37,11 +218,21 @@ auto main(int argc, char* argv[]) -> int {
   // Create the IO context
   asio::io_context io_context;
   auto executor = io_context.get_executor();
+  Tracer::Instance().SetThreadName("main");
+
+  asio::signal_set trace_signals(io_context, SIGUSR1);
+  WaitForTraceSignal(trace_signals);
 
   // Create transport and endpoint
-  auto transport = std::make_unique<FramedPipeTransport>(
+  std::unique_ptr<Transport> transport = std::make_unique<FramedPipeTransport>(
       executor, pipe_name, false, loggers["transport"]);
 
+  // SLANGD_RECORD=<path> records the session for //tools/replay
+  if (const char* record_path = std::getenv("SLANGD_RECORD")) {
+    transport = std::make_unique<RecordingTransport>(
+        executor, std::move(transport), record_path, loggers["transport"]);
+  }
+
   auto endpoint = std::make_unique<RpcEndpoint>(
       executor, std::move(transport), loggers["jsonrpc"]);
 
@@ -54,11 +245,13 @@ auto main(int argc, char* argv[]) -> int {
   // Start the server asynchronously
   asio::co_spawn(
       io_context,
-      [&server]() -> asio::awaitable<void> {
+      [&server, &trace_signals]() -> asio::awaitable<void> {
         auto result = co_await server->Start();
         if (!result.has_value()) {
           spdlog::error("Server error: {}", result.error().Message());
         }
+        // Pending signal wait would keep io_context.run() from returning
+        trace_signals.cancel();
         co_return;
       },
       asio::detached);
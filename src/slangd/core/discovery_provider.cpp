@@ -3,6 +3,7 @@
 #include <filesystem>
 #include <fstream>
 
+#include "slangd/utils/directory_walker.hpp"
 #include "slangd/utils/path_utils.hpp"
 #include "slangd/utils/scoped_timer.hpp"
 
@@ -112,12 +113,12 @@ auto WorkspaceDiscoveryProvider::DiscoverFiles(
     -> std::vector<CanonicalPath> {
   utils::ScopedTimer timer("Workspace file discovery", logger_);
 
-  std::vector<CanonicalPath> all_files;
+  std::vector<CanonicalPath> roots;
   const auto& discover_dirs = config.GetDiscoverDirs();
 
   if (discover_dirs.empty()) {
     // No DiscoverDirs specified - discover entire workspace
-    all_files = FindSystemVerilogFilesInDirectory(workspace_root);
+    roots.push_back(workspace_root);
   } else {
     // DiscoverDirs specified - only discover in those paths
     for (const auto& dir : discover_dirs) {
@@ -127,48 +128,54 @@ auto WorkspaceDiscoveryProvider::DiscoverFiles(
             "DiscoverDirs path does not exist: {}", discover_path.String());
         continue;
       }
-
-      auto files = FindSystemVerilogFilesInDirectory(discover_path);
-      all_files.insert(all_files.end(), files.begin(), files.end());
+      roots.push_back(std::move(discover_path));
     }
   }
 
+  auto all_files = FindSystemVerilogFiles(workspace_root, roots, config);
   logger_->debug("Discovered {} SystemVerilog files", all_files.size());
 
   return all_files;
 }
 
-auto WorkspaceDiscoveryProvider::FindSystemVerilogFilesInDirectory(
-    const CanonicalPath& directory) const -> std::vector<CanonicalPath> {
-  std::vector<CanonicalPath> sv_files;
-
-  try {
-    std::filesystem::recursive_directory_iterator it(directory.Path());
-    for (const auto& entry : it) {
-      // Skip hidden directories
-      if (entry.is_directory()) {
-        auto dirname = entry.path().filename().string();
-
-        // Skip hidden directories (starting with '.')
-        if (!dirname.empty() && dirname[0] == '.') {
-          it.disable_recursion_pending();
-          continue;
-        }
-      }
-
-      // Collect SystemVerilog files
-      if (entry.is_regular_file() && IsSystemVerilogFile(entry.path())) {
-        sv_files.emplace_back(entry.path());  // CanonicalPath will normalize
-      }
-    }
-  } catch (const std::exception& e) {
-    logger_->error(
-        "WorkspaceDiscoveryProvider error discovering files in directory {}: "
-        "{}",
-        directory.String(), e.what());
-  }
-
-  return sv_files;
+auto WorkspaceDiscoveryProvider::FindSystemVerilogFiles(
+    const CanonicalPath& workspace_root,
+    const std::vector<CanonicalPath>& roots,
+    const SlangdConfigFile& config) const -> std::vector<CanonicalPath> {
+  const auto& root_str = workspace_root.String();
+
+  utils::DirectoryWalkOptions options{
+      .should_descend =
+          [&](const std::filesystem::path& directory) {
+            const auto& native = directory.native();
+            auto name = std::string_view(native).substr(
+                native.find_last_of('/') + 1);
+
+            // Skip hidden directories (starting with '.')
+            if (name.starts_with('.')) {
+              return false;
+            }
+
+            // Prune subtrees PathExclude would drop file by file anyway.
+            // Walked directories extend a canonical root, so the relative
+            // path is a plain string suffix (no filesystem::relative stat).
+            if (native.size() > root_str.size() + 1 &&
+                native.starts_with(root_str) &&
+                native[root_str.size()] == '/') {
+              auto relative =
+                  std::string_view(native).substr(root_str.size() + 1);
+              return !config.ExcludesDirectory(relative);
+            }
+            return true;
+          },
+      .should_collect =
+          [](std::string_view file_name) {
+            return IsSystemVerilogFile(file_name);
+          },
+      .num_threads = 0,
+  };
+
+  return utils::WalkDirectories(roots, options, logger_);
 }
 
 }  // namespace slangd
@@ -0,0 +1,227 @@
+#include "slangd/core/path_filter.hpp"
+
+#include <algorithm>
+
+namespace slangd {
+
+namespace {
+
+// Characters with a regex meaning outside of brackets
+constexpr std::string_view kSpecialChars = "^$.|?*+()[]{}\\";
+constexpr std::string_view kQuantifiers = "*+?{";
+
+auto MatchAt(std::string_view path, size_t pos, std::string_view segment)
+    -> bool {
+  for (size_t i = 0; i < segment.size(); ++i) {
+    if (segment[i] != '\0' && segment[i] != path[pos + i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Leftmost position in [from, to) where `segment` fits entirely
+auto FindSegment(
+    std::string_view path, size_t from, size_t to, std::string_view segment)
+    -> std::optional<size_t> {
+  if (to < from || to - from < segment.size()) {
+    return std::nullopt;
+  }
+  for (size_t pos = from; pos + segment.size() <= to; ++pos) {
+    if (MatchAt(path, pos, segment)) {
+      return pos;
+    }
+  }
+  return std::nullopt;
+}
+
+}  // namespace
+
+auto PathFilter::Compile(
+    const std::vector<std::string>& path_match,
+    const std::vector<std::string>& path_exclude,
+    std::shared_ptr<spdlog::logger> logger) -> PathFilter {
+  logger = logger ? logger : spdlog::default_logger();
+
+  PathFilter filter;
+  auto compile_all = [&](const std::vector<std::string>& patterns,
+                         std::vector<Pattern>& out) {
+    for (const auto& pattern : patterns) {
+      if (auto glob = ParseGlob(pattern)) {
+        out.push_back(Pattern{.glob = std::move(*glob), .regex = {}});
+        continue;
+      }
+      try {
+        out.push_back(
+            Pattern{
+                .glob = std::nullopt,
+                .regex = std::regex(
+                    pattern,
+                    std::regex::ECMAScript | std::regex::optimize)});
+      } catch (const std::regex_error& e) {
+        logger->warn(
+            "Invalid regex in path condition '{}' ({}), including all files",
+            pattern, e.what());
+        filter.fail_open_ = true;
+      }
+    }
+  };
+  compile_all(path_match, filter.match_);
+  compile_all(path_exclude, filter.exclude_);
+  return filter;
+}
+
+auto PathFilter::ShouldInclude(std::string_view relative_path) const -> bool {
+  if (fail_open_) {
+    return true;
+  }
+
+  // PathMatch: if specified, path must match at least ONE pattern (OR)
+  if (!match_.empty() &&
+      std::ranges::none_of(match_, [&](const Pattern& pattern) {
+        return pattern.Matches(relative_path);
+      })) {
+    return false;
+  }
+
+  // PathExclude: exclude if path matches ANY pattern (OR)
+  return std::ranges::none_of(exclude_, [&](const Pattern& pattern) {
+    return pattern.Matches(relative_path);
+  });
+}
+
+auto PathFilter::ExcludesDirectory(std::string_view relative_dir) const
+    -> bool {
+  if (fail_open_) {
+    return false;
+  }
+
+  // `A.*` matches every "dir/..." path when some prefix of "dir/" matches A
+  std::string dir_prefix(relative_dir);
+  dir_prefix += '/';
+  std::string_view dir_view(dir_prefix);
+  return std::ranges::any_of(exclude_, [&](const Pattern& pattern) {
+    if (!pattern.glob || pattern.glob->segments.size() < 2 ||
+        !pattern.glob->segments.back().empty()) {
+      return false;
+    }
+    Glob head{
+        .segments = {
+            pattern.glob->segments.begin(),
+            pattern.glob->segments.end() - 1}};
+    for (size_t length = 1; length <= dir_view.size(); ++length) {
+      if (MatchGlob(head, dir_view.substr(0, length))) {
+        return true;
+      }
+    }
+    return false;
+  });
+}
+
+auto PathFilter::RegexFallbackCount() const -> size_t {
+  auto is_regex = [](const Pattern& pattern) {
+    return pattern.regex.has_value();
+  };
+  return static_cast<size_t>(
+      std::ranges::count_if(match_, is_regex) +
+      std::ranges::count_if(exclude_, is_regex));
+}
+
+auto PathFilter::Pattern::Matches(std::string_view path) const -> bool {
+  if (glob) {
+    return MatchGlob(*glob, path);
+  }
+  return std::regex_match(path.begin(), path.end(), *regex);
+}
+
+auto PathFilter::ParseGlob(std::string_view pattern) -> std::optional<Glob> {
+  // Anchors are implied by whole-path matching
+  if (pattern.starts_with('^')) {
+    pattern.remove_prefix(1);
+  }
+
+  auto quantified = [&](size_t i) {
+    return i < pattern.size() && kQuantifiers.contains(pattern[i]);
+  };
+
+  Glob glob;
+  glob.segments.emplace_back();
+  size_t i = 0;
+  while (i < pattern.size()) {
+    char c = pattern[i];
+
+    if (c == '$' && i + 1 == pattern.size()) {
+      break;
+    }
+
+    if (c == '\\') {
+      // Escaped metacharacters are literals; classes like \d or \w are not
+      if (i + 1 >= pattern.size() || !kSpecialChars.contains(pattern[i + 1]) ||
+          quantified(i + 2)) {
+        return std::nullopt;
+      }
+      glob.segments.back() += pattern[i + 1];
+      i += 2;
+      continue;
+    }
+
+    if (c == '.') {
+      if (i + 1 < pattern.size() &&
+          (pattern[i + 1] == '*' || pattern[i + 1] == '+')) {
+        // `.+` is one any-char followed by `.*`
+        if (pattern[i + 1] == '+') {
+          glob.segments.back() += '\0';
+        }
+        glob.segments.emplace_back();
+        i += 2;
+        // Lazy `.*?` matches the same whole paths
+        if (i < pattern.size() && pattern[i] == '?') {
+          ++i;
+        }
+        continue;
+      }
+      if (quantified(i + 1)) {
+        return std::nullopt;
+      }
+      glob.segments.back() += '\0';
+      ++i;
+      continue;
+    }
+
+    if (kSpecialChars.contains(c) || quantified(i + 1)) {
+      return std::nullopt;
+    }
+    glob.segments.back() += c;
+    ++i;
+  }
+  return glob;
+}
+
+auto PathFilter::MatchGlob(const Glob& glob, std::string_view path) -> bool {
+  const auto& segments = glob.segments;
+  if (segments.size() == 1) {
+    return path.size() == segments[0].size() && MatchAt(path, 0, segments[0]);
+  }
+
+  // First segment anchors at the start, last at the end, and the middle
+  // ones are placed leftmost in between (optimal when only `.*` separates)
+  const auto& first = segments.front();
+  const auto& last = segments.back();
+  if (path.size() < first.size() + last.size() || !MatchAt(path, 0, first) ||
+      !MatchAt(path, path.size() - last.size(), last)) {
+    return false;
+  }
+
+  size_t pos = first.size();
+  size_t end = path.size() - last.size();
+  for (size_t i = 1; i + 1 < segments.size(); ++i) {
+    auto found = FindSegment(path, pos, end, segments[i]);
+    if (!found) {
+      return false;
+    }
+    pos = *found + segments[i].size();
+  }
+  return true;
+}
+
+}  // namespace slangd
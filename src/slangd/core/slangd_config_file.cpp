@@ -1,6 +1,5 @@
 #include "slangd/core/slangd_config_file.hpp"
 
-#include <regex>
 #include <yaml-cpp/yaml.h>
 
 #include <spdlog/spdlog.h>
@@ -124,6 +123,10 @@ auto SlangdConfigFile::LoadFromFile(
               config.path_condition_.path_exclude.size());
         }
       }
+
+      config.path_filter_ = PathFilter::Compile(
+          config.path_condition_.path_match,
+          config.path_condition_.path_exclude, config.logger_);
     }
 
     // Parse AutoDiscover section (supports both bool and object formats)
@@ -169,50 +172,7 @@ auto SlangdConfigFile::LoadFromFile(
 
 auto SlangdConfigFile::ShouldIncludeFile(std::string_view relative_path) const
     -> bool {
-  // No conditions specified -> include everything
-  if (path_condition_.path_match.empty() &&
-      path_condition_.path_exclude.empty()) {
-    return true;
-  }
-
-  // Convert to string for regex matching (relative_path is already normalized)
-  std::string path_str(relative_path);
-
-  try {
-    // Check PathMatch: if specified, path must match at least ONE pattern (OR)
-    if (!path_condition_.path_match.empty()) {
-      bool matches_any = false;
-      for (const auto& pattern : path_condition_.path_match) {
-        std::regex match_pattern(pattern);
-        if (std::regex_match(path_str, match_pattern)) {
-          matches_any = true;
-          break;  // Found a match, no need to check remaining patterns
-        }
-      }
-      if (!matches_any) {
-        return false;  // Doesn't match any PathMatch pattern -> exclude
-      }
-    }
-
-    // Check PathExclude: if specified and matches ANY pattern, exclude (OR)
-    if (!path_condition_.path_exclude.empty()) {
-      for (const auto& pattern : path_condition_.path_exclude) {
-        std::regex exclude_pattern(pattern);
-        if (std::regex_match(path_str, exclude_pattern)) {
-          return false;  // Matches a PathExclude pattern -> exclude
-        }
-      }
-    }
-
-    // Passed all conditions -> include
-    return true;
-
-  } catch (const std::regex_error& e) {
-    logger_->warn(
-        "Invalid regex in path condition ({}), including file by default: {}",
-        e.what(), relative_path);
-    return true;  // Fail open on regex error
-  }
+  return path_filter_.ShouldInclude(relative_path);
 }
 
 }  // namespace slangd
@@ -1,5 +1,10 @@
 #include "slangd/core/slangd_lsp_server.hpp"
 
+#include <filesystem>
+#include <optional>
+#include <string>
+
+#include <fmt/format.h>
 #include <lsp/registeration_options.hpp>
 #include <slang/syntax/AllSyntax.h>
 #include <slang/syntax/SyntaxVisitor.h>
@@ -7,7 +12,9 @@
 
 #include "lsp/document_features.hpp"
 #include "slangd/utils/canonical_path.hpp"
+#include "slangd/utils/metrics.hpp"
 #include "slangd/utils/path_utils.hpp"
+#include "slangd/utils/tracer.hpp"
 
 namespace slangd {
 
@@ -37,6 +44,77 @@ struct StatusParams {
   }
 };
 
+// Trace span and latency sample (lsp.<method>.latency_us) of one message
+class RequestScope {
+ public:
+  RequestScope(std::string_view method, uint64_t request_id)
+      : span_(std::string(method), "request", request_id),
+        latency_(
+            utils::Metrics::Instance().GetHistogram(
+                fmt::format("lsp.{}.latency_us", method))),
+        request_id_(request_id) {
+  }
+
+  // ID to pass on to work started for this message
+  [[nodiscard]] auto Id() const -> uint64_t {
+    return request_id_;
+  }
+
+ private:
+  utils::TraceSpan span_;
+  utils::LatencyTimer latency_;
+  uint64_t request_id_;
+};
+
+// $/slangd/stats request: snapshot of utils::Metrics (no params)
+struct StatsParams {
+  [[maybe_unused]] friend void to_json(
+      nlohmann::json& j, const StatsParams& /*p*/) {
+    j = nlohmann::json::object();
+  }
+
+  [[maybe_unused]] friend void from_json(
+      const nlohmann::json& /*j*/, StatsParams& /*p*/) {
+  }
+};
+
+// $/slangd/dumpTrace request: write buffered trace spans as Chrome trace JSON
+struct DumpTraceParams {
+  // Defaults to utils::Tracer::DefaultTracePath()
+  std::optional<std::string> path;
+
+  [[maybe_unused]] friend void to_json(
+      nlohmann::json& j, const DumpTraceParams& p) {
+    j = nlohmann::json::object();
+    if (p.path) {
+      j["path"] = *p.path;
+    }
+  }
+
+  [[maybe_unused]] friend void from_json(
+      const nlohmann::json& j, DumpTraceParams& p) {
+    if (j.is_object() && j.contains("path")) {
+      p.path = j.at("path").get<std::string>();
+    }
+  }
+};
+
+struct DumpTraceResult {
+  std::string path;
+  size_t spans = 0;
+
+  [[maybe_unused]] friend void to_json(
+      nlohmann::json& j, const DumpTraceResult& p) {
+    j = nlohmann::json{{"path", p.path}, {"spans", p.spans}};
+  }
+
+  [[maybe_unused]] friend void from_json(
+      const nlohmann::json& j, DumpTraceResult& p) {
+    j.at("path").get_to(p.path);
+    j.at("spans").get_to(p.spans);
+  }
+};
+
 }  // namespace
 
 SlangdLspServer::SlangdLspServer(
@@ -93,7 +171,7 @@ auto SlangdLspServer::OnInitialize(lsp::InitializeParams params)
 
   lsp::TextDocumentSyncOptions sync_options{
       .openClose = true,
-      .change = lsp::TextDocumentSyncKind::kFull,
+      .change = lsp::TextDocumentSyncKind::kIncremental,
   };
 
   lsp::ServerCapabilities::Workspace workspace{
@@ -106,7 +184,9 @@ auto SlangdLspServer::OnInitialize(lsp::InitializeParams params)
   lsp::ServerCapabilities capabilities{
       .textDocumentSync = sync_options,
       .definitionProvider = true,
+      .referencesProvider = true,
       .documentSymbolProvider = true,
+      .workspaceSymbolProvider = true,
       .workspace = workspace,
   };
 
@@ -188,11 +268,12 @@ auto SlangdLspServer::OnExit(lsp::ExitParams /*unused*/)
 auto SlangdLspServer::OnDidOpenTextDocument(
     lsp::DidOpenTextDocumentParams params)
     -> asio::awaitable<std::expected<void, lsp::LspError>> {
+  RequestScope scope("textDocument/didOpen", ++last_request_id_);
   const auto& text_doc = params.textDocument;
   Logger()->debug("OnDidOpenTextDocument received: {}", text_doc.uri);
 
   co_await language_service_->OnDocumentOpened(
-      text_doc.uri, text_doc.text, text_doc.version);
+      text_doc.uri, text_doc.text, text_doc.version, scope.Id());
 
   co_return Ok();
 }
@@ -200,13 +281,13 @@ auto SlangdLspServer::OnDidOpenTextDocument(
 auto SlangdLspServer::OnDidChangeTextDocument(
     lsp::DidChangeTextDocumentParams params)
     -> asio::awaitable<std::expected<void, lsp::LspError>> {
+  RequestScope scope("textDocument/didChange", ++last_request_id_);
   Logger()->debug(
       "OnDidChangeTextDocument received: {}", params.textDocument.uri);
   if (!params.contentChanges.empty()) {
-    const auto& full_change = std::get<lsp::TextDocumentContentFullChangeEvent>(
-        params.contentChanges[0]);
     co_await language_service_->OnDocumentChanged(
-        params.textDocument.uri, full_change.text, params.textDocument.version);
+        params.textDocument.uri, std::move(params.contentChanges),
+        params.textDocument.version, scope.Id());
   }
   co_return Ok();
 }
@@ -214,9 +295,11 @@ auto SlangdLspServer::OnDidChangeTextDocument(
 auto SlangdLspServer::OnDidSaveTextDocument(
     lsp::DidSaveTextDocumentParams params)
     -> asio::awaitable<std::expected<void, lsp::LspError>> {
+  RequestScope scope("textDocument/didSave", ++last_request_id_);
   Logger()->debug(
       "OnDidSaveTextDocument received: {}", params.textDocument.uri);
-  co_await language_service_->OnDocumentSaved(params.textDocument.uri);
+  co_await language_service_->OnDocumentSaved(
+      params.textDocument.uri, scope.Id());
   co_return Ok();
 }
 
@@ -232,6 +315,7 @@ auto SlangdLspServer::OnDidCloseTextDocument(
 auto SlangdLspServer::OnDocumentSymbols(lsp::DocumentSymbolParams params)
     -> asio::awaitable<
         std::expected<lsp::DocumentSymbolResult, lsp::LspError>> {
+  RequestScope scope("textDocument/documentSymbol", ++last_request_id_);
   Logger()->debug("OnDocumentSymbols received: {}", params.textDocument.uri);
   co_return co_await language_service_->GetDocumentSymbols(
       params.textDocument.uri);
@@ -239,11 +323,29 @@ auto SlangdLspServer::OnDocumentSymbols(lsp::DocumentSymbolParams params)
 
 auto SlangdLspServer::OnGotoDefinition(lsp::DefinitionParams params)
     -> asio::awaitable<std::expected<lsp::DefinitionResult, lsp::LspError>> {
+  RequestScope scope("textDocument/definition", ++last_request_id_);
   Logger()->debug("OnGotoDefinition received: {}", params.textDocument.uri);
   co_return co_await language_service_->GetDefinitionsForPosition(
       params.textDocument.uri, params.position);
 }
 
+auto SlangdLspServer::OnReferences(lsp::ReferenceParams params)
+    -> asio::awaitable<std::expected<lsp::ReferenceResult, lsp::LspError>> {
+  RequestScope scope("textDocument/references", ++last_request_id_);
+  Logger()->debug("OnReferences received: {}", params.textDocument.uri);
+  co_return co_await language_service_->GetReferences(
+      params.textDocument.uri, params.position,
+      params.context.includeDeclaration);
+}
+
+auto SlangdLspServer::OnWorkspaceSymbols(lsp::WorkspaceSymbolParams params)
+    -> asio::awaitable<
+        std::expected<lsp::WorkspaceSymbolResult, lsp::LspError>> {
+  RequestScope scope("workspace/symbol", ++last_request_id_);
+  Logger()->debug("OnWorkspaceSymbols received: '{}'", params.query);
+  co_return co_await language_service_->GetWorkspaceSymbols(params.query);
+}
+
 auto SlangdLspServer::OnDidChangeWatchedFiles(
     lsp::DidChangeWatchedFilesParams params)
     -> asio::awaitable<std::expected<void, lsp::LspError>> {
@@ -284,6 +386,30 @@ auto SlangdLspServer::OnDidChangeWatchedFiles(
   co_return Ok();
 }
 
+auto SlangdLspServer::RegisterExtensionHandlers() -> void {
+  RegisterCustomMethodCall<StatsParams, nlohmann::json>(
+      "$/slangd/stats",
+      [](const StatsParams& /*params*/)
+          -> asio::awaitable<std::expected<nlohmann::json, LspError>> {
+        co_return utils::Metrics::Instance().ExportJson();
+      });
+
+  RegisterCustomMethodCall<DumpTraceParams, DumpTraceResult>(
+      "$/slangd/dumpTrace",
+      [this](const DumpTraceParams& params)
+          -> asio::awaitable<std::expected<DumpTraceResult, LspError>> {
+        auto path = params.path ? std::filesystem::path(*params.path)
+                                : utils::Tracer::DefaultTracePath();
+        auto result = utils::Tracer::Instance().WriteChromeTrace(path);
+        if (!result) {
+          co_return LspError::UnexpectedFromCode(
+              LspErrorCode::kInternalError, result.error());
+        }
+        Logger()->info("Wrote {} trace spans to {}", *result, path.string());
+        co_return DumpTraceResult{.path = path.string(), .spans = *result};
+      });
+}
+
 auto SlangdLspServer::IsConfigFile(const std::string& path) -> bool {
   return path.ends_with("/.slangd") || path.ends_with("\\.slangd");
 }
@@ -60,7 +60,7 @@ IndexVisitor::IndexVisitor(
 void IndexVisitor::AddEntry(SemanticEntry entry) {
   // INVARIANT: All entries have source locations in current_file_uri_
   // This is guaranteed by:
-  // 1. IsInCurrentFile() checks at module/package level before traversal
+  // 1. CurrentFileFilter checks at module/package level before traversal
   // 2. All Add* methods populate source_range from symbols in current file
   //
   // No additional filtering needed - preamble symbols have source in current
@@ -71,18 +71,16 @@ void IndexVisitor::AddEntry(SemanticEntry entry) {
 
 void IndexVisitor::AddDefinition(
     const slang::ast::Symbol& symbol, std::string_view name,
-    lsp::Location def_loc, const slang::ast::Scope* parent_scope,
-    const slang::ast::Scope* children_scope) {
+    lsp::Location def_loc) {
   const auto& unwrapped = UnwrapSymbol(symbol);
 
+  auto& index = index_.get();
   auto entry = SemanticEntry{
       .ref_range = def_loc.range,
-      .def_loc = def_loc,
-      .symbol = &unwrapped,
+      .def_range = def_loc.range,
+      .def_uri = index.strings_.Intern(def_loc.uri),
+      .name = index.strings_.Intern(name),
       .lsp_kind = ConvertToLspKind(unwrapped),
-      .name = std::string(name),
-      .parent = parent_scope,
-      .children_scope = children_scope,
       .is_definition = true};
 
   AddEntry(std::move(entry));
@@ -90,8 +88,7 @@ void IndexVisitor::AddDefinition(
 
 void IndexVisitor::AddReference(
     const slang::ast::Symbol& symbol, std::string_view name,
-    slang::SourceRange ref_range, lsp::Location def_loc,
-    const slang::ast::Scope* parent_scope) {
+    slang::SourceRange ref_range, lsp::Location def_loc) {
   // Filter out references from other files (e.g., preamble default arguments)
   // CRITICAL: Default argument expressions belong to preamble compilation
   // and have BufferIDs from preamble files, not the overlay file.
@@ -111,14 +108,13 @@ void IndexVisitor::AddReference(
   // TODO: Replace with unified SourceManager decoder for cleaner abstraction.
   auto ref_loc = ToLspRange(ref_range, index_.get().GetSourceManager());
 
+  auto& index = index_.get();
   auto entry = SemanticEntry{
       .ref_range = ref_loc,
-      .def_loc = def_loc,
-      .symbol = &unwrapped,
+      .def_range = def_loc.range,
+      .def_uri = index.strings_.Intern(def_loc.uri),
+      .name = index.strings_.Intern(name),
       .lsp_kind = ConvertToLspKind(unwrapped),
-      .name = std::string(name),
-      .parent = parent_scope,
-      .children_scope = nullptr,
       .is_definition = false};
 
   AddEntry(std::move(entry));
@@ -126,20 +122,18 @@ void IndexVisitor::AddReference(
 
 void IndexVisitor::AddReferenceWithLspDefinition(
     const slang::ast::Symbol& symbol, std::string_view name,
-    lsp::Range ref_range, lsp::Location def_loc,
-    const slang::ast::Scope* parent_scope) {
+    lsp::Range ref_range, lsp::Location def_loc) {
   // For module/port/parameter references where PreambleManager provides
   // pre-converted LSP definition coordinates
   const auto& unwrapped = UnwrapSymbol(symbol);
 
+  auto& index = index_.get();
   auto entry = SemanticEntry{
       .ref_range = ref_range,
-      .def_loc = def_loc,
-      .symbol = &unwrapped,
+      .def_range = def_loc.range,
+      .def_uri = index.strings_.Intern(def_loc.uri),
+      .name = index.strings_.Intern(name),
       .lsp_kind = ConvertToLspKind(unwrapped),
-      .name = std::string(name),
-      .parent = parent_scope,
-      .children_scope = nullptr,
       .is_definition = false};
 
   AddEntry(std::move(entry));
@@ -224,7 +218,7 @@ void IndexVisitor::TraverseType(const slang::ast::Type& type) {
 
           AddReference(
               *typedef_target, typedef_target->name, usage_range,
-              *definition_loc, typedef_target->getParentScope());
+              *definition_loc);
         }
       } else if (
           const auto* class_target =
@@ -271,8 +265,7 @@ void IndexVisitor::TraverseType(const slang::ast::Type& type) {
           }
 
           AddReference(
-              *class_target, class_target->name, usage_range, *definition_loc,
-              class_target->getParentScope());
+              *class_target, class_target->name, usage_range, *definition_loc);
         }
       }
       break;
@@ -378,8 +371,7 @@ void IndexVisitor::TraverseClassNames(
     if (def_loc) {
       AddReference(
           *class_type.genericClass, class_type.genericClass->name,
-          class_name.identifier.range(), *def_loc,
-          class_type.genericClass->getParentScope());
+          class_name.identifier.range(), *def_loc);
     }
 
     // Index parameter names in specialization
@@ -447,7 +439,7 @@ void IndexVisitor::IndexClassParameters(
       if (param_def_loc) {
         AddReference(
             param_symbol, param_symbol.name, named_param.name.range(),
-            *param_def_loc, param_symbol.getParentScope());
+            *param_def_loc);
       }
       break;
     }
@@ -497,7 +489,7 @@ void IndexVisitor::IndexInstanceParameters(
         if (param_def_loc) {
           AddReference(
               param_symbol, param_symbol.name, named_param.name.range(),
-              *param_def_loc, param_symbol.getParentScope());
+              *param_def_loc);
         }
         break;
       }
@@ -540,7 +532,7 @@ void IndexVisitor::IndexInstancePorts(
         if (port_def_loc) {
           AddReference(
               port_symbol, port_symbol.name, named_port.name.range(),
-              *port_def_loc, port_symbol.getParentScope());
+              *port_def_loc);
         }
         break;
       }
@@ -580,9 +572,7 @@ void IndexVisitor::IndexPackageInScopedName(
 
       // Derive SM from syntax_owner's compilation
       if (pkg_def_loc) {
-        AddReference(
-            pkg, pkg.name, ident.identifier.range(), *pkg_def_loc,
-            pkg.getParentScope());
+        AddReference(pkg, pkg.name, ident.identifier.range(), *pkg_def_loc);
       }
       break;  // Found package, stop searching
     }
@@ -716,9 +706,7 @@ void IndexVisitor::handle(const NamedValueExpression& expr) {
   auto def_loc = CreateLspLocation(*target_symbol, *def_range, logger_);
 
   if (def_loc) {
-    AddReference(
-        *target_symbol, target_symbol->name, *ref_range, *def_loc,
-        target_symbol->getParentScope());
+    AddReference(*target_symbol, target_symbol->name, *ref_range, *def_loc);
   }
 
   this->visitDefault(expr);
@@ -735,8 +723,7 @@ void IndexVisitor::handle(const ArbitrarySymbolExpression& expr) {
   if (target_symbol->location.valid()) {
     if (auto def_loc = CreateSymbolLocation(*target_symbol, logger_)) {
       AddReference(
-          *target_symbol, target_symbol->name, expr.sourceRange, *def_loc,
-          target_symbol->getParentScope());
+          *target_symbol, target_symbol->name, expr.sourceRange, *def_loc);
     }
   }
 
@@ -885,8 +872,7 @@ void IndexVisitor::handle(const CallExpression& expr) {
           if (def_loc) {
             AddReference(
                 *def_symbol, class_ident.identifier.valueText(),
-                class_ident.identifier.range(), *def_loc,
-                def_symbol->getParentScope());
+                class_ident.identifier.range(), *def_loc);
           }
         }
       }
@@ -921,8 +907,7 @@ void IndexVisitor::handle(const CallExpression& expr) {
 
   if (def_loc) {
     AddReference(
-        **subroutine_symbol, (*subroutine_symbol)->name, *call_range, *def_loc,
-        (*subroutine_symbol)->getParentScope());
+        **subroutine_symbol, (*subroutine_symbol)->name, *call_range, *def_loc);
   }
 
   this->visitDefault(expr);
@@ -956,8 +941,7 @@ void IndexVisitor::handle(const MemberAccessExpression& expr) {
 
   if (definition_loc) {
     AddReference(
-        expr.member, expr.member.name, expr.memberNameRange(), *definition_loc,
-        expr.member.getParentScope());
+        expr.member, expr.member.name, expr.memberNameRange(), *definition_loc);
   }
 
   this->visitDefault(expr);
@@ -991,9 +975,7 @@ void IndexVisitor::handle(const HierarchicalValueExpression& expr) {
     if (!is_array_element && elem.sourceRange.start().valid()) {
       auto definition_loc = CreateSymbolLocation(*symbol, logger_);
       if (definition_loc) {
-        AddReference(
-            *symbol, symbol->name, elem.sourceRange, *definition_loc,
-            symbol->getParentScope());
+        AddReference(*symbol, symbol->name, elem.sourceRange, *definition_loc);
       }
     }
   }
@@ -1045,8 +1027,7 @@ void IndexVisitor::handle(const StructuredAssignmentPatternExpression& expr) {
     auto definition_loc = CreateSymbolLocation(member_symbol, logger_);
     if (definition_loc) {
       AddReference(
-          member_symbol, member_symbol.name, setter.keyRange, *definition_loc,
-          member_symbol.getParentScope());
+          member_symbol, member_symbol.name, setter.keyRange, *definition_loc);
     }
   }
 
@@ -1059,8 +1040,7 @@ void IndexVisitor::handle(const FormalArgumentSymbol& formal_arg) {
 
   auto def_loc = CreateSymbolLocation(formal_arg, logger_);
   if (def_loc) {
-    AddDefinition(
-        formal_arg, formal_arg.name, *def_loc, formal_arg.getParentScope());
+    AddDefinition(formal_arg, formal_arg.name, *def_loc);
   }
 
   // Traverse the type to index type references in argument declarations
@@ -1085,7 +1065,7 @@ void IndexVisitor::handle(const VariableSymbol& symbol) {
 
   auto def_loc = CreateSymbolLocation(symbol, logger_);
   if (def_loc) {
-    AddDefinition(symbol, symbol.name, *def_loc, symbol.getParentScope());
+    AddDefinition(symbol, symbol.name, *def_loc);
   }
 
   TraverseType(symbol.getType());
@@ -1117,8 +1097,7 @@ void IndexVisitor::handle(const WildcardImportSymbol& import_symbol) {
   auto definition_loc = CreateSymbolLocation(*package, logger_);
   if (definition_loc) {
     AddReference(
-        *package, package->name, import_item.package.range(), *definition_loc,
-        package->getParentScope());
+        *package, package->name, import_item.package.range(), *definition_loc);
   }
   this->visitDefault(import_symbol);
 }
@@ -1143,8 +1122,7 @@ void IndexVisitor::handle(const ExplicitImportSymbol& import_symbol) {
   auto definition_loc = CreateSymbolLocation(*package, logger_);
   if (definition_loc) {
     AddReference(
-        *package, package->name, import_item.package.range(), *definition_loc,
-        package->getParentScope());
+        *package, package->name, import_item.package.range(), *definition_loc);
   }
 
   // Create entry for the imported symbol name
@@ -1155,7 +1133,7 @@ void IndexVisitor::handle(const ExplicitImportSymbol& import_symbol) {
     if (imported_definition_loc) {
       AddReference(
           *imported_symbol, imported_symbol->name, import_item.item.range(),
-          *imported_definition_loc, imported_symbol->getParentScope());
+          *imported_definition_loc);
     }
   }
 
@@ -1168,7 +1146,7 @@ void IndexVisitor::handle(const ParameterSymbol& param) {
   if (!param.isFromGenvar()) {
     auto def_loc = CreateSymbolLocation(param, logger_);
     if (def_loc) {
-      AddDefinition(param, param.name, *def_loc, param.getParentScope());
+      AddDefinition(param, param.name, *def_loc);
     }
   }
 
@@ -1179,8 +1157,7 @@ void IndexVisitor::handle(const ParameterSymbol& param) {
 void IndexVisitor::handle(const SubroutineSymbol& subroutine) {
   auto def_loc = CreateSymbolLocation(subroutine, logger_);
   if (def_loc) {
-    AddDefinition(
-        subroutine, subroutine.name, *def_loc, subroutine.getParentScope());
+    AddDefinition(subroutine, subroutine.name, *def_loc);
 
     // Add reference for end label (e.g., "endfunction : my_func")
     if (const auto* syntax = subroutine.getSyntax()) {
@@ -1191,8 +1168,7 @@ void IndexVisitor::handle(const SubroutineSymbol& subroutine) {
         if (func_syntax.endBlockName != nullptr) {
           AddReference(
               subroutine, subroutine.name,
-              func_syntax.endBlockName->name.range(), *def_loc,
-              subroutine.getParentScope());
+              func_syntax.endBlockName->name.range(), *def_loc);
         }
       }
     }
@@ -1203,9 +1179,7 @@ void IndexVisitor::handle(const SubroutineSymbol& subroutine) {
 void IndexVisitor::handle(const MethodPrototypeSymbol& method_prototype) {
   auto def_loc = CreateSymbolLocation(method_prototype, logger_);
   if (def_loc) {
-    AddDefinition(
-        method_prototype, method_prototype.name, *def_loc,
-        method_prototype.getParentScope());
+    AddDefinition(method_prototype, method_prototype.name, *def_loc);
   }
 
   // Traverse return type and arguments for type references
@@ -1228,16 +1202,13 @@ void IndexVisitor::handle(const DefinitionSymbol& definition) {
 
         if (auto def_loc = CreateLspLocation(
                 definition, decl_syntax.header->name.range(), logger_)) {
-          AddDefinition(
-              definition, definition.name, *def_loc,
-              definition.getParentScope());
+          AddDefinition(definition, definition.name, *def_loc);
 
           // Add reference for end label (e.g., "endmodule : Test")
           if (decl_syntax.blockName != nullptr) {
             AddReference(
                 definition, definition.name,
-                decl_syntax.blockName->name.range(), *def_loc,
-                definition.getParentScope());
+                decl_syntax.blockName->name.range(), *def_loc);
           }
         }
       }
@@ -1255,8 +1226,7 @@ void IndexVisitor::handle(const DefinitionSymbol& definition) {
 void IndexVisitor::handle(const TypeAliasType& type_alias) {
   auto def_loc = CreateSymbolLocation(type_alias, logger_);
   if (def_loc) {
-    AddDefinition(
-        type_alias, type_alias.name, *def_loc, type_alias.getParentScope());
+    AddDefinition(type_alias, type_alias.name, *def_loc);
   }
 
   // Need to traverse the target type for cases like: typedef data_from_t
@@ -1268,8 +1238,7 @@ void IndexVisitor::handle(const TypeAliasType& type_alias) {
 void IndexVisitor::handle(const EnumValueSymbol& enum_value) {
   auto def_loc = CreateSymbolLocation(enum_value, logger_);
   if (def_loc) {
-    AddDefinition(
-        enum_value, enum_value.name, *def_loc, enum_value.getParentScope());
+    AddDefinition(enum_value, enum_value.name, *def_loc);
   }
   this->visitDefault(enum_value);
 }
@@ -1277,7 +1246,7 @@ void IndexVisitor::handle(const EnumValueSymbol& enum_value) {
 void IndexVisitor::handle(const FieldSymbol& field) {
   auto def_loc = CreateSymbolLocation(field, logger_);
   if (def_loc) {
-    AddDefinition(field, field.name, *def_loc, field.getParentScope());
+    AddDefinition(field, field.name, *def_loc);
   }
 
   TraverseType(field.getType());
@@ -1287,7 +1256,7 @@ void IndexVisitor::handle(const FieldSymbol& field) {
 void IndexVisitor::handle(const NetSymbol& net) {
   auto def_loc = CreateSymbolLocation(net, logger_);
   if (def_loc) {
-    AddDefinition(net, net.name, *def_loc, net.getParentScope());
+    AddDefinition(net, net.name, *def_loc);
   }
 
   TraverseType(net.getType());
@@ -1297,9 +1266,7 @@ void IndexVisitor::handle(const NetSymbol& net) {
 void IndexVisitor::handle(const ClassPropertySymbol& class_property) {
   auto def_loc = CreateSymbolLocation(class_property, logger_);
   if (def_loc) {
-    AddDefinition(
-        class_property, class_property.name, *def_loc,
-        class_property.getParentScope());
+    AddDefinition(class_property, class_property.name, *def_loc);
   }
 
   TraverseType(class_property.getType());
@@ -1310,29 +1277,9 @@ void IndexVisitor::handle(const GenericClassDefSymbol& class_def) {
   // Parameterized classes: class C #(parameter P);
   // Slang creates GenericClassDefSymbol as the definition symbol
   if (class_def.location.valid()) {
-    // CRITICAL: GenericClassDefSymbol does NOT expose class body as children
-    // (similar to ModuleSymbol vs InstanceSymbol pattern).
-    // We must get a ClassType specialization to access parameters and members.
-    // Use getDefaultSpecialization() to create a temporary instance with
-    // default parameter values.
-    const slang::ast::Scope* class_type_scope = nullptr;
-    if (const auto* parent_scope = class_def.getParentScope()) {
-      if (const auto* default_type =
-              class_def.getDefaultSpecialization(*parent_scope)) {
-        if (default_type->isClass()) {
-          const auto& class_type =
-              default_type->getCanonicalType().as<slang::ast::ClassType>();
-          class_type_scope = &class_type.as<slang::ast::Scope>();
-        }
-      }
-    }
-
-    // Add GenericClassDef definition with ClassType scope as children_scope
     auto def_loc = CreateSymbolLocation(class_def, logger_);
     if (def_loc) {
-      AddDefinition(
-          class_def, class_def.name, *def_loc, class_def.getParentScope(),
-          class_type_scope);
+      AddDefinition(class_def, class_def.name, *def_loc);
 
       // Add reference for end label (e.g., "endclass : MyClass")
       if (const auto* syntax = class_def.getSyntax()) {
@@ -1342,8 +1289,7 @@ void IndexVisitor::handle(const GenericClassDefSymbol& class_def) {
           if (class_syntax.endBlockName != nullptr) {
             AddReference(
                 class_def, class_def.name,
-                class_syntax.endBlockName->name.range(), *def_loc,
-                class_def.getParentScope());
+                class_syntax.endBlockName->name.range(), *def_loc);
           }
         }
       }
@@ -1383,7 +1329,7 @@ void IndexVisitor::handle(const GenericClassDefSymbol& class_def) {
                     if (base_def_loc) {
                       AddReference(
                           *base_symbol, base_symbol->name, base_ref_range,
-                          *base_def_loc, base_symbol->getParentScope());
+                          *base_def_loc);
                     }
                   }
                 }
@@ -1425,8 +1371,7 @@ void IndexVisitor::handle(const ClassType& class_type) {
   if (class_type.genericClass == nullptr) {
     auto def_loc = CreateSymbolLocation(class_type, logger_);
     if (def_loc) {
-      AddDefinition(
-          class_type, class_type.name, *def_loc, class_type.getParentScope());
+      AddDefinition(class_type, class_type.name, *def_loc);
 
       // Add reference for end label (e.g., "endclass : MyClass")
       if (const auto* syntax = class_type.getSyntax()) {
@@ -1436,8 +1381,7 @@ void IndexVisitor::handle(const ClassType& class_type) {
           if (class_syntax.endBlockName != nullptr) {
             AddReference(
                 class_type, class_type.name,
-                class_syntax.endBlockName->name.range(), *def_loc,
-                class_type.getParentScope());
+                class_syntax.endBlockName->name.range(), *def_loc);
           }
         }
       }
@@ -1464,7 +1408,7 @@ void IndexVisitor::handle(const ClassType& class_type) {
             if (base_definition_loc) {
               AddReference(
                   *base_symbol, base_symbol->name, base_ref_range,
-                  *base_definition_loc, base_symbol->getParentScope());
+                  *base_definition_loc);
             }
           }
         }
@@ -1491,9 +1435,7 @@ void IndexVisitor::handle(const ClassType& class_type) {
 void IndexVisitor::handle(const InterfacePortSymbol& interface_port) {
   auto def_loc = CreateSymbolLocation(interface_port, logger_);
   if (def_loc) {
-    AddDefinition(
-        interface_port, interface_port.name, *def_loc,
-        interface_port.getParentScope());
+    AddDefinition(interface_port, interface_port.name, *def_loc);
 
     // Index references in dimension expressions (e.g., inputs[NUM_INPUTS])
     auto dimensions = interface_port.getDimensions();
@@ -1516,8 +1458,7 @@ void IndexVisitor::handle(const InterfacePortSymbol& interface_port) {
         if (interface_definition_loc) {
           AddReference(
               *interface_port.interfaceDef, interface_port.interfaceDef->name,
-              interface_name_range, *interface_definition_loc,
-              interface_port.interfaceDef->getParentScope());
+              interface_name_range, *interface_definition_loc);
         }
       }
     }
@@ -1547,8 +1488,7 @@ void IndexVisitor::handle(const InterfacePortSymbol& interface_port) {
         if (modport_definition_loc) {
           AddReference(
               *interface_port.modportSymbol, interface_port.modportSymbol->name,
-              modport_name_range, *modport_definition_loc,
-              interface_port.modportSymbol->getParentScope());
+              modport_name_range, *modport_definition_loc);
         }
       }
     }
@@ -1560,7 +1500,7 @@ void IndexVisitor::handle(const ModportSymbol& modport) {
   if (modport.location.valid()) {
     auto def_loc = CreateSymbolLocation(modport, logger_);
     if (def_loc) {
-      AddDefinition(modport, modport.name, *def_loc, modport.getParentScope());
+      AddDefinition(modport, modport.name, *def_loc);
     }
   }
   this->visitDefault(modport);
@@ -1582,7 +1522,7 @@ void IndexVisitor::handle(const ModportPortSymbol& modport_port) {
           if (target_loc) {
             AddReference(
                 *modport_port.internalSymbol, modport_port.name, source_range,
-                *target_loc, modport_port.getParentScope());
+                *target_loc);
           }
         }
       }
@@ -1624,9 +1564,7 @@ void IndexVisitor::handle(const InstanceArraySymbol& instance_array) {
     // 1. Create self-definition for array name
     auto def_loc = CreateSymbolLocation(instance_array, logger_);
     if (def_loc) {
-      AddDefinition(
-          instance_array, instance_array.name, *def_loc,
-          instance_array.getParentScope());
+      AddDefinition(instance_array, instance_array.name, *def_loc);
     }
 
     // 2. Create reference from type name to definition (module or interface)
@@ -1649,7 +1587,7 @@ void IndexVisitor::handle(const InstanceArraySymbol& instance_array) {
           if (definition_loc) {
             AddReference(
                 definition, definition.name, inst_syntax.type.range(),
-                *definition_loc, definition.getParentScope());
+                *definition_loc);
           }
 
           // 3. Index parameter overrides (e.g., #(.FLAG(1)))
@@ -1687,8 +1625,7 @@ void IndexVisitor::handle(const InstanceSymbol& instance) {
     // 1. Create self-definition for instance name
     auto def_loc = CreateSymbolLocation(instance, logger_);
     if (def_loc) {
-      AddDefinition(
-          instance, instance.name, *def_loc, instance.getParentScope());
+      AddDefinition(instance, instance.name, *def_loc);
     }
 
     // 2. Create reference from type name to module/interface definition
@@ -1704,8 +1641,7 @@ void IndexVisitor::handle(const InstanceSymbol& instance) {
       auto def_loc = CreateSymbolLocation(definition, logger_);
       if (def_loc) {
         AddReference(
-            definition, definition.name, inst_syntax.type.range(), *def_loc,
-            definition.getParentScope());
+            definition, definition.name, inst_syntax.type.range(), *def_loc);
       }
 
       // 3. Index parameter overrides (e.g., #(.FLAG(1)))
@@ -1782,7 +1718,7 @@ void IndexVisitor::handle(const GenerateBlockArraySymbol& generate_array) {
     if (definition_loc) {
       AddReference(
           *generate_array.genvar, generate_array.genvar->name, ref_range,
-          *definition_loc, generate_array.genvar->getParentScope());
+          *definition_loc);
     }
   }
 
@@ -1822,25 +1758,15 @@ void IndexVisitor::handle(const GenerateBlockSymbol& generate_block) {
 
           if (auto def_loc = CreateLspLocation(
                   generate_block, gen_block.beginName->name.range(), logger_)) {
-            // Skip GenerateBlockArray parent since it's not indexed in document
-            // symbols
-            const slang::ast::Scope* parent_scope =
-                generate_block.getParentScope();
-            if (parent_scope != nullptr &&
-                parent_scope->asSymbol().kind ==
-                    slang::ast::SymbolKind::GenerateBlockArray) {
-              parent_scope = parent_scope->asSymbol().getParentScope();
-            }
-
             // Use name from syntax, not symbol (symbol.name may be empty for
             // generate blocks)
-            AddDefinition(generate_block, block_name, *def_loc, parent_scope);
+            AddDefinition(generate_block, block_name, *def_loc);
 
             // Add reference for end label (e.g., "end : gen_loop")
             if (gen_block.endName != nullptr) {
               AddReference(
                   generate_block, block_name, gen_block.endName->name.range(),
-                  *def_loc, parent_scope);
+                  *def_loc);
             }
           }
         }
@@ -1877,14 +1803,14 @@ void IndexVisitor::handle(const GenerateBlockSymbol& generate_block) {
 void IndexVisitor::handle(const GenvarSymbol& genvar) {
   auto def_loc = CreateSymbolLocation(genvar, logger_);
   if (def_loc) {
-    AddDefinition(genvar, genvar.name, *def_loc, genvar.getParentScope());
+    AddDefinition(genvar, genvar.name, *def_loc);
   }
 }
 
 void IndexVisitor::handle(const PackageSymbol& package) {
   auto def_loc = CreateSymbolLocation(package, logger_);
   if (def_loc) {
-    AddDefinition(package, package.name, *def_loc, package.getParentScope());
+    AddDefinition(package, package.name, *def_loc);
 
     // Add reference for end label (e.g., "endpackage : TestPkg")
     if (const auto* syntax = package.getSyntax()) {
@@ -1894,7 +1820,7 @@ void IndexVisitor::handle(const PackageSymbol& package) {
         if (decl_syntax.blockName != nullptr) {
           AddReference(
               package, package.name, decl_syntax.blockName->name.range(),
-              *def_loc, package.getParentScope());
+              *def_loc);
         }
       }
     }
@@ -1908,9 +1834,7 @@ void IndexVisitor::handle(const StatementBlockSymbol& statement_block) {
   if (!statement_block.name.empty()) {
     auto def_loc = CreateSymbolLocation(statement_block, logger_);
     if (def_loc) {
-      AddDefinition(
-          statement_block, statement_block.name, *def_loc,
-          statement_block.getParentScope());
+      AddDefinition(statement_block, statement_block.name, *def_loc);
     }
   }
   this->visitDefault(statement_block);
@@ -1927,7 +1851,7 @@ void IndexVisitor::handle(const UninstantiatedDefSymbol& symbol) {
   if (syntax->kind == slang::syntax::SyntaxKind::HierarchicalInstance) {
     auto def_loc = CreateSymbolLocation(symbol, logger_);
     if (def_loc) {
-      AddDefinition(symbol, symbol.name, *def_loc, symbol.getParentScope());
+      AddDefinition(symbol, symbol.name, *def_loc);
     }
   }
 
@@ -1976,7 +1900,7 @@ void IndexVisitor::handle(const UninstantiatedDefSymbol& symbol) {
                 // Create reference using the expression's source range
                 AddReference(
                     instance_symbol, instance_symbol.name, expr.sourceRange,
-                    *definition_loc, instance_symbol.getParentScope());
+                    *definition_loc);
               }
             }
           } else if (ref_symbol.kind == slang::ast::SymbolKind::InstanceArray) {
@@ -1996,7 +1920,7 @@ void IndexVisitor::handle(const UninstantiatedDefSymbol& symbol) {
                   // Create reference using the expression's source range
                   AddReference(
                       instance_array, instance_array.name, expr.sourceRange,
-                      *definition_loc, instance_array.getParentScope());
+                      *definition_loc);
                 }
               }
             }
@@ -2008,7 +1932,7 @@ void IndexVisitor::handle(const UninstantiatedDefSymbol& symbol) {
               // Create reference using the expression's source range
               AddReference(
                   iface_port, iface_port.name, expr.sourceRange,
-                  *definition_loc, iface_port.getParentScope());
+                  *definition_loc);
             }
           }
         }
@@ -2033,9 +1957,7 @@ void IndexVisitor::handle(const UninstantiatedDefSymbol& symbol) {
       // Create reference from module/interface type name to definition
       auto def_loc = CreateSymbolLocation(*definition, logger_);
       if (def_loc) {
-        AddReference(
-            *definition, symbol.definitionName, type_range, *def_loc,
-            symbol.getParentScope());
+        AddReference(*definition, symbol.definitionName, type_range, *def_loc);
       }
 
       // Index parameter assignments (e.g., #(.WIDTH(32), .DEPTH(64)))
@@ -2072,10 +1994,9 @@ void IndexVisitor::handle(const UninstantiatedDefSymbol& symbol) {
                   CreateLspLocation(*definition, param_range, logger_);
 
               if (param_def_loc) {
-                const auto* parent_scope = definition->getParentScope();
                 AddReference(
                     *definition, param_decl.name, named_param.name.range(),
-                    *param_def_loc, parent_scope);
+                    *param_def_loc);
               }
               break;
             }
@@ -2125,10 +2046,9 @@ void IndexVisitor::handle(const UninstantiatedDefSymbol& symbol) {
                     CreateLspLocation(*definition, port_range, logger_);
 
                 if (port_def_loc) {
-                  const auto* parent_scope = definition->getParentScope();
-                  AddReference(
+                    AddReference(
                       *definition, port_name, named_port.name.range(),
-                      *port_def_loc, parent_scope);
+                      *port_def_loc);
                 }
                 break;
               }
@@ -1,5 +1,6 @@
 #include "slangd/semantic/semantic_index.hpp"
 
+#include <chrono>
 #include <set>
 
 #include <fmt/format.h>
@@ -30,43 +31,51 @@
 #include "slangd/semantic/index_visitor.hpp"
 #include "slangd/services/preamble_manager.hpp"
 #include "slangd/utils/conversion.hpp"
+#include "slangd/utils/metrics.hpp"
 #include "slangd/utils/path_utils.hpp"
 #include "slangd/utils/scoped_timer.hpp"
 
 namespace slangd::semantic {
 
-auto SemanticIndex::IsInCurrentFile(
-    const slang::ast::Symbol& symbol, const std::string& current_file_uri,
+SemanticIndex::CurrentFileFilter::CurrentFileFilter(
     const slang::SourceManager& source_manager,
-    const services::PreambleManager* preamble_manager) -> bool {
+    const std::string& current_file_uri, slang::BufferID current_file_buffer,
+    const services::PreambleManager* preamble_manager)
+    : source_manager_(source_manager),
+      normalized_uri_(NormalizeUri(current_file_uri)) {
   if (preamble_manager != nullptr) {
-    const auto* symbol_scope = symbol.getParentScope();
-    if (symbol_scope != nullptr) {
-      const auto& symbol_compilation = symbol_scope->getCompilation();
-      const auto& preamble_compilation = preamble_manager->GetCompilation();
-      if (&symbol_compilation == &preamble_compilation) {
-        return false;  // Symbol from preamble compilation, not current file
-      }
-    }
+    preamble_compilation_ = &preamble_manager->GetCompilation();
+  }
+  if (current_file_buffer.valid()) {
+    buffers_.emplace(current_file_buffer.getId(), true);
   }
+}
 
-  if (!symbol.location.valid()) {
-    return false;
+auto SemanticIndex::CurrentFileFilter::Contains(
+    const slang::ast::Symbol& symbol) -> bool {
+  if (preamble_compilation_ != nullptr) {
+    const auto* symbol_scope = symbol.getParentScope();
+    if (symbol_scope != nullptr &&
+        &symbol_scope->getCompilation() == preamble_compilation_) {
+      return false;  // Symbol from preamble compilation, not current file
+    }
   }
 
-  auto uri = std::string(ToLspLocation(symbol.location, source_manager).uri);
-  return NormalizeUri(uri) == NormalizeUri(current_file_uri);
+  return Contains(symbol.location);
 }
 
-auto SemanticIndex::IsInCurrentFile(
-    slang::SourceLocation loc, const std::string& current_file_uri,
-    const slang::SourceManager& source_manager) -> bool {
+auto SemanticIndex::CurrentFileFilter::Contains(slang::SourceLocation loc)
+    -> bool {
   if (!loc.valid()) {
     return false;
   }
 
-  auto uri = std::string(ToLspLocation(loc, source_manager).uri);
-  return NormalizeUri(uri) == NormalizeUri(current_file_uri);
+  auto [it, inserted] = buffers_.try_emplace(loc.buffer().getId(), false);
+  if (inserted) {
+    auto uri = std::string(ToLspLocation(loc, source_manager_.get()).uri);
+    it->second = NormalizeUri(uri) == normalized_uri_;
+  }
+  return it->second;
 }
 
 auto SemanticIndex::FromCompilation(
@@ -74,13 +83,24 @@ auto SemanticIndex::FromCompilation(
     const slang::SourceManager& source_manager,
     const std::string& current_file_uri, slang::BufferID current_file_buffer,
     const services::PreambleManager* preamble_manager,
-    std::shared_ptr<spdlog::logger> logger)
+    std::shared_ptr<spdlog::logger> logger, std::stop_token stop_token)
     -> std::expected<std::unique_ptr<SemanticIndex>, std::string> {
   utils::ScopedTimer timer(
       fmt::format("Semantic indexing: {}", current_file_uri), logger);
+  auto index_start = std::chrono::steady_clock::now();
+  // forceElaborate() time; the rest is traversal (and whatever elaboration
+  // the traversal triggers lazily)
+  std::chrono::steady_clock::duration elaboration_time{0};
 
-  auto index = std::unique_ptr<SemanticIndex>(
-      new SemanticIndex(source_manager, current_file_uri, logger));
+  auto cancelled = [&]() -> std::unexpected<std::string> {
+    return std::unexpected(
+        fmt::format("Indexing cancelled: {}", current_file_uri));
+  };
+
+  auto index = std::unique_ptr<SemanticIndex>(new SemanticIndex(
+      source_manager, current_file_uri, current_file_buffer, logger));
+  CurrentFileFilter in_current_file(
+      source_manager, current_file_uri, current_file_buffer, preamble_manager);
 
   // Create visitor for comprehensive symbol collection and reference tracking
   auto visitor = IndexVisitor(
@@ -113,13 +133,15 @@ auto SemanticIndex::FromCompilation(
   //
   // No ordering needed - instances are independent of traversal order
   for (const auto* def : compilation.getDefinitions()) {
+    if (stop_token.stop_requested()) {
+      return cancelled();
+    }
     if (def->kind != slang::ast::SymbolKind::Definition) {
       continue;
     }
 
     const auto& definition = def->as<slang::ast::DefinitionSymbol>();
-    if (!IsInCurrentFile(
-            definition, current_file_uri, source_manager, preamble_manager)) {
+    if (!in_current_file.Contains(definition)) {
       continue;
     }
 
@@ -154,23 +176,34 @@ auto SemanticIndex::FromCompilation(
       {
         utils::ScopedTimer elab_timer(
             fmt::format("Elaboration for {}", definition.name), logger);
+        auto elab_start = std::chrono::steady_clock::now();
         compilation.forceElaborate(instance.body);
+        elaboration_time += std::chrono::steady_clock::now() - elab_start;
       }
 
       // Traverse the instance body to index all members
-      // (uses cached symbol resolutions from forceElaborate)
+      // (uses cached symbol resolutions from forceElaborate). Members are
+      // visited one by one (as body.visit() would) so a superseded build
+      // stops between them.
       {
         utils::ScopedTimer traversal_timer(
             fmt::format("Traversal for {}", definition.name), logger);
-        instance.body.visit(visitor);
+        for (const auto& member : instance.body.members()) {
+          if (stop_token.stop_requested()) {
+            return cancelled();
+          }
+          member.visit(visitor);
+        }
       }
     }
   }
 
   // PATH 2: Index packages
   for (const auto* pkg : compilation.getPackages()) {
-    if (IsInCurrentFile(
-            *pkg, current_file_uri, source_manager, preamble_manager)) {
+    if (stop_token.stop_requested()) {
+      return cancelled();
+    }
+    if (in_current_file.Contains(*pkg)) {
       pkg->visit(visitor);  // Packages are Scopes, members auto-traversed
     }
   }
@@ -179,9 +212,11 @@ auto SemanticIndex::FromCompilation(
   // CompilationUnits can contain symbols from MULTIPLE files, so we must
   // filter children by file URI
   for (const auto* unit : compilation.getCompilationUnits()) {
+    if (stop_token.stop_requested()) {
+      return cancelled();
+    }
     for (const auto& child : unit->members()) {
-      if (IsInCurrentFile(
-              child, current_file_uri, source_manager, preamble_manager)) {
+      if (in_current_file.Contains(child)) {
         // Skip packages - already handled in PATH 2
         if (child.kind == slang::ast::SymbolKind::Package) {
           continue;
@@ -220,14 +255,7 @@ auto SemanticIndex::FromCompilation(
     }
   }
 
-  // Sort entries by source location for O(n) validation and lookup
-  // optimizations O(n log n) - trivially fast even for 100k entries
-  // Sort by position only - all entries are in same file (invariant)
-  std::sort(
-      index->semantic_entries_.begin(), index->semantic_entries_.end(),
-      [](const SemanticEntry& a, const SemanticEntry& b) -> bool {
-        return a.ref_range.start < b.ref_range.start;
-      });
+  index->Finalize();
 
   // Check for indexing errors (e.g., BufferID mismatches)
   const auto& indexing_errors = visitor.GetIndexingErrors();
@@ -258,9 +286,52 @@ auto SemanticIndex::FromCompilation(
     logger->trace("{}", coverage_result.error());
   }
 
+  auto to_micros = [](std::chrono::steady_clock::duration duration) {
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(duration)
+            .count());
+  };
+  auto& metrics = utils::Metrics::Instance();
+  metrics.GetHistogram("session.elaborate_us")
+      .Record(to_micros(elaboration_time));
+  metrics.GetHistogram("session.index_us")
+      .Record(to_micros(
+          std::chrono::steady_clock::now() - index_start - elaboration_time));
+
   return index;
 }
 
+auto SemanticIndex::Finalize() -> void {
+  // Sort entries by source location for O(n) validation and lookup
+  // optimizations O(n log n) - trivially fast even for 100k entries
+  // Sort by position only - all entries are in same file (invariant)
+  std::sort(
+      semantic_entries_.begin(), semantic_entries_.end(),
+      [](const SemanticEntry& a, const SemanticEntry& b) -> bool {
+        return a.ref_range.start < b.ref_range.start;
+      });
+  semantic_entries_.shrink_to_fit();
+
+  ref_starts_.clear();
+  ref_starts_.reserve(semantic_entries_.size());
+  for (const auto& entry : semantic_entries_) {
+    ref_starts_.push_back(entry.ref_range.start);
+  }
+}
+
+auto SemanticIndex::GetDefinitionLocation(const SemanticEntry& entry) const
+    -> lsp::Location {
+  return lsp::Location{
+      .uri = std::string(strings_.Get(entry.def_uri)),
+      .range = entry.def_range};
+}
+
+auto SemanticIndex::MemoryUsage() const -> size_t {
+  return (semantic_entries_.capacity() * sizeof(SemanticEntry)) +
+         (ref_starts_.capacity() * sizeof(lsp::Position)) +
+         strings_.MemoryUsage();
+}
+
 // Go-to-definition using LSP coordinates
 auto SemanticIndex::LookupDefinitionAt(
     const std::string& uri, lsp::Position position) const
@@ -270,24 +341,19 @@ auto SemanticIndex::LookupDefinitionAt(
     return std::nullopt;  // Wrong file!
   }
 
-  // Binary search in sorted entries by position
-  // Entries are sorted by source_range.start within the single file
-  const auto projection = [](const SemanticEntry& e) {
-    return e.ref_range.start;
-  };
-
-  auto it = std::ranges::upper_bound(
-      semantic_entries_, position, std::ranges::less{}, projection);
+  // Binary search in sorted start positions
+  auto it = std::ranges::upper_bound(ref_starts_, position);
 
   // Move back one entry - this is the candidate that might contain our position
   // (since its start is <= target, but the next entry's start is > target)
-  if (it != semantic_entries_.begin()) {
-    --it;
+  if (it != ref_starts_.begin()) {
+    const auto& entry = semantic_entries_[static_cast<size_t>(
+        std::distance(ref_starts_.begin(), it) - 1)];
 
     // Verify the entry contains the target position
-    if (it->ref_range.Contains(position)) {
+    if (entry.ref_range.Contains(position)) {
       // Return the definition location using standard LSP type
-      return lsp::Location{.uri = it->def_loc.uri, .range = it->def_loc.range};
+      return GetDefinitionLocation(entry);
     }
   }
 
@@ -317,7 +383,7 @@ auto SemanticIndex::ValidateNoRangeOverlaps(bool strict) const
     if (overlap) {
       auto msg = fmt::format(
           "Range overlap for symbol '{}' at line {} (char {}-{}) in '{}'",
-          curr.name, curr.ref_range.start.line + 1,
+          GetName(curr), curr.ref_range.start.line + 1,
           curr.ref_range.start.character, curr.ref_range.end.character,
           filename);
 
@@ -349,10 +415,9 @@ auto SemanticIndex::ValidateCoordinates() const
   std::string first_invalid_symbol;
   for (const auto& entry : semantic_entries_) {
     if (entry.ref_range.start.line == -1 || entry.ref_range.end.line == -1 ||
-        entry.def_loc.range.start.line == -1 ||
-        entry.def_loc.range.end.line == -1) {
+        entry.def_range.start.line == -1 || entry.def_range.end.line == -1) {
       if (invalid_count == 0) {
-        first_invalid_symbol = std::string(entry.name);
+        first_invalid_symbol = std::string(GetName(entry));
       }
       invalid_count++;
     }
@@ -399,10 +464,11 @@ auto SemanticIndex::ValidateSymbolCoverage(
   };
 
   IdentifierCollector collector;
+  CurrentFileFilter in_current_file(
+      source_manager_.get(), current_file_uri, current_file_buffer_);
   for (const auto& tree : compilation.getSyntaxTrees()) {
     auto tree_location = tree->root().sourceRange().start();
-    if (!IsInCurrentFile(
-            tree_location, current_file_uri, source_manager_.get())) {
+    if (!in_current_file.Contains(tree_location)) {
       continue;
     }
 
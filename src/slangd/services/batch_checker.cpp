@@ -0,0 +1,168 @@
+#include "slangd/services/batch_checker.hpp"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "slangd/core/project_layout_service.hpp"
+#include "slangd/semantic/diagnostic_converter.hpp"
+#include "slangd/services/include_cache.hpp"
+#include "slangd/services/open_document_tracker.hpp"
+#include "slangd/services/overlay_session.hpp"
+#include "slangd/services/preamble_manager.hpp"
+#include "slangd/services/session_manager.hpp"
+#include "slangd/utils/scoped_timer.hpp"
+
+namespace slangd::services {
+
+namespace {
+
+// Same diagnostics as LanguageService::CreateDiagnosticHook
+auto CollectDiagnostics(const OverlaySession& session)
+    -> std::vector<lsp::Diagnostic> {
+  auto& compilation = session.GetCompilation();
+  auto diagnostics = semantic::DiagnosticConverter::ExtractParseDiagnostics(
+      compilation, session.GetSourceManager(), session.GetMainBufferID());
+  auto semantic_diagnostics =
+      semantic::DiagnosticConverter::ExtractCollectedDiagnostics(
+          compilation, session.GetSourceManager(), session.GetMainBufferID());
+  diagnostics.insert(
+      diagnostics.end(), semantic_diagnostics.begin(),
+      semantic_diagnostics.end());
+  return diagnostics;
+}
+
+auto SarifLevel(std::optional<lsp::DiagnosticSeverity> severity)
+    -> std::string_view {
+  switch (severity.value_or(lsp::DiagnosticSeverity::kError)) {
+    case lsp::DiagnosticSeverity::kError:
+      return "error";
+    case lsp::DiagnosticSeverity::kWarning:
+      return "warning";
+    default:
+      return "note";
+  }
+}
+
+}  // namespace
+
+BatchChecker::BatchChecker(
+    asio::any_io_executor executor, CanonicalPath workspace_root,
+    size_t thread_count, std::shared_ptr<spdlog::logger> logger)
+    : executor_(std::move(executor)),
+      workspace_root_(std::move(workspace_root)),
+      logger_(logger ? logger : spdlog::default_logger()) {
+  scheduler_ = std::make_shared<utils::PriorityScheduler>(
+      std::max<size_t>(thread_count, 1), logger_);
+}
+
+auto BatchChecker::Run(std::function<void(const FileCheckResult&)> on_result)
+    -> asio::awaitable<BatchCheckSummary> {
+  utils::ScopedTimer timer("Batch check", logger_);
+  auto layout_service =
+      ProjectLayoutService::Create(executor_, workspace_root_, logger_);
+  co_await layout_service->LoadConfig(workspace_root_);
+
+  std::shared_ptr<const PreambleManager> preamble_manager;
+  auto preamble_result = co_await PreambleManager::CreateFromProjectLayout(
+      layout_service, scheduler_->GetExecutor(utils::TaskPriority::kVisible),
+      logger_);
+  if (preamble_result) {
+    preamble_manager = *preamble_result;
+  } else {
+    logger_->warn(
+        "Preamble creation failed: {} (checking files without preamble)",
+        preamble_result.error());
+  }
+
+  SessionManager session_manager(
+      executor_, layout_service, preamble_manager,
+      std::make_shared<OpenDocumentTracker>(), scheduler_,
+      std::make_shared<IncludeCache>(logger_), logger_);
+
+  auto files = layout_service->GetSourceFiles();
+  BatchCheckSummary summary{.files = files.size()};
+  std::vector<std::string> uris;
+  uris.reserve(files.size());
+  for (const auto& file : files) {
+    uris.push_back(file.ToUri());
+  }
+
+  std::vector<std::vector<lsp::Diagnostic>> diagnostics(files.size());
+  co_await session_manager.SweepFiles(
+      uris, utils::TaskPriority::kVisible,
+      [&](size_t index, const OverlaySession& session) {
+        diagnostics[index] = CollectDiagnostics(session);
+      },
+      [&](size_t index, bool built) {
+        FileCheckResult result{
+            .path = files[index],
+            .diagnostics = std::move(diagnostics[index]),
+            .checked = built};
+        if (!result.checked) {
+          logger_->error("Cannot check {}", result.path.String());
+          ++summary.unchecked;
+        }
+        for (const auto& diagnostic : result.diagnostics) {
+          auto severity =
+              diagnostic.severity.value_or(lsp::DiagnosticSeverity::kError);
+          summary.errors += severity == lsp::DiagnosticSeverity::kError;
+          summary.warnings += severity == lsp::DiagnosticSeverity::kWarning;
+        }
+        on_result(result);
+      });
+  co_await session_manager.Shutdown();
+  scheduler_->Join();
+
+  logger_->info(
+      "Checked {} files with {} threads: {} errors, {} warnings ({})",
+      summary.files - summary.unchecked, scheduler_->ThreadCount(),
+      summary.errors, summary.warnings,
+      utils::ScopedTimer::FormatDuration(timer.GetElapsed()));
+  co_return summary;
+}
+
+auto ToJson(const FileCheckResult& result) -> nlohmann::json {
+  return {
+      {"uri", result.path.ToUri()},
+      {"checked", result.checked},
+      {"diagnostics", result.diagnostics}};
+}
+
+auto ToSarif(const std::vector<FileCheckResult>& results) -> nlohmann::json {
+  auto sarif_results = nlohmann::json::array();
+  for (const auto& result : results) {
+    auto uri = result.path.ToUri();
+    for (const auto& diagnostic : result.diagnostics) {
+      // SARIF lines and columns are 1-based, LSP positions 0-based
+      const auto& range = diagnostic.range;
+      nlohmann::json sarif_result{
+          {"level", SarifLevel(diagnostic.severity)},
+          {"message", {{"text", diagnostic.message}}},
+          {"locations",
+           {{{"physicalLocation",
+              {{"artifactLocation", {{"uri", uri}}},
+               {"region",
+                {{"startLine", range.start.line + 1},
+                 {"startColumn", range.start.character + 1},
+                 {"endLine", range.end.line + 1},
+                 {"endColumn", range.end.character + 1}}}}}}}}};
+      if (diagnostic.code) {
+        sarif_result["ruleId"] = *diagnostic.code;
+      }
+      sarif_results.push_back(std::move(sarif_result));
+    }
+  }
+
+  return {
+      {"$schema", "https://json.schemastore.org/sarif-2.1.0.json"},
+      {"version", "2.1.0"},
+      {"runs",
+       {{{"tool",
+          {{"driver",
+            {{"name", "slangd"},
+             {"informationUri", "https://github.com/hankhsu1996/slangd"}}}}},
+         {"results", sarif_results}}}}};
+}
+
+}  // namespace slangd::services
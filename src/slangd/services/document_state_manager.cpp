@@ -1,5 +1,7 @@
 #include "slangd/services/document_state_manager.hpp"
 
+#include <variant>
+
 namespace slangd::services {
 
 DocumentStateManager::DocumentStateManager(
@@ -14,8 +16,8 @@ auto DocumentStateManager::Update(
     -> asio::awaitable<void> {
   co_await asio::post(strand_, asio::use_awaitable);
 
-  documents_[uri] = DocumentState{
-      .content = std::move(content),
+  documents_[uri] = Document{
+      .text = utils::TextBuffer(content),
       .version = version,
   };
 
@@ -25,13 +27,41 @@ auto DocumentStateManager::Update(
   co_return;
 }
 
+auto DocumentStateManager::ApplyChanges(
+    std::string uri, std::vector<lsp::TextDocumentContentChangeEvent> changes,
+    int version) -> asio::awaitable<bool> {
+  co_await asio::post(strand_, asio::use_awaitable);
+
+  auto it = documents_.find(uri);
+  if (it == documents_.end()) {
+    co_return false;
+  }
+
+  auto& document = it->second;
+  for (const auto& change : changes) {
+    if (const auto* partial =
+            std::get_if<lsp::TextDocumentContentPartialChangeEvent>(&change)) {
+      document.text.Replace(partial->range, partial->text);
+    } else {
+      document.text.Assign(
+          std::get<lsp::TextDocumentContentFullChangeEvent>(change).text);
+    }
+  }
+  document.version = version;
+
+  co_return true;
+}
+
 auto DocumentStateManager::Get(std::string uri)
     -> asio::awaitable<std::optional<DocumentState>> {
   co_await asio::post(strand_, asio::use_awaitable);
 
   auto it = documents_.find(uri);
   if (it != documents_.end()) {
-    co_return it->second;
+    co_return DocumentState{
+        .content = it->second.text.ToString(),
+        .version = it->second.version,
+    };
   }
   co_return std::nullopt;
 }
@@ -0,0 +1,277 @@
+#include "slangd/services/file_index.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <thread>
+#include <tuple>
+
+#include <slang/util/Hash.h>
+
+namespace slangd::services {
+
+namespace {
+
+template <typename T>
+auto ViewAt(std::span<const std::byte> bytes, size_t offset, size_t count)
+    -> std::span<const T> {
+  return {reinterpret_cast<const T*>(bytes.data() + offset), count};
+}
+
+template <typename T>
+auto CopyAt(
+    std::vector<std::byte>& bytes, size_t offset, const T* data, size_t count)
+    -> void {
+  if (count != 0) {
+    std::memcpy(bytes.data() + offset, data, count * sizeof(T));
+  }
+}
+
+}  // namespace
+
+auto FileIndex::Build(
+    std::string_view path, uint64_t content_hash, uint64_t options_key,
+    const syntax::IndexedFile& file) -> std::shared_ptr<const FileIndex> {
+  // Unique names, sorted so lookups can binary search
+  std::vector<std::string_view> names;
+  {
+    slang::flat_hash_set<std::string_view> seen;
+    auto add = [&](std::string_view name) {
+      if (!name.empty() && seen.insert(name).second) {
+        names.push_back(name);
+      }
+    };
+    for (const auto& symbol : file.symbols) {
+      add(symbol.name);
+      add(symbol.container);
+    }
+    for (const auto& occurrence : file.occurrences) {
+      add(occurrence.name);
+    }
+    std::ranges::sort(names);
+  }
+  auto id_of = [&](std::string_view name) -> uint32_t {
+    if (name.empty()) {
+      return kNoName;
+    }
+    return static_cast<uint32_t>(
+        std::ranges::lower_bound(names, name) - names.begin());
+  };
+
+  std::string strings(path);
+  std::vector<NameRef> name_refs;
+  name_refs.reserve(names.size());
+  for (auto name : names) {
+    name_refs.push_back(
+        NameRef{
+            .offset = static_cast<uint32_t>(strings.size()),
+            .length = static_cast<uint32_t>(name.size())});
+    strings += name;
+  }
+
+  std::vector<SymbolRecord> symbols;
+  symbols.reserve(file.symbols.size());
+  for (const auto& symbol : file.symbols) {
+    symbols.push_back(
+        SymbolRecord{
+            .name = id_of(symbol.name),
+            .container = id_of(symbol.container),
+            .kind = static_cast<uint32_t>(symbol.kind),
+            .line = symbol.range.start.line,
+            .start_character = symbol.range.start.character,
+            .end_character = symbol.range.end.character});
+  }
+
+  std::vector<OccurrenceRecord> occurrences;
+  occurrences.reserve(file.occurrences.size());
+  for (const auto& occurrence : file.occurrences) {
+    occurrences.push_back(
+        OccurrenceRecord{
+            .name = id_of(occurrence.name),
+            .is_definition = occurrence.is_definition ? 1U : 0U,
+            .line = occurrence.range.start.line,
+            .start_character = occurrence.range.start.character,
+            .end_character = occurrence.range.end.character});
+  }
+  std::ranges::sort(occurrences, {}, [](const OccurrenceRecord& record) {
+    return std::tuple(record.name, record.line, record.start_character);
+  });
+
+  Header header{
+      .magic = kMagic,
+      .version = kVersion,
+      .content_hash = content_hash,
+      .options_key = options_key,
+      .path_length = static_cast<uint32_t>(path.size()),
+      .name_count = static_cast<uint32_t>(name_refs.size()),
+      .symbol_count = static_cast<uint32_t>(symbols.size()),
+      .occurrence_count = static_cast<uint32_t>(occurrences.size()),
+      .string_bytes = static_cast<uint32_t>(strings.size()),
+      .reserved = 0};
+
+  auto names_offset = sizeof(Header);
+  auto symbols_offset = names_offset + (name_refs.size() * sizeof(NameRef));
+  auto occurrences_offset =
+      symbols_offset + (symbols.size() * sizeof(SymbolRecord));
+  auto strings_offset =
+      occurrences_offset + (occurrences.size() * sizeof(OccurrenceRecord));
+
+  auto index = std::shared_ptr<FileIndex>(new FileIndex());
+  index->owned_.resize(strings_offset + strings.size());
+  CopyAt(index->owned_, 0, &header, 1);
+  CopyAt(index->owned_, names_offset, name_refs.data(), name_refs.size());
+  CopyAt(index->owned_, symbols_offset, symbols.data(), symbols.size());
+  CopyAt(
+      index->owned_, occurrences_offset, occurrences.data(),
+      occurrences.size());
+  CopyAt(index->owned_, strings_offset, strings.data(), strings.size());
+  index->Attach(index->owned_);
+  return index;
+}
+
+auto FileIndex::Load(
+    const std::filesystem::path& shard_path, std::string_view path,
+    uint64_t content_hash, uint64_t options_key)
+    -> std::shared_ptr<const FileIndex> {
+  auto mapped = utils::MappedFile::Open(shard_path);
+  if (!mapped) {
+    return nullptr;
+  }
+
+  auto index = std::shared_ptr<FileIndex>(new FileIndex());
+  index->mapped_ = std::move(*mapped);
+  if (!index->Attach(index->mapped_.Data()) ||
+      !index->Matches(content_hash, options_key) || index->GetPath() != path) {
+    return nullptr;
+  }
+  return index;
+}
+
+auto FileIndex::FromBytes(
+    std::shared_ptr<const void> owner, std::span<const std::byte> bytes)
+    -> std::shared_ptr<const FileIndex> {
+  auto index = std::shared_ptr<FileIndex>(new FileIndex());
+  index->owner_ = std::move(owner);
+  if (!index->Attach(bytes)) {
+    return nullptr;
+  }
+  return index;
+}
+
+auto FileIndex::Save(const std::filesystem::path& shard_path) const -> bool {
+  // Unique temp name: overlapping builds may write the same shard
+  auto temp_path = shard_path;
+  temp_path += ".tmp" + std::to_string(std::hash<std::thread::id>{}(
+                            std::this_thread::get_id()));
+  {
+    std::ofstream out(temp_path, std::ios::binary | std::ios::trunc);
+    out.write(
+        reinterpret_cast<const char*>(bytes_.data()),
+        static_cast<std::streamsize>(bytes_.size()));
+    if (!out) {
+      std::error_code ec;
+      std::filesystem::remove(temp_path, ec);
+      return false;
+    }
+  }
+
+  std::error_code ec;
+  std::filesystem::rename(temp_path, shard_path, ec);
+  if (ec) {
+    std::filesystem::remove(temp_path, ec);
+    return false;
+  }
+  return true;
+}
+
+auto FileIndex::Attach(std::span<const std::byte> bytes) -> bool {
+  if (bytes.size() < sizeof(Header)) {
+    return false;
+  }
+  const auto* header = reinterpret_cast<const Header*>(bytes.data());
+  if (header->magic != kMagic || header->version != kVersion) {
+    return false;
+  }
+
+  // 64-bit arithmetic: counts come from an untrusted file
+  uint64_t names_offset = sizeof(Header);
+  uint64_t symbols_offset =
+      names_offset + (uint64_t{header->name_count} * sizeof(NameRef));
+  uint64_t occurrences_offset =
+      symbols_offset + (uint64_t{header->symbol_count} * sizeof(SymbolRecord));
+  uint64_t strings_offset =
+      occurrences_offset +
+      (uint64_t{header->occurrence_count} * sizeof(OccurrenceRecord));
+  if (strings_offset + header->string_bytes != bytes.size() ||
+      header->path_length > header->string_bytes) {
+    return false;
+  }
+
+  auto names = ViewAt<NameRef>(bytes, names_offset, header->name_count);
+  auto symbols =
+      ViewAt<SymbolRecord>(bytes, symbols_offset, header->symbol_count);
+  auto occurrences = ViewAt<OccurrenceRecord>(
+      bytes, occurrences_offset, header->occurrence_count);
+
+  auto valid_name = [&](uint32_t id) { return id < header->name_count; };
+  if (std::ranges::any_of(
+          names,
+          [&](const NameRef& ref) {
+            return uint64_t{ref.offset} + ref.length > header->string_bytes;
+          }) ||
+      std::ranges::any_of(
+          symbols,
+          [&](const SymbolRecord& record) {
+            return !valid_name(record.name) ||
+                   (record.container != kNoName &&
+                    !valid_name(record.container));
+          }) ||
+      std::ranges::any_of(occurrences, [&](const OccurrenceRecord& record) {
+        return !valid_name(record.name);
+      })) {
+    return false;
+  }
+
+  bytes_ = bytes;
+  header_ = header;
+  names_ = names;
+  symbols_ = symbols;
+  occurrences_ = occurrences;
+  strings_ = std::string_view(
+      reinterpret_cast<const char*>(bytes.data() + strings_offset),
+      header->string_bytes);
+  return true;
+}
+
+auto FileIndex::GetPath() const -> std::string_view {
+  return strings_.substr(0, header_->path_length);
+}
+
+auto FileIndex::GetName(uint32_t id) const -> std::string_view {
+  if (id >= names_.size()) {
+    return {};
+  }
+  return strings_.substr(names_[id].offset, names_[id].length);
+}
+
+auto FileIndex::FindOccurrences(std::string_view name) const
+    -> std::span<const OccurrenceRecord> {
+  auto name_it = std::ranges::lower_bound(
+      names_, name, {}, [this](const NameRef& ref) {
+        return strings_.substr(ref.offset, ref.length);
+      });
+  if (name_it == names_.end() ||
+      strings_.substr(name_it->offset, name_it->length) != name) {
+    return {};
+  }
+
+  auto id = static_cast<uint32_t>(name_it - names_.begin());
+  auto range = std::ranges::equal_range(
+      occurrences_, id, {},
+      [](const OccurrenceRecord& record) { return record.name; });
+  return {range.begin(), range.end()};
+}
+
+}  // namespace slangd::services
@@ -0,0 +1,230 @@
+#include "slangd/services/include_cache.hpp"
+
+#include <optional>
+#include <string_view>
+
+#include <slang/text/SourceManager.h>
+#include <slang/util/Hash.h>
+
+#include "slangd/utils/hash.hpp"
+#include "slangd/utils/metrics.hpp"
+
+namespace slangd::services {
+
+namespace {
+
+auto LookupCounter(bool hit) -> utils::Counter& {
+  static auto& hits =
+      utils::Metrics::Instance().GetCounter("include_cache.hits");
+  static auto& misses =
+      utils::Metrics::Instance().GetCounter("include_cache.misses");
+  return hit ? hits : misses;
+}
+
+struct FileStamp {
+  std::filesystem::file_time_type mtime;
+  uintmax_t size = 0;
+};
+
+auto StatFile(const std::string& path) -> std::optional<FileStamp> {
+  std::error_code ec;
+  auto mtime = std::filesystem::last_write_time(path, ec);
+  if (ec) {
+    return std::nullopt;
+  }
+  auto size = std::filesystem::file_size(path, ec);
+  if (ec) {
+    return std::nullopt;
+  }
+  return FileStamp{.mtime = mtime, .size = size};
+}
+
+}  // namespace
+
+IncludeCache::IncludeCache(
+    std::shared_ptr<spdlog::logger> logger, size_t max_bytes)
+    : max_bytes_(max_bytes),
+      logger_(logger ? logger : spdlog::default_logger()) {
+}
+
+auto IncludeCache::Seed(
+    const std::string& uri, slang::SourceManager& source_manager) -> uint64_t {
+  struct Candidate {
+    std::string path;
+    Entry entry;
+  };
+  std::vector<Candidate> candidates;
+  size_t missing = 0;
+  uint64_t generation = 0;
+  {
+    std::lock_guard lock(mutex_);
+    generation = generation_;
+    auto it = includes_.find(uri);
+    if (it == includes_.end()) {
+      return generation;
+    }
+    for (const auto& path : it->second) {
+      if (auto entry = entries_.find(path); entry != entries_.end()) {
+        candidates.push_back(Candidate{.path = path, .entry = entry->second});
+      } else {
+        ++missing;
+      }
+    }
+  }
+
+  // stat outside the lock; the shared_ptrs keep the contents alive
+  std::vector<Candidate> changed;
+  for (auto& candidate : candidates) {
+    auto stamp = StatFile(candidate.path);
+    if (!stamp || stamp->mtime != candidate.entry.mtime ||
+        stamp->size != candidate.entry.size) {
+      changed.push_back(std::move(candidate));
+      continue;
+    }
+    // e.g. the main buffer, if a file includes itself
+    if (!source_manager.isCached(candidate.path)) {
+      source_manager.assignText(candidate.path, *candidate.entry.text);
+    }
+  }
+
+  std::lock_guard lock(mutex_);
+  for (const auto& candidate : changed) {
+    // Unless a newer build already recorded the new contents
+    if (auto it = entries_.find(candidate.path);
+        it != entries_.end() && it->second.text == candidate.entry.text) {
+      logger_->debug("IncludeCache: {} changed on disk", candidate.path);
+      EraseLocked(it);
+    }
+  }
+  auto hits = candidates.size() - changed.size();
+  auto misses = missing + changed.size();
+  stats_.hits += hits;
+  stats_.misses += misses;
+  LookupCounter(true).Add(hits);
+  LookupCounter(false).Add(misses);
+  return generation;
+}
+
+auto IncludeCache::Record(
+    const std::string& uri, const slang::SourceManager& source_manager,
+    uint64_t generation) -> void {
+  struct Loaded {
+    std::string path;
+    std::string_view text;
+    FileStamp stamp;
+  };
+  std::vector<std::string> paths;
+  std::vector<Loaded> loaded;
+  for (auto buffer : source_manager.getAllBuffers()) {
+    // Seeded buffers that were never included have no include location
+    if (!source_manager.getIncludedFrom(buffer).valid()) {
+      continue;
+    }
+    auto path = source_manager.getFullPath(buffer).string();
+    auto text = source_manager.getSourceText(buffer);
+    // Slang buffers carry a NUL terminator that the file does not
+    if (!text.empty() && text.back() == '\0') {
+      text.remove_suffix(1);
+    }
+    paths.push_back(path);
+    // Stamped after the read: a size mismatch means the file changed in
+    // between, and those contents are not kept
+    if (auto stamp = StatFile(path); stamp && stamp->size == text.size()) {
+      loaded.push_back(
+          Loaded{.path = std::move(path), .text = text, .stamp = *stamp});
+    }
+  }
+
+  std::lock_guard lock(mutex_);
+  includes_[uri] = std::move(paths);
+  if (generation != generation_) {
+    return;
+  }
+  for (const auto& [path, text, stamp] : loaded) {
+    if (entries_.contains(path)) {
+      continue;
+    }
+    if (stats_.bytes + text.size() > max_bytes_) {
+      logger_->debug(
+          "IncludeCache: {} MB limit reached, not caching {}",
+          max_bytes_ / (1024 * 1024), path);
+      continue;
+    }
+
+    auto hash = utils::HashBytes(text);
+    auto blob = blobs_[hash].lock();
+    if (!blob || *blob != text) {
+      blob = std::make_shared<const std::string>(text);
+      blobs_[hash] = blob;
+    }
+    entries_.emplace(
+        path, Entry{
+                  .content_hash = hash,
+                  .text = blob,
+                  .mtime = stamp.mtime,
+                  .size = stamp.size});
+    stats_.bytes += text.size();
+  }
+  stats_.entries = entries_.size();
+}
+
+auto IncludeCache::Invalidate(const CanonicalPath& path) -> void {
+  std::lock_guard lock(mutex_);
+  ++generation_;
+  if (auto it = entries_.find(path.Path().string()); it != entries_.end()) {
+    logger_->debug("IncludeCache: invalidated {}", it->first);
+    EraseLocked(it);
+  }
+}
+
+auto IncludeCache::Forget(const std::string& uri) -> void {
+  std::lock_guard lock(mutex_);
+  auto it = includes_.find(uri);
+  if (it == includes_.end()) {
+    return;
+  }
+  auto paths = std::move(it->second);
+  includes_.erase(it);
+
+  slang::flat_hash_set<std::string_view> still_included;
+  for (const auto& [other_uri, other_paths] : includes_) {
+    still_included.insert(other_paths.begin(), other_paths.end());
+  }
+  for (const auto& path : paths) {
+    if (still_included.contains(path)) {
+      continue;
+    }
+    if (auto entry = entries_.find(path); entry != entries_.end()) {
+      EraseLocked(entry);
+    }
+  }
+}
+
+auto IncludeCache::Clear() -> void {
+  std::lock_guard lock(mutex_);
+  entries_.clear();
+  blobs_.clear();
+  includes_.clear();
+  stats_.entries = 0;
+  stats_.bytes = 0;
+}
+
+auto IncludeCache::GetStats() const -> Stats {
+  std::lock_guard lock(mutex_);
+  return stats_;
+}
+
+auto IncludeCache::EraseLocked(
+    std::unordered_map<std::string, Entry>::iterator it) -> void {
+  stats_.bytes -= it->second.text->size();
+  auto hash = it->second.content_hash;
+  entries_.erase(it);
+  // Drop the blob once no other path shares it
+  if (auto blob = blobs_.find(hash);
+      blob != blobs_.end() && blob->second.expired()) {
+    blobs_.erase(blob);
+  }
+  stats_.entries = entries_.size();
+}
+
+}  // namespace slangd::services
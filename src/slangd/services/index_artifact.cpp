@@ -0,0 +1,407 @@
+#include "slangd/services/index_artifact.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <span>
+
+#include <fmt/format.h>
+
+#include "slangd/services/workspace_index.hpp"
+#include "slangd/utils/hash.hpp"
+
+namespace slangd::services {
+
+namespace {
+
+constexpr size_t kAlignment = 8;
+
+auto AlignUp(uint64_t offset) -> uint64_t {
+  return (offset + kAlignment - 1) / kAlignment * kAlignment;
+}
+
+auto ChecksumOf(std::span<const std::byte> bytes) -> uint64_t {
+  auto body = bytes.subspan(sizeof(IndexArtifact::Header));
+  return utils::HashBytes(std::string_view(
+      reinterpret_cast<const char*>(body.data()), body.size()));
+}
+
+auto EncodeReferences(
+    const ReferenceIndex::FileReferences& references,
+    std::string_view root_uri_prefix) -> std::vector<std::byte> {
+  using Artifact = IndexArtifact;
+  std::vector<Artifact::DefUriRef> uri_refs;
+  uri_refs.reserve(references.def_uris.size());
+  std::string strings;
+  for (std::string_view uri : references.def_uris) {
+    bool relative = uri.starts_with(root_uri_prefix);
+    if (relative) {
+      uri.remove_prefix(root_uri_prefix.size());
+    }
+    uri_refs.push_back(
+        Artifact::DefUriRef{
+            .offset = static_cast<uint32_t>(strings.size()),
+            .length = static_cast<uint32_t>(uri.size()),
+            .relative = relative ? 1U : 0U,
+            .reserved = 0});
+    strings += uri;
+  }
+
+  std::vector<Artifact::ReferenceRecord> records;
+  records.reserve(references.references.size());
+  for (const auto& reference : references.references) {
+    records.push_back(
+        Artifact::ReferenceRecord{
+            .def_uri = reference.def_uri,
+            .is_declaration = reference.is_declaration ? 1U : 0U,
+            .def_start_line = reference.def_range.start.line,
+            .def_start_character = reference.def_range.start.character,
+            .def_end_line = reference.def_range.end.line,
+            .def_end_character = reference.def_range.end.character,
+            .start_line = reference.range.start.line,
+            .start_character = reference.range.start.character,
+            .end_line = reference.range.end.line,
+            .end_character = reference.range.end.character});
+  }
+
+  Artifact::ReferencesHeader header{
+      .def_uri_count = static_cast<uint32_t>(uri_refs.size()),
+      .reference_count = static_cast<uint32_t>(records.size()),
+      .string_bytes = static_cast<uint32_t>(strings.size()),
+      .reserved = 0};
+  auto records_offset = sizeof(header);
+  auto uris_offset = records_offset + (records.size() * sizeof(records[0]));
+  auto strings_offset =
+      uris_offset + (uri_refs.size() * sizeof(Artifact::DefUriRef));
+
+  std::vector<std::byte> bytes(strings_offset + strings.size());
+  std::memcpy(bytes.data(), &header, sizeof(header));
+  if (!records.empty()) {
+    std::memcpy(
+        bytes.data() + records_offset, records.data(),
+        records.size() * sizeof(records[0]));
+  }
+  if (!uri_refs.empty()) {
+    std::memcpy(
+        bytes.data() + uris_offset, uri_refs.data(),
+        uri_refs.size() * sizeof(Artifact::DefUriRef));
+  }
+  std::memcpy(bytes.data() + strings_offset, strings.data(), strings.size());
+  return bytes;
+}
+
+auto DecodeReferences(
+    std::span<const std::byte> bytes, std::string_view root_uri_prefix)
+    -> std::optional<ReferenceIndex::FileReferences> {
+  using Artifact = IndexArtifact;
+  if (bytes.size() < sizeof(Artifact::ReferencesHeader)) {
+    return std::nullopt;
+  }
+  const auto* header =
+      reinterpret_cast<const Artifact::ReferencesHeader*>(bytes.data());
+  // 64-bit arithmetic: counts come from an untrusted file
+  uint64_t records_offset = sizeof(Artifact::ReferencesHeader);
+  uint64_t uris_offset =
+      records_offset +
+      (uint64_t{header->reference_count} * sizeof(Artifact::ReferenceRecord));
+  uint64_t strings_offset =
+      uris_offset +
+      (uint64_t{header->def_uri_count} * sizeof(Artifact::DefUriRef));
+  if (strings_offset + header->string_bytes != bytes.size()) {
+    return std::nullopt;
+  }
+  std::span records(
+      reinterpret_cast<const Artifact::ReferenceRecord*>(
+          bytes.data() + records_offset),
+      header->reference_count);
+  std::span uri_refs(
+      reinterpret_cast<const Artifact::DefUriRef*>(bytes.data() + uris_offset),
+      header->def_uri_count);
+  std::string_view strings(
+      reinterpret_cast<const char*>(bytes.data() + strings_offset),
+      header->string_bytes);
+
+  ReferenceIndex::FileReferences references;
+  references.def_uris.reserve(uri_refs.size());
+  for (const auto& ref : uri_refs) {
+    if (uint64_t{ref.offset} + ref.length > strings.size()) {
+      return std::nullopt;
+    }
+    auto uri = strings.substr(ref.offset, ref.length);
+    references.def_uris.push_back(
+        ref.relative != 0 ? std::string(root_uri_prefix) + std::string(uri)
+                          : std::string(uri));
+  }
+  references.references.reserve(records.size());
+  for (const auto& record : records) {
+    if (record.def_uri >= uri_refs.size()) {
+      return std::nullopt;
+    }
+    references.references.push_back(
+        ReferenceIndex::Reference{
+            .def_uri = record.def_uri,
+            .def_range =
+                lsp::Range{
+                    .start =
+                        {.line = record.def_start_line,
+                         .character = record.def_start_character},
+                    .end =
+                        {.line = record.def_end_line,
+                         .character = record.def_end_character}},
+            .range =
+                lsp::Range{
+                    .start =
+                        {.line = record.start_line,
+                         .character = record.start_character},
+                    .end =
+                        {.line = record.end_line,
+                         .character = record.end_character}},
+            .is_declaration = record.is_declaration != 0});
+  }
+  return references;
+}
+
+}  // namespace
+
+auto IndexArtifact::DefaultPath(const CanonicalPath& workspace_root)
+    -> std::filesystem::path {
+  if (const char* path = std::getenv("SLANGD_INDEX_ARTIFACT")) {
+    return path;
+  }
+  return workspace_root.Path() / ".cache" / "slangd" / "index.slia";
+}
+
+auto IndexArtifact::Write(
+    const WorkspaceIndex& index, const References& references,
+    uint64_t header_fingerprint, const CanonicalPath& workspace_root,
+    const std::filesystem::path& path) -> std::expected<size_t, std::string> {
+  auto root_uri_prefix = workspace_root.ToUri() + "/";
+  struct Shard {
+    std::string path;
+    const FileIndex* index;
+    std::vector<std::byte> references;
+  };
+  std::vector<Shard> shards;
+  index.ForEachFile([&](std::string_view uri, const FileIndex& shard) {
+    auto absolute = std::filesystem::path(shard.GetPath());
+    auto relative = absolute.lexically_relative(workspace_root.Path());
+    std::vector<std::byte> encoded;
+    if (auto it = references.find(std::string(uri)); it != references.end()) {
+      encoded = EncodeReferences(it->second, root_uri_prefix);
+    }
+    shards.push_back(
+        Shard{
+            .path = relative.empty() ? absolute.generic_string()
+                                     : relative.generic_string(),
+            .index = &shard,
+            .references = std::move(encoded)});
+  });
+  std::ranges::sort(shards, {}, &Shard::path);
+
+  std::vector<Entry> entries;
+  entries.reserve(shards.size());
+  std::string paths;
+  for (const auto& shard : shards) {
+    entries.push_back(
+        Entry{
+            .path_offset = static_cast<uint32_t>(paths.size()),
+            .path_length = static_cast<uint32_t>(shard.path.size()),
+            .content_hash = shard.index->GetContentHash(),
+            .shard_offset = 0,
+            .shard_size = shard.index->GetBytes().size(),
+            .references_offset = 0,
+            .references_size = shard.references.size()});
+    paths += shard.path;
+  }
+
+  uint64_t paths_offset = sizeof(Header) + (entries.size() * sizeof(Entry));
+  uint64_t offset = AlignUp(paths_offset + paths.size());
+  for (auto& entry : entries) {
+    entry.shard_offset = offset;
+    offset = AlignUp(offset + entry.shard_size);
+    if (entry.references_size != 0) {
+      entry.references_offset = offset;
+      offset = AlignUp(offset + entry.references_size);
+    }
+  }
+
+  std::vector<std::byte> bytes(offset);
+  std::memcpy(
+      bytes.data() + sizeof(Header), entries.data(),
+      entries.size() * sizeof(Entry));
+  std::memcpy(bytes.data() + paths_offset, paths.data(), paths.size());
+  for (size_t i = 0; i < shards.size(); ++i) {
+    auto shard_bytes = shards[i].index->GetBytes();
+    std::memcpy(
+        bytes.data() + entries[i].shard_offset, shard_bytes.data(),
+        shard_bytes.size());
+    if (!shards[i].references.empty()) {
+      std::memcpy(
+          bytes.data() + entries[i].references_offset,
+          shards[i].references.data(), shards[i].references.size());
+    }
+  }
+  Header header{
+      .magic = kMagic,
+      .version = kVersion,
+      .checksum = ChecksumOf(bytes),
+      .file_count = static_cast<uint32_t>(entries.size()),
+      .path_bytes = static_cast<uint32_t>(paths.size()),
+      .total_bytes = bytes.size(),
+      .header_fingerprint = header_fingerprint};
+  std::memcpy(bytes.data(), &header, sizeof(Header));
+
+  auto temp_path = path;
+  temp_path += ".tmp";
+  {
+    std::ofstream out(temp_path, std::ios::binary | std::ios::trunc);
+    out.write(
+        reinterpret_cast<const char*>(bytes.data()),
+        static_cast<std::streamsize>(bytes.size()));
+    if (!out) {
+      std::error_code ec;
+      std::filesystem::remove(temp_path, ec);
+      return std::unexpected("Cannot write " + temp_path.string());
+    }
+  }
+  std::error_code ec;
+  std::filesystem::rename(temp_path, path, ec);
+  if (ec) {
+    std::filesystem::remove(temp_path, ec);
+    return std::unexpected(
+        fmt::format("Cannot rename to {}: {}", path.string(), ec.message()));
+  }
+  return entries.size();
+}
+
+auto IndexArtifact::Open(
+    const std::filesystem::path& path, const CanonicalPath& workspace_root)
+    -> std::expected<std::shared_ptr<const IndexArtifact>, std::string> {
+  auto mapped = utils::MappedFile::Open(path);
+  if (!mapped) {
+    return std::unexpected("Cannot open " + path.string());
+  }
+  auto bytes = mapped->Data();
+  if (bytes.size() < sizeof(Header)) {
+    return std::unexpected("Truncated index artifact");
+  }
+  const auto* header = reinterpret_cast<const Header*>(bytes.data());
+  if (header->magic != kMagic) {
+    return std::unexpected("Not an index artifact");
+  }
+  if (header->version != kVersion) {
+    return std::unexpected(
+        fmt::format(
+            "Index artifact version {} (expected {})", header->version,
+            kVersion));
+  }
+  if (header->total_bytes != bytes.size() ||
+      header->checksum != ChecksumOf(bytes)) {
+    return std::unexpected("Index artifact checksum mismatch");
+  }
+
+  // 64-bit arithmetic: counts come from an untrusted file
+  uint64_t paths_offset =
+      sizeof(Header) + (uint64_t{header->file_count} * sizeof(Entry));
+  if (paths_offset + header->path_bytes > bytes.size()) {
+    return std::unexpected("Corrupt index artifact");
+  }
+  std::span entries(
+      reinterpret_cast<const Entry*>(bytes.data() + sizeof(Header)),
+      header->file_count);
+  std::string_view paths(
+      reinterpret_cast<const char*>(bytes.data() + paths_offset),
+      header->path_bytes);
+
+  auto artifact = std::shared_ptr<IndexArtifact>(new IndexArtifact());
+  artifact->files_.reserve(entries.size());
+  for (const auto& entry : entries) {
+    if (uint64_t{entry.path_offset} + entry.path_length > paths.size() ||
+        entry.shard_offset % kAlignment != 0 ||
+        entry.shard_offset + entry.shard_size > bytes.size() ||
+        entry.references_offset % kAlignment != 0 ||
+        entry.references_offset + entry.references_size > bytes.size()) {
+      return std::unexpected("Corrupt index artifact");
+    }
+    auto relative = std::filesystem::path(
+        paths.substr(entry.path_offset, entry.path_length));
+    artifact->files_.emplace_back(
+        (workspace_root.Path() / relative).lexically_normal().string(),
+        &entry);
+  }
+  std::ranges::sort(
+      artifact->files_, {}, &std::pair<std::string, const Entry*>::first);
+
+  artifact->header_fingerprint_ = header->header_fingerprint;
+  artifact->root_uri_prefix_ = workspace_root.ToUri() + "/";
+  artifact->mapped_ =
+      std::make_shared<const utils::MappedFile>(std::move(*mapped));
+  return artifact;
+}
+
+auto IndexArtifact::Find(
+    std::string_view path, uint64_t content_hash, uint64_t options_key) const
+    -> std::shared_ptr<const FileIndex> {
+  const auto* entry = FindEntry(path, content_hash);
+  if (entry == nullptr) {
+    return nullptr;
+  }
+  auto shard = ShardOf(*entry);
+  if (!shard || !shard->Matches(content_hash, options_key)) {
+    return nullptr;
+  }
+  return shard;
+}
+
+auto IndexArtifact::FindReferences(
+    std::string_view path, uint64_t content_hash, uint64_t options_key) const
+    -> std::optional<ReferenceIndex::FileReferences> {
+  const auto* entry = FindEntry(path, content_hash);
+  if (entry == nullptr || entry->references_size == 0) {
+    return std::nullopt;
+  }
+  if (auto shard = ShardOf(*entry);
+      !shard || !shard->Matches(content_hash, options_key)) {
+    return std::nullopt;
+  }
+  return DecodeReferences(
+      mapped_->Data().subspan(
+          entry->references_offset, entry->references_size),
+      root_uri_prefix_);
+}
+
+auto IndexArtifact::ForEachSweptShard(
+    const std::function<void(
+        std::string_view path, std::shared_ptr<const FileIndex> shard)>&
+        callback) const -> void {
+  for (const auto& [path, entry] : files_) {
+    if (entry->references_size == 0) {
+      continue;
+    }
+    if (auto shard = ShardOf(*entry)) {
+      callback(path, std::move(shard));
+    }
+  }
+}
+
+auto IndexArtifact::FindEntry(std::string_view path, uint64_t content_hash)
+    const -> const Entry* {
+  auto it = std::ranges::lower_bound(
+      files_, path, {}, [](const auto& file) -> std::string_view {
+        return file.first;
+      });
+  if (it == files_.end() || it->first != path ||
+      it->second->content_hash != content_hash) {
+    return nullptr;
+  }
+  return it->second;
+}
+
+auto IndexArtifact::ShardOf(const Entry& entry) const
+    -> std::shared_ptr<const FileIndex> {
+  return FileIndex::FromBytes(
+      mapped_, mapped_->Data().subspan(entry.shard_offset, entry.shard_size));
+}
+
+}  // namespace slangd::services
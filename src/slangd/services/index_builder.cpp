@@ -0,0 +1,104 @@
+#include "slangd/services/index_builder.hpp"
+
+#include <algorithm>
+#include <optional>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "slangd/core/project_layout_service.hpp"
+#include "slangd/services/include_cache.hpp"
+#include "slangd/services/index_artifact.hpp"
+#include "slangd/services/open_document_tracker.hpp"
+#include "slangd/services/overlay_session.hpp"
+#include "slangd/services/preamble_manager.hpp"
+#include "slangd/services/reference_index.hpp"
+#include "slangd/services/session_manager.hpp"
+#include "slangd/services/workspace_index.hpp"
+#include "slangd/utils/scoped_timer.hpp"
+
+namespace slangd::services {
+
+IndexBuilder::IndexBuilder(
+    asio::any_io_executor executor, CanonicalPath workspace_root,
+    size_t thread_count, std::shared_ptr<spdlog::logger> logger)
+    : executor_(std::move(executor)),
+      workspace_root_(std::move(workspace_root)),
+      logger_(logger ? logger : spdlog::default_logger()) {
+  scheduler_ = std::make_shared<utils::PriorityScheduler>(
+      std::max<size_t>(thread_count, 1), logger_);
+}
+
+auto IndexBuilder::Run(std::filesystem::path path)
+    -> asio::awaitable<std::expected<IndexBuildSummary, std::string>> {
+  utils::ScopedTimer timer("Index build", logger_);
+  auto layout_service =
+      ProjectLayoutService::Create(executor_, workspace_root_, logger_);
+  co_await layout_service->LoadConfig(workspace_root_);
+
+  auto compilation_executor =
+      scheduler_->GetExecutor(utils::TaskPriority::kBackground);
+  auto preamble = co_await PreambleManager::CreateFromProjectLayout(
+      layout_service, compilation_executor, logger_);
+  if (!preamble) {
+    scheduler_->Join();
+    co_return std::unexpected(
+        fmt::format("Preamble creation failed: {}", preamble.error()));
+  }
+
+  // No previous snapshot or cache: every shard is collected, one task per
+  // file across the scheduler threads
+  auto index = co_await WorkspaceIndex::Build(
+      *preamble, nullptr, {}, compilation_executor, logger_);
+
+  std::vector<std::string> uris;
+  index->ForEachFile([&](std::string_view uri, const FileIndex& /*shard*/) {
+    uris.emplace_back(uri);
+  });
+  IndexArtifact::References references;
+  {
+    SessionManager session_manager(
+        executor_, layout_service, *preamble,
+        std::make_shared<OpenDocumentTracker>(), scheduler_,
+        std::make_shared<IncludeCache>(logger_), logger_);
+    std::vector<std::optional<ReferenceIndex::FileReferences>> collected(
+        uris.size());
+    co_await session_manager.SweepFiles(
+        uris, utils::TaskPriority::kBackground,
+        [&](size_t i, const OverlaySession& session) {
+          collected[i] = ReferenceIndex::Collect(session.GetSemanticIndex());
+        },
+        [&](size_t i, bool /*built*/) {
+          if (collected[i]) {
+            references.emplace(uris[i], std::move(*collected[i]));
+            collected[i].reset();
+          }
+        });
+    co_await session_manager.Shutdown();
+  }
+  scheduler_->Join();
+
+  std::error_code ec;
+  std::filesystem::create_directories(path.parent_path(), ec);
+  auto written = IndexArtifact::Write(
+      *index, references, (*preamble)->GetHeaderFingerprint(),
+      workspace_root_, path);
+  if (!written) {
+    co_return std::unexpected(written.error());
+  }
+
+  auto bytes = std::filesystem::file_size(path, ec);
+  IndexBuildSummary summary{
+      .files = *written,
+      .swept = references.size(),
+      .bytes = ec ? 0 : static_cast<size_t>(bytes)};
+  logger_->info(
+      "Indexed {} files ({} swept) with {} threads ({})", summary.files,
+      summary.swept, scheduler_->ThreadCount(),
+      utils::ScopedTimer::FormatDuration(timer.GetElapsed()));
+  co_return summary;
+}
+
+}  // namespace slangd::services
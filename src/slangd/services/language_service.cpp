@@ -1,5 +1,7 @@
 #include "slangd/services/language_service.hpp"
 
+#include <algorithm>
+
 #include <slang/ast/symbols/CompilationUnitSymbols.h>
 #include <slang/diagnostics/DiagnosticEngine.h>
 #include <slang/syntax/SyntaxTree.h>
@@ -10,6 +12,7 @@
 #include "slangd/utils/canonical_path.hpp"
 #include "slangd/utils/compilation_options.hpp"
 #include "slangd/utils/path_utils.hpp"
+#include "slangd/utils/position_mapper.hpp"
 #include "slangd/utils/scoped_timer.hpp"
 
 namespace slangd::services {
@@ -19,17 +22,23 @@ using lsp::error::LspError;
 LanguageService::LanguageService(
     asio::any_io_executor executor, std::shared_ptr<spdlog::logger> logger)
     : preamble_manager_(nullptr),
+      preamble_cache_(std::make_shared<PreambleCache>(logger)),
+      include_cache_(std::make_shared<IncludeCache>(logger)),
       logger_(logger ? logger : spdlog::default_logger()),
       executor_(executor),
       open_tracker_(std::make_shared<OpenDocumentTracker>()),
       doc_state_(executor, open_tracker_),
       config_ready_(executor),
       workspace_ready_(executor),
-      compilation_pool_(
-          std::make_unique<asio::thread_pool>(GetThreadPoolSize())) {
+      scheduler_(std::make_shared<utils::PriorityScheduler>(
+          utils::PriorityScheduler::DefaultThreadCount(), logger_)) {
   logger_->debug(
       "LanguageService created with {} compilation threads",
-      GetThreadPoolSize());
+      scheduler_->ThreadCount());
+}
+
+LanguageService::~LanguageService() {
+  scheduler_->Join();
 }
 
 auto LanguageService::CreateDiagnosticHook(std::string uri, int version)
@@ -62,6 +71,23 @@ auto LanguageService::CreateDiagnosticHook(std::string uri, int version)
   };
 }
 
+auto LanguageService::CreateReferenceHook(std::string uri)
+    -> std::function<void(const OverlaySession&)> {
+  return [this, uri = std::move(uri)](const OverlaySession& session) {
+    // Copy out on the strand; the index itself lives on the main executor
+    auto references = ReferenceIndex::Collect(session.GetSemanticIndex());
+    asio::post(
+        executor_,
+        [this, uri, references = std::move(references)]() mutable {
+          // Closed while the session was building
+          if (open_tracker_->Contains(uri)) {
+            reference_index_.Update(
+                uri, ReferenceIndex::Layer::kOverlay, std::move(references));
+          }
+        });
+  };
+}
+
 auto LanguageService::InitializeWorkspace(std::string workspace_uri)
     -> asio::awaitable<void> {
   utils::ScopedTimer timer("Workspace initialization", logger_);
@@ -76,6 +102,7 @@ auto LanguageService::InitializeWorkspace(std::string workspace_uri)
   layout_service_ =
       ProjectLayoutService::Create(executor_, workspace_root_, logger_);
   co_await layout_service_->LoadConfig(workspace_root_);
+  co_await LoadIndexArtifact();
 
   // Config loaded: syntax features can now use defines for ifdef/ifndef
   // handling
@@ -83,7 +110,9 @@ auto LanguageService::InitializeWorkspace(std::string workspace_uri)
   logger_->debug("LanguageService config loaded (syntax features ready)");
 
   auto preamble_result = co_await PreambleManager::CreateFromProjectLayout(
-      layout_service_, compilation_pool_->get_executor(), logger_);
+      layout_service_,
+      scheduler_->GetExecutor(utils::TaskPriority::kBackground), logger_,
+      preamble_cache_);
 
   if (!preamble_result) {
     logger_->warn(
@@ -100,7 +129,8 @@ auto LanguageService::InitializeWorkspace(std::string workspace_uri)
   }
 
   session_manager_ = std::make_unique<SessionManager>(
-      executor_, layout_service_, preamble_manager_, open_tracker_, logger_);
+      executor_, layout_service_, preamble_manager_, open_tracker_, scheduler_,
+      include_cache_, logger_);
 
   // Notify status: indexing completed
   if (status_publisher_) {
@@ -110,6 +140,8 @@ auto LanguageService::InitializeWorkspace(std::string workspace_uri)
   // Signal workspace ready - wakes all waiting handlers
   workspace_ready_.Set();
 
+  ScheduleWorkspaceIndexBuild();
+
   auto elapsed = timer.GetElapsed();
   logger_->info(
       "LanguageService workspace initialized: {} ({})", workspace_uri,
@@ -129,15 +161,16 @@ auto LanguageService::ComputeParseDiagnostics(
       uri);
 
   // Build single-file compilation and extract diagnostics in thread pool
+  // (interactive: runs ahead of queued preamble work)
   auto diagnostics = co_await asio::co_spawn(
-      compilation_pool_->get_executor(),
+      scheduler_->GetExecutor(utils::TaskPriority::kFocused),
       [this, uri, content]() -> asio::awaitable<std::vector<lsp::Diagnostic>> {
         // Build parse-only compilation (no preamble_manager → single file only)
         auto [source_manager, compilation, main_buffer_id] =
             OverlaySession::BuildCompilation(
                 uri, content, layout_service_,
                 nullptr,  // Single-file mode
-                logger_);
+                logger_, include_cache_);
 
         // Keep as unique_ptr - temporary use, destroyed after extraction
         co_return semantic::DiagnosticConverter::ExtractParseDiagnostics(
@@ -163,10 +196,21 @@ auto LanguageService::GetDefinitionsForPosition(
   // Wait for workspace initialization to complete
   co_await workspace_ready_.AsyncWait(asio::use_awaitable);
 
-  auto result = co_await session_manager_->WithSession(
-      uri, [this, uri, position](const OverlaySession& session) {
-        auto def_loc_opt =
-            session.GetSemanticIndex().LookupDefinitionAt(uri, position);
+  // Answered from the previous session while an edit is being rebuilt
+  auto result = co_await session_manager_->WithSnapshot(
+      uri, [this, uri, position](
+               const OverlaySession& session,
+               const utils::PositionMapper& mapper) {
+        auto session_position = mapper.ToOld(position);
+        if (!session_position) {
+          logger_->debug(
+              "Position {}:{} in {} is in text edited since the last build",
+              position.line, position.character, uri);
+          return std::vector<lsp::Location>{};
+        }
+
+        auto def_loc_opt = session.GetSemanticIndex().LookupDefinitionAt(
+            uri, *session_position);
 
         if (!def_loc_opt) {
           logger_->debug(
@@ -175,6 +219,14 @@ auto LanguageService::GetDefinitionsForPosition(
           return std::vector<lsp::Location>{};
         }
 
+        if (def_loc_opt->uri == uri) {
+          auto range = mapper.ToNew(def_loc_opt->range);
+          if (!range) {
+            return std::vector<lsp::Location>{};
+          }
+          def_loc_opt->range = *range;
+        }
+
         return std::vector<lsp::Location>{*def_loc_opt};
       });
 
@@ -188,6 +240,78 @@ auto LanguageService::GetDefinitionsForPosition(
   co_return *result;
 }
 
+auto LanguageService::GetReferences(
+    std::string uri, lsp::Position position, bool include_declaration)
+    -> asio::awaitable<std::expected<std::vector<lsp::Location>, LspError>> {
+  utils::ScopedTimer timer("GetReferences", logger_);
+
+  // Wait for workspace initialization to complete
+  co_await workspace_ready_.AsyncWait(asio::use_awaitable);
+
+  // Resolve the symbol under the cursor to its definition, which is the
+  // identity references are indexed by. While an edit is being rebuilt the
+  // previous session answers; its overlay references are still the ones
+  // indexed for this file, so results here are mapped to the current text.
+  auto lookup = co_await session_manager_->WithSnapshot(
+      uri, [uri, position](
+               const OverlaySession& session,
+               const utils::PositionMapper& mapper) {
+        auto session_position = mapper.ToOld(position);
+        auto definition =
+            session_position
+                ? session.GetSemanticIndex().LookupDefinitionAt(
+                      uri, *session_position)
+                : std::nullopt;
+        return std::make_pair(definition, mapper);
+      });
+  co_await asio::post(executor_, asio::use_awaitable);
+
+  if (!lookup || !lookup->first) {
+    logger_->debug(
+        "No symbol found at position {}:{} in {}", position.line,
+        position.character, uri);
+    co_return std::vector<lsp::Location>{};
+  }
+
+  const auto& [definition, mapper] = *lookup;
+  auto references = reference_index_.FindReferences(
+      definition->uri, definition->range, include_declaration);
+  if (mapper.IsIdentity()) {
+    co_return references;
+  }
+
+  std::vector<lsp::Location> mapped;
+  mapped.reserve(references.size());
+  for (auto& location : references) {
+    if (location.uri == uri) {
+      auto range = mapper.ToNew(location.range);
+      if (!range) {
+        continue;
+      }
+      location.range = *range;
+    }
+    mapped.push_back(std::move(location));
+  }
+  co_return mapped;
+}
+
+auto LanguageService::GetWorkspaceSymbols(std::string query)
+    -> asio::awaitable<
+        std::expected<std::vector<lsp::WorkspaceSymbol>, LspError>> {
+  utils::ScopedTimer timer("GetWorkspaceSymbols", logger_);
+
+  // Wait for workspace initialization to complete
+  co_await workspace_ready_.AsyncWait(asio::use_awaitable);
+
+  // Index not built yet (first background build still running)
+  if (!workspace_index_) {
+    logger_->debug("GetWorkspaceSymbols: workspace index not ready");
+    co_return std::vector<lsp::WorkspaceSymbol>{};
+  }
+
+  co_return workspace_index_->SearchSymbols(query, kMaxWorkspaceSymbols);
+}
+
 auto LanguageService::GetDocumentSymbols(std::string uri) -> asio::awaitable<
     std::expected<std::vector<lsp::DocumentSymbol>, lsp::error::LspError>> {
   utils::ScopedTimer timer("GetDocumentSymbols (syntax)", logger_);
@@ -245,8 +369,13 @@ auto LanguageService::RebuildWorkspace() -> asio::awaitable<void> {
   }
 
   // Rebuild PreambleManager with current configuration
+  // Cached syntax trees are reused unless a loaded file's content changed,
+  // which reparses everything (see PreambleCache)
+  bool preamble_unchanged = false;
   auto preamble_result = co_await PreambleManager::CreateFromProjectLayout(
-      layout_service_, compilation_pool_->get_executor(), logger_);
+      layout_service_,
+      scheduler_->GetExecutor(utils::TaskPriority::kBackground), logger_,
+      preamble_cache_);
 
   if (!preamble_result) {
     logger_->warn(
@@ -254,6 +383,14 @@ auto LanguageService::RebuildWorkspace() -> asio::awaitable<void> {
         "preamble)",
         preamble_result.error());
     preamble_manager_ = nullptr;
+  } else if (
+      preamble_manager_ && (*preamble_result)->GetContentFingerprint() ==
+                               preamble_manager_->GetContentFingerprint()) {
+    // Same options and file contents (touch, no-op save, checkout round
+    // trip): existing sessions stay valid, drop the equivalent rebuild
+    preamble_unchanged = true;
+    logger_->info(
+        "LanguageService preamble inputs unchanged, keeping existing sessions");
   } else {
     // Move from result to avoid holding extra shared_ptr copy
     preamble_manager_ = std::move(*preamble_result);
@@ -266,16 +403,23 @@ auto LanguageService::RebuildWorkspace() -> asio::awaitable<void> {
     // Atomic swap - await to ensure update completes before invalidation
     co_await session_manager_->UpdatePreambleManager(preamble_manager_);
     co_await session_manager_->InvalidateAllSessions();
+
+    // Only files whose content changed are re-indexed, and only files
+    // affected by those changes are swept for references
+    ScheduleWorkspaceIndexBuild();
   }
 
   // Rebuild overlays with new preamble for accurate diagnostics
   // Client doesn't know preamble was rebuilt, so we must push updates
-  for (const auto& uri : co_await doc_state_.GetAllUris()) {
-    auto state = co_await doc_state_.Get(uri);
-    if (state) {
-      co_await session_manager_->UpdateSession(
-          uri, state->content, state->version,
-          CreateDiagnosticHook(uri, state->version));
+  if (!preamble_unchanged) {
+    for (const auto& uri : co_await doc_state_.GetAllUris()) {
+      auto state = co_await doc_state_.Get(uri);
+      if (state) {
+        co_await session_manager_->UpdateSession(
+            uri, state->content, state->version, PriorityFor(uri),
+            CreateDiagnosticHook(uri, state->version),
+            CreateReferenceHook(uri));
+      }
     }
   }
 
@@ -297,6 +441,168 @@ auto LanguageService::RebuildWorkspace() -> asio::awaitable<void> {
   }
 }
 
+auto LanguageService::LoadIndexArtifact() -> asio::awaitable<void> {
+  auto path = IndexArtifact::DefaultPath(workspace_root_);
+  std::error_code ec;
+  if (!std::filesystem::exists(path, ec)) {
+    co_return;
+  }
+
+  // Open verifies the checksum, which reads the whole file
+  auto artifact = co_await asio::co_spawn(
+      scheduler_->GetExecutor(utils::TaskPriority::kBackground),
+      [&]() -> asio::awaitable<
+                std::expected<std::shared_ptr<const IndexArtifact>,
+                              std::string>> {
+        co_return IndexArtifact::Open(path, workspace_root_);
+      },
+      asio::use_awaitable);
+  if (!artifact) {
+    logger_->warn(
+        "Ignoring index artifact {}: {}", path.string(), artifact.error());
+    co_return;
+  }
+  index_artifact_ = *artifact;
+  logger_->info(
+      "Loaded index artifact {} ({} files)", path.string(),
+      index_artifact_->FileCount());
+}
+
+auto LanguageService::ScheduleWorkspaceIndexBuild() -> void {
+  auto generation = ++workspace_index_generation_;
+  asio::co_spawn(
+      executor_,
+      [this, generation,
+       preamble = preamble_manager_]() -> asio::awaitable<void> {
+        // Speculative: nothing waits on the index, so it yields to preamble
+        // and session work
+        auto index = co_await WorkspaceIndex::Build(
+            preamble, workspace_index_,
+            WorkspaceIndex::DefaultCacheDirectory(workspace_root_),
+            scheduler_->GetExecutor(utils::TaskPriority::kSpeculative),
+            logger_, index_artifact_);
+
+        // A newer preamble scheduled another build meanwhile
+        if (generation == workspace_index_generation_) {
+          workspace_index_ = index;
+          auto header_fingerprint =
+              preamble ? preamble->GetHeaderFingerprint() : 0;
+          ScheduleReferenceSweep(std::move(index), header_fingerprint);
+        }
+      },
+      asio::detached);
+}
+
+auto LanguageService::ScheduleReferenceSweep(
+    std::shared_ptr<const WorkspaceIndex> index, uint64_t header_fingerprint)
+    -> void {
+  auto generation = ++reference_sweep_generation_;
+  asio::co_spawn(
+      executor_,
+      [this, generation, index = std::move(index),
+       header_fingerprint]() -> asio::awaitable<void> {
+        utils::ScopedTimer timer("Reference sweep", logger_);
+        if (!swept_index_ && index_artifact_) {
+          co_await ImportArtifactReferences(index);
+        }
+        // Shards only cover each file's own text: after a header change
+        // any file may bind differently
+        std::vector<std::string> uris;
+        if (swept_index_ && header_fingerprint == swept_header_fingerprint_) {
+          uris = index->FilesAffectedSince(*swept_index_);
+        } else {
+          index->ForEachFile(
+              [&](std::string_view uri, const FileIndex& /*shard*/) {
+                uris.emplace_back(uri);
+              });
+        }
+        size_t indexed = 0;
+
+        // keep_going is checked between files, so a newer sweep is noticed
+        // without waiting for the whole list
+        std::vector<std::optional<ReferenceIndex::FileReferences>> references(
+            uris.size());
+        co_await session_manager_->SweepFiles(
+            uris, utils::TaskPriority::kSpeculative,
+            [&](size_t i, const OverlaySession& session) {
+              references[i] =
+                  ReferenceIndex::Collect(session.GetSemanticIndex());
+            },
+            [&](size_t i, bool /*built*/) {
+              if (references[i] && generation == reference_sweep_generation_) {
+                reference_index_.Update(
+                    uris[i], ReferenceIndex::Layer::kBackground,
+                    std::move(*references[i]));
+                ++indexed;
+              }
+              references[i].reset();
+            },
+            {.max_workers = std::max<size_t>(
+                 1, scheduler_->ThreadCount() / kSweepThreadDivisor),
+             .keep_going = [&] {
+               return generation == reference_sweep_generation_;
+             }});
+
+        if (generation != reference_sweep_generation_) {
+          logger_->debug("Reference sweep superseded by a newer one");
+          co_return;
+        }
+
+        slang::flat_hash_set<std::string> live;
+        index->ForEachFile(
+            [&](std::string_view uri, const FileIndex& /*shard*/) {
+              live.emplace(uri);
+            });
+        reference_index_.RetainBackground(live);
+        swept_index_ = index;
+        swept_header_fingerprint_ = header_fingerprint;
+        logger_->info(
+            "Reference sweep indexed {}/{} affected files of {} ({} "
+            "references, {})",
+            indexed, uris.size(), live.size(),
+            reference_index_.ReferenceCount(),
+            utils::ScopedTimer::FormatDuration(timer.GetElapsed()));
+      },
+      asio::detached);
+}
+
+auto LanguageService::ImportArtifactReferences(
+    std::shared_ptr<const WorkspaceIndex> index) -> asio::awaitable<void> {
+  using Imported =
+      std::vector<std::pair<std::string, ReferenceIndex::FileReferences>>;
+  auto artifact = index_artifact_;
+
+  // Decoding is linear in the references; kept off the LSP executor
+  auto [base, imported] = co_await asio::co_spawn(
+      scheduler_->GetExecutor(utils::TaskPriority::kSpeculative),
+      [&]() -> asio::awaitable<
+                std::pair<std::shared_ptr<const WorkspaceIndex>, Imported>> {
+        Imported found;
+        index->ForEachFile([&](std::string_view uri, const FileIndex& shard) {
+          if (auto references = artifact->FindReferences(
+                  UriToPath(uri).string(), shard.GetContentHash(),
+                  shard.GetOptionsKey())) {
+            found.emplace_back(uri, std::move(*references));
+          }
+        });
+        co_return std::pair(
+            WorkspaceIndex::FromArtifact(*artifact), std::move(found));
+      },
+      asio::use_awaitable);
+  co_await asio::post(executor_, asio::use_awaitable);
+
+  for (auto& [uri, references] : imported) {
+    reference_index_.Update(
+        uri, ReferenceIndex::Layer::kBackground, std::move(references));
+  }
+  // Files that changed, or bind names that did, are swept against this
+  swept_index_ = std::move(base);
+  swept_header_fingerprint_ = artifact->GetHeaderFingerprint();
+  logger_->info(
+      "Imported references of {}/{} files from the index artifact",
+      imported.size(), swept_index_->GetStats().files);
+}
+
 auto LanguageService::HandleConfigChange() -> asio::awaitable<void> {
   co_await workspace_ready_.AsyncWait(asio::use_awaitable);
 
@@ -358,6 +664,12 @@ auto LanguageService::HandleSourceFileChange(
       break;
   }
 
+  // Cached syntax trees are re-validated by content hash on rebuild, but
+  // untracked files (includes) must invalidate the cache generation.
+  // Overlays read a changed include from disk again on their next build.
+  preamble_cache_->Invalidate(path);
+  include_cache_->Invalidate(path);
+
   // Schedule workspace rebuild (debounced for rapid git operations)
   // Rebuilds overlays first for fast feedback, then preamble
   ScheduleWorkspaceRebuild();
@@ -365,37 +677,45 @@ auto LanguageService::HandleSourceFileChange(
 
 // Document lifecycle events (protocol-level API)
 auto LanguageService::OnDocumentOpened(
-    std::string uri, std::string content, int version)
+    std::string uri, std::string content, int version, uint64_t request_id)
     -> asio::awaitable<void> {
   // Store document state first
   co_await doc_state_.Update(uri, content, version);
+  focused_uri_ = uri;
 
   // Wait for workspace initialization to complete
   co_await workspace_ready_.AsyncWait(asio::use_awaitable);
 
   // Create session with diagnostic hook
   co_await session_manager_->UpdateSession(
-      uri, content, version, CreateDiagnosticHook(uri, version));
+      uri, content, version, PriorityFor(uri),
+      CreateDiagnosticHook(uri, version), CreateReferenceHook(uri), request_id);
 }
 
 auto LanguageService::OnDocumentChanged(
-    std::string uri, std::string content, int version)
-    -> asio::awaitable<void> {
+    std::string uri, std::vector<lsp::TextDocumentContentChangeEvent> changes,
+    int version, uint64_t request_id) -> asio::awaitable<void> {
+  // Apply edits before any other suspension point: incremental changes must
+  // land in the order the client sent them
+  if (!co_await doc_state_.ApplyChanges(uri, std::move(changes), version)) {
+    logger_->warn("OnDocumentChanged: document not open: {}", uri);
+    co_return;
+  }
+  focused_uri_ = uri;
+
   // Wait for workspace initialization to complete
   co_await workspace_ready_.AsyncWait(asio::use_awaitable);
 
-  // Store document state
-  co_await doc_state_.Update(uri, content, version);
-
   // Schedule debounced session rebuild with diagnostics
-  ScheduleSessionRebuild(uri);
+  ScheduleSessionRebuild(uri, request_id);
 }
 
-auto LanguageService::RebuildSessionWithDiagnostics(std::string uri)
-    -> asio::awaitable<void> {
+auto LanguageService::RebuildSessionWithDiagnostics(
+    std::string uri, uint64_t request_id) -> asio::awaitable<void> {
   // Protection: Don't start if already rebuilding
   if (session_rebuild_state_[uri] != RebuildState::kIdle) {
     session_rebuild_state_[uri] = RebuildState::kPendingNext;
+    session_rebuild_next_request_[uri] = request_id;
     logger_->debug(
         "Session rebuild in progress for {}, marked as pending", uri);
     co_return;
@@ -413,8 +733,9 @@ auto LanguageService::RebuildSessionWithDiagnostics(std::string uri)
 
   // Rebuild session with diagnostic hook
   co_await session_manager_->UpdateSession(
-      uri, doc_state->content, doc_state->version,
-      CreateDiagnosticHook(uri, doc_state->version));
+      uri, doc_state->content, doc_state->version, PriorityFor(uri),
+      CreateDiagnosticHook(uri, doc_state->version), CreateReferenceHook(uri),
+      request_id);
 
   // Check if more changes happened during rebuild
   if (session_rebuild_state_[uri] == RebuildState::kPendingNext) {
@@ -423,10 +744,11 @@ auto LanguageService::RebuildSessionWithDiagnostics(std::string uri)
         "More changes happened during rebuild for {}, rebuilding immediately",
         uri);
     // Rebuild immediately - debounce already happened when timer fired
+    auto next_request = session_rebuild_next_request_[uri];
     asio::co_spawn(
         executor_,
-        [this, uri]() -> asio::awaitable<void> {
-          co_await RebuildSessionWithDiagnostics(uri);
+        [this, uri, next_request]() -> asio::awaitable<void> {
+          co_await RebuildSessionWithDiagnostics(uri, next_request);
         },
         asio::detached);
   } else {
@@ -434,7 +756,8 @@ auto LanguageService::RebuildSessionWithDiagnostics(std::string uri)
   }
 }
 
-auto LanguageService::ScheduleSessionRebuild(std::string uri) -> void {
+auto LanguageService::ScheduleSessionRebuild(
+    std::string uri, uint64_t request_id) -> void {
   logger_->debug(
       "Scheduling session rebuild for {} ({}ms delay)", uri,
       kSessionDebounceDelay.count());
@@ -450,20 +773,20 @@ auto LanguageService::ScheduleSessionRebuild(std::string uri) -> void {
   auto [timer_it, inserted] =
       session_rebuild_timers_.try_emplace(uri, executor_);
   timer_it->second.expires_after(kSessionDebounceDelay);
-  timer_it->second.async_wait([this, uri](std::error_code ec) {
+  timer_it->second.async_wait([this, uri, request_id](std::error_code ec) {
     if (!ec) {
       logger_->debug("Session timer expired for {}, triggering rebuild", uri);
       asio::co_spawn(
           executor_,
-          [this, uri]() -> asio::awaitable<void> {
-            co_await RebuildSessionWithDiagnostics(uri);
+          [this, uri, request_id]() -> asio::awaitable<void> {
+            co_await RebuildSessionWithDiagnostics(uri, request_id);
           },
           asio::detached);
     }
   });
 }
 
-auto LanguageService::OnDocumentSaved(std::string uri)
+auto LanguageService::OnDocumentSaved(std::string uri, uint64_t request_id)
     -> asio::awaitable<void> {
   // Wait for workspace initialization to complete
   co_await workspace_ready_.AsyncWait(asio::use_awaitable);
@@ -482,9 +805,11 @@ auto LanguageService::OnDocumentSaved(std::string uri)
   }
 
   // Rebuild overlay session only (preamble handled by file watcher)
+  focused_uri_ = uri;
   co_await session_manager_->UpdateSession(
-      uri, doc_state->content, doc_state->version,
-      CreateDiagnosticHook(uri, doc_state->version));
+      uri, doc_state->content, doc_state->version, PriorityFor(uri),
+      CreateDiagnosticHook(uri, doc_state->version), CreateReferenceHook(uri),
+      request_id);
 }
 
 auto LanguageService::OnDocumentClosed(std::string uri) -> void {
@@ -502,6 +827,11 @@ auto LanguageService::OnDocumentClosed(std::string uri) -> void {
 
   // Clean up rebuild state
   session_rebuild_state_.erase(uri);
+  session_rebuild_next_request_.erase(uri);
+
+  // Fall back to the saved content's references
+  reference_index_.Remove(uri, ReferenceIndex::Layer::kOverlay);
+  include_cache_->Forget(uri);
 
   // Cancel pending compilation to prevent unbounded memory accumulation
   // (preview mode spam defense - see docs/SESSION_MANAGEMENT.md)
@@ -5,8 +5,10 @@
 #include <slang/parsing/Preprocessor.h>
 #include <slang/syntax/SyntaxTree.h>
 #include <slang/util/Bag.h>
+#include <slang/util/BumpAllocator.h>
 
 #include "slangd/semantic/semantic_index.hpp"
+#include "slangd/syntax/identifier_collector.hpp"
 #include "slangd/utils/canonical_path.hpp"
 #include "slangd/utils/compilation_options.hpp"
 #include "slangd/utils/scoped_timer.hpp"
@@ -16,29 +18,46 @@ namespace slangd::services {
 namespace {
 
 // PreambleAwareCompilation: Subclass for cross-compilation symbol binding
-// Directly populates protected packageMap with preamble PackageSymbol pointers
-// Note: getPackage() is NOT virtual, so we cannot override it. Instead, we
-// populate the packageMap directly, which getPackage() uses for lookups.
+// Directly populates protected packageMap/definitionMap with preamble symbol
+// pointers. getPackage()/getDefinition() are NOT virtual, so lookups can't be
+// redirected to the preamble maps; instead only the root symbols the buffer
+// can reach are bound (see PreambleManager::CollectReachableSymbols), which
+// keeps session creation independent of project size.
 class PreambleAwareCompilation : public slang::ast::Compilation {
  public:
   PreambleAwareCompilation(
       const slang::Bag& options,
-      std::shared_ptr<const PreambleManager> preamble_manager)
+      std::shared_ptr<const PreambleManager> preamble_manager,
+      const slang::syntax::SyntaxTree* buffer_tree)
       : Compilation(options), preamble_manager_(std::move(preamble_manager)) {
     const auto& overlay_root = getRootNoFinalize();
 
-    // Bulk copy preamble maps for cross-compilation
-    packageMap = preamble_manager_->GetPackageMap();
+    slang::flat_hash_set<std::string_view> names;
+    if (buffer_tree != nullptr) {
+      syntax::CollectIdentifiers(buffer_tree->root(), names);
+    }
 
-    // Re-key definitionMap with overlay's root scope
-    for (const auto& [key, val] : preamble_manager_->GetDefinitionMap()) {
-      definitionMap[{std::get<0>(key), &overlay_root}] = val;
+    // Definitions are re-keyed with overlay's root scope
+    for (const auto* symbol :
+         preamble_manager_->CollectReachableSymbols(names)) {
+      if (symbol->package != nullptr) {
+        packageMap[symbol->name] = symbol->package;
+      }
+      if (symbol->definition) {
+        definitionMap[{symbol->name, &overlay_root}] = *symbol->definition;
+      }
+      requires_serial_elaboration_ |= symbol->mutable_on_use;
     }
   }
 
+  [[nodiscard]] auto RequiresSerialElaboration() const -> bool {
+    return requires_serial_elaboration_;
+  }
+
  private:
   // Keep preamble alive for the lifetime of this compilation
   std::shared_ptr<const PreambleManager> preamble_manager_;
+  bool requires_serial_elaboration_ = false;
 };
 
 }  // anonymous namespace
@@ -75,7 +94,8 @@ auto OverlaySession::Create(
   auto elapsed = timer.GetElapsed();
   auto entry_count = semantic_index->GetSemanticEntries().size();
   logger->debug(
-      "Overlay session created with {} semantic entries ({})", entry_count,
+      "Overlay session created with {} semantic entries, {} KB index ({})",
+      entry_count, semantic_index->MemoryUsage() / 1024,
       utils::ScopedTimer::FormatDuration(elapsed));
 
   return std::shared_ptr<OverlaySession>(new OverlaySession(
@@ -110,11 +130,29 @@ OverlaySession::OverlaySession(
       preamble_manager_(std::move(preamble_manager)) {
 }
 
+auto OverlaySession::MemoryUsage() const -> size_t {
+  size_t source_bytes = 0;
+  for (auto buffer : source_manager_->getAllBuffers()) {
+    source_bytes += source_manager_->getSourceText(buffer).size();
+  }
+  return compilation_->getAllocatedBytes() + source_bytes +
+         semantic_index_->MemoryUsage();
+}
+
+auto OverlaySession::RequiresSerialElaboration(
+    const slang::ast::Compilation& compilation) -> bool {
+  const auto* preamble_aware =
+      dynamic_cast<const PreambleAwareCompilation*>(&compilation);
+  return preamble_aware != nullptr &&
+         preamble_aware->RequiresSerialElaboration();
+}
+
 auto OverlaySession::BuildCompilation(
     std::string uri, std::string content,
     std::shared_ptr<ProjectLayoutService> layout_service,
     std::shared_ptr<const PreambleManager> preamble_manager,
-    std::shared_ptr<spdlog::logger> logger)
+    std::shared_ptr<spdlog::logger> logger,
+    std::shared_ptr<IncludeCache> include_cache)
     -> std::tuple<
         std::shared_ptr<slang::SourceManager>,
         std::unique_ptr<slang::ast::Compilation>, slang::BufferID> {
@@ -146,22 +184,32 @@ auto OverlaySession::BuildCompilation(
   // Get file path for deduplication (needed before creating compilation)
   auto file_path = CanonicalPath::FromUri(uri);
 
+  // Parse current buffer content first (authoritative). Its identifiers
+  // decide which preamble symbols the compilation binds.
+  auto buffer = source_manager->assignText(file_path.String(), content);
+  auto main_buffer_id = buffer.id;
+
+  // Includes of the previous build are served from memory
+  uint64_t include_generation = 0;
+  if (include_cache) {
+    include_generation = include_cache->Seed(uri, *source_manager);
+  }
+  auto buffer_tree =
+      slang::syntax::SyntaxTree::fromBuffer(buffer, *source_manager, options);
+  if (include_cache) {
+    include_cache->Record(uri, *source_manager, include_generation);
+  }
+
   // Create compilation with options
   // Use PreambleAwareCompilation when preamble available for cross-compilation
   std::unique_ptr<slang::ast::Compilation> compilation;
   if (preamble_manager) {
-    compilation =
-        std::make_unique<PreambleAwareCompilation>(options, preamble_manager);
+    compilation = std::make_unique<PreambleAwareCompilation>(
+        options, preamble_manager, buffer_tree.get());
   } else {
     compilation = std::make_unique<slang::ast::Compilation>(options);
   }
 
-  // Add current buffer content (authoritative)
-  auto buffer = source_manager->assignText(file_path.String(), content);
-  auto main_buffer_id = buffer.id;
-  auto buffer_tree =
-      slang::syntax::SyntaxTree::fromBuffer(buffer, *source_manager, options);
-
   if (buffer_tree) {
     compilation->addSyntaxTree(buffer_tree);
   } else {
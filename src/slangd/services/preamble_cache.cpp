@@ -0,0 +1,211 @@
+#include "slangd/services/preamble_cache.hpp"
+
+#include <slang/syntax/SyntaxTree.h>
+#include <slang/text/SourceManager.h>
+
+#include "slangd/utils/hash.hpp"
+#include "slangd/utils/metrics.hpp"
+
+namespace slangd::services {
+
+namespace {
+
+// Preamble buffers start at 1024 to avoid collisions with overlay buffers
+constexpr uint32_t kPreambleBufferIdOffset = 1024;
+
+// Don't recycle a generation for small amounts of dead buffers
+constexpr size_t kMinDeadBytesForRecycle = size_t{16} * 1024 * 1024;
+
+// Lookup() runs once per file of every preamble build
+auto LookupCounter(bool hit) -> utils::Counter& {
+  static auto& hits =
+      utils::Metrics::Instance().GetCounter("preamble_cache.hits");
+  static auto& misses =
+      utils::Metrics::Instance().GetCounter("preamble_cache.misses");
+  return hit ? hits : misses;
+}
+
+}  // namespace
+
+PreambleCache::PreambleCache(
+    std::shared_ptr<spdlog::logger> logger, size_t max_bytes)
+    : max_bytes_(max_bytes),
+      logger_(logger ? logger : spdlog::default_logger()) {
+}
+
+auto PreambleCache::ComputeOptionsKey(
+    const std::vector<CanonicalPath>& include_dirs,
+    const std::vector<std::string>& defines) -> uint64_t {
+  uint64_t key = utils::HashBytes("slangd-preamble-options");
+  for (const auto& dir : include_dirs) {
+    key = utils::HashCombine(key, utils::HashBytes(dir.Path().string()));
+  }
+  // Separator so moving an entry between the lists changes the key
+  key = utils::HashCombine(key, include_dirs.size());
+  for (const auto& define : defines) {
+    key = utils::HashCombine(key, utils::HashBytes(define));
+  }
+  return utils::HashCombine(key, defines.size());
+}
+
+auto PreambleCache::BeginBuild(uint64_t options_key)
+    -> std::shared_ptr<slang::SourceManager> {
+  std::lock_guard lock(mutex_);
+  ++build_counter_;
+
+  if (!generation_valid_ || options_key != options_key_) {
+    if (generation_valid_) {
+      logger_->debug("PreambleCache: options changed, starting new generation");
+    }
+    options_key_ = options_key;
+    ResetGenerationLocked();
+  }
+
+  return source_manager_;
+}
+
+auto PreambleCache::ProbeHash(
+    const CanonicalPath& path, std::filesystem::file_time_type mtime,
+    size_t size) const -> std::optional<uint64_t> {
+  std::lock_guard lock(mutex_);
+  auto it = entries_.find(path.Path().string());
+  if (it == entries_.end() || it->second.dirty ||
+      it->second.mtime != mtime || it->second.content_size != size) {
+    return std::nullopt;
+  }
+  return it->second.content_hash;
+}
+
+auto PreambleCache::HasConflict(
+    const CanonicalPath& path, uint64_t content_hash) const -> bool {
+  std::lock_guard lock(mutex_);
+  auto it = entries_.find(path.Path().string());
+  return it != entries_.end() && it->second.content_hash != content_hash;
+}
+
+auto PreambleCache::StartNewGeneration()
+    -> std::shared_ptr<slang::SourceManager> {
+  std::lock_guard lock(mutex_);
+  ResetGenerationLocked();
+  return source_manager_;
+}
+
+auto PreambleCache::Lookup(
+    const CanonicalPath& path, uint64_t content_hash,
+    std::filesystem::file_time_type mtime)
+    -> std::shared_ptr<slang::syntax::SyntaxTree> {
+  std::lock_guard lock(mutex_);
+  auto it = entries_.find(path.Path().string());
+  if (it == entries_.end() || it->second.content_hash != content_hash) {
+    ++stats_.misses;
+    LookupCounter(false).Add();
+    return nullptr;
+  }
+
+  ++stats_.hits;
+  LookupCounter(true).Add();
+  it->second.last_used_build = build_counter_;
+  it->second.mtime = mtime;
+  it->second.dirty = false;
+  return it->second.tree;
+}
+
+auto PreambleCache::Insert(
+    const CanonicalPath& path, uint64_t content_hash, size_t content_size,
+    std::filesystem::file_time_type mtime,
+    std::shared_ptr<slang::syntax::SyntaxTree> tree) -> void {
+  std::lock_guard lock(mutex_);
+  entries_[path.Path().string()] = Entry{
+      .content_hash = content_hash,
+      .content_size = content_size,
+      .mtime = mtime,
+      .tree = std::move(tree),
+      .last_used_build = build_counter_,
+      .dirty = false};
+}
+
+auto PreambleCache::EndBuild() -> void {
+  std::lock_guard lock(mutex_);
+
+  // Evict trees that are no longer part of the layout. Their buffers stay in
+  // the generation's SourceManager until the generation is recycled.
+  size_t live_bytes = 0;
+  for (auto it = entries_.begin(); it != entries_.end();) {
+    if (it->second.last_used_build != build_counter_) {
+      stats_.dead_bytes += it->second.content_size;
+      ++stats_.evictions;
+      it = entries_.erase(it);
+    } else {
+      live_bytes += it->second.content_size;
+      ++it;
+    }
+  }
+  stats_.live_bytes = live_bytes;
+  stats_.entries = entries_.size();
+  utils::Metrics::Instance()
+      .GetGauge("preamble_cache.live_bytes")
+      .Set(static_cast<int64_t>(live_bytes));
+
+  bool dead_dominates = stats_.dead_bytes > kMinDeadBytesForRecycle &&
+                        stats_.dead_bytes > live_bytes;
+  bool over_budget = live_bytes + stats_.dead_bytes > max_bytes_;
+  if (dead_dominates || over_budget) {
+    logger_->debug(
+        "PreambleCache: recycling generation on next build ({} MB live, {} MB "
+        "dead)",
+        live_bytes / (1024 * 1024), stats_.dead_bytes / (1024 * 1024));
+    generation_valid_ = false;
+  }
+
+  logger_->debug(
+      "PreambleCache: {} entries, {} hits, {} misses, {} evictions",
+      stats_.entries, stats_.hits, stats_.misses, stats_.evictions);
+}
+
+auto PreambleCache::Invalidate(const CanonicalPath& path) -> void {
+  std::lock_guard lock(mutex_);
+  if (auto it = entries_.find(path.Path().string()); it != entries_.end()) {
+    // Re-hashed on the next build (mtime granularity may hide the change)
+    it->second.dirty = true;
+    return;
+  }
+
+  // Untracked file (e.g. an include). The SourceManager may hold a stale copy.
+  if (generation_valid_) {
+    logger_->debug(
+        "PreambleCache: untracked file changed, invalidating generation: {}",
+        path);
+    generation_valid_ = false;
+  }
+}
+
+auto PreambleCache::Clear() -> void {
+  std::lock_guard lock(mutex_);
+  entries_.clear();
+  source_manager_.reset();
+  generation_valid_ = false;
+  stats_.entries = 0;
+  stats_.live_bytes = 0;
+  stats_.dead_bytes = 0;
+}
+
+auto PreambleCache::GetStats() const -> Stats {
+  std::lock_guard lock(mutex_);
+  return stats_;
+}
+
+auto PreambleCache::ResetGenerationLocked() -> void {
+  stats_.evictions += entries_.size();
+  entries_.clear();
+
+  source_manager_ = std::make_shared<slang::SourceManager>();
+  source_manager_->setBufferIDOffset(kPreambleBufferIdOffset);
+
+  generation_valid_ = true;
+  ++stats_.generations;
+  stats_.entries = 0;
+  stats_.live_bytes = 0;
+  stats_.dead_bytes = 0;
+}
+
+}  // namespace slangd::services
@@ -1,5 +1,10 @@
 #include "slangd/services/preamble_manager.hpp"
 
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <optional>
+
 #include <mimalloc.h>
 
 #include <asio/co_spawn.hpp>
@@ -10,23 +15,93 @@
 #include <slang/ast/Compilation.h>
 #include <slang/ast/SemanticFacts.h>
 #include <slang/ast/symbols/CompilationUnitSymbols.h>
+#include <slang/ast/types/AllTypes.h>
 #include <slang/parsing/Preprocessor.h>
 #include <slang/syntax/AllSyntax.h>
 #include <slang/syntax/SyntaxTree.h>
+#include <slang/text/SourceManager.h>
 #include <slang/util/Bag.h>
 
 #include "slangd/core/project_layout_service.hpp"
+#include "slangd/syntax/identifier_collector.hpp"
 #include "slangd/utils/barrier.hpp"
 #include "slangd/utils/compilation_options.hpp"
+#include "slangd/utils/hash.hpp"
 #include "slangd/utils/memory_utils.hpp"
 #include "slangd/utils/scoped_timer.hpp"
 
 namespace slangd::services {
 
+namespace {
+
+struct FileFingerprint {
+  uint64_t hash;
+  size_t size;
+  std::filesystem::file_time_type mtime;
+};
+
+// Stat the file and reuse the cached hash when mtime and size match;
+// otherwise read and hash the contents
+auto ReadFingerprint(const CanonicalPath& path, const PreambleCache& cache)
+    -> std::optional<FileFingerprint> {
+  std::error_code ec;
+  auto mtime = std::filesystem::last_write_time(path.Path(), ec);
+  if (ec) {
+    return std::nullopt;
+  }
+  auto size = std::filesystem::file_size(path.Path(), ec);
+  if (ec) {
+    return std::nullopt;
+  }
+
+  if (auto hash = cache.ProbeHash(path, mtime, size)) {
+    return FileFingerprint{.hash = *hash, .size = size, .mtime = mtime};
+  }
+
+  std::ifstream file(path.Path(), std::ios::binary);
+  if (!file) {
+    return std::nullopt;
+  }
+  std::string content(
+      (std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+  return FileFingerprint{
+      .hash = utils::HashBytes(content),
+      .size = content.size(),
+      .mtime = mtime};
+}
+
+// Whether `scope` declares a generic class, directly or in a nested class
+auto DeclaresGenericClass(const slang::ast::Scope& scope) -> bool {
+  for (const auto& member : scope.members()) {
+    if (member.kind == slang::ast::SymbolKind::GenericClassDef) {
+      return true;
+    }
+    if (member.kind == slang::ast::SymbolKind::ClassType &&
+        DeclaresGenericClass(member.as<slang::ast::ClassType>())) {
+      return true;
+    }
+  }
+  return false;
+}
+
+auto EnclosingCompilationUnit(const slang::ast::Symbol& symbol)
+    -> const slang::ast::Scope* {
+  for (const auto* scope = symbol.getParentScope(); scope != nullptr;
+       scope = scope->asSymbol().getParentScope()) {
+    if (scope->asSymbol().kind == slang::ast::SymbolKind::CompilationUnit) {
+      return scope;
+    }
+  }
+  return nullptr;
+}
+
+}  // namespace
+
 auto PreambleManager::CreateFromProjectLayout(
     std::shared_ptr<ProjectLayoutService> layout_service,
     asio::any_io_executor compilation_executor,
-    std::shared_ptr<spdlog::logger> logger)
+    std::shared_ptr<spdlog::logger> logger,
+    std::shared_ptr<PreambleCache> cache)
     -> asio::awaitable<
         std::expected<std::shared_ptr<PreambleManager>, std::string>> {
   auto preamble = std::make_shared<PreambleManager>();
@@ -34,12 +109,10 @@ auto PreambleManager::CreateFromProjectLayout(
   utils::ScopedTimer timer("PreambleManager build", logger);
   logger->debug("PreambleManager: Building from layout service");
 
-  // Create fresh source manager
-  preamble->source_manager_ = std::make_shared<slang::SourceManager>();
-
-  // Set BufferID offset to prevent collisions with overlay compilations
-  // Preamble uses offset 1024, overlay uses 0 (default)
-  preamble->source_manager_->setBufferIDOffset(1024);
+  // Without a long-lived cache, use a throwaway one (always a fresh parse)
+  if (!cache) {
+    cache = std::make_shared<PreambleCache>(logger);
+  }
 
   // Start with standard LSP compilation options
   auto options = utils::CreateLspCompilationOptions();
@@ -58,6 +131,13 @@ auto PreambleManager::CreateFromProjectLayout(
   }
   options.set(pp_options);
 
+  // Source manager comes from the cache generation (offset 1024, so BufferIDs
+  // never collide with overlay compilations which use offset 0)
+  auto options_key = PreambleCache::ComputeOptionsKey(
+      preamble->include_directories_, preamble->defines_);
+  preamble->options_key_ = options_key;
+  preamble->source_manager_ = cache->BeginBuild(options_key);
+
   // Create preamble compilation with options
   preamble->preamble_compilation_ =
       std::make_shared<slang::ast::Compilation>(options);
@@ -73,32 +153,91 @@ auto PreambleManager::CreateFromProjectLayout(
 
   if (source_files.empty()) {
     logger->debug("PreambleManager: No source files (empty preamble)");
+    preamble->content_fingerprint_ = options_key;
+    cache->EndBuild();
     co_return preamble;
   }
 
+  // Fingerprint files in parallel (cache key). Unchanged files only cost a
+  // stat; the rest are read and hashed.
+  std::vector<std::optional<FileFingerprint>> fingerprints(source_files.size());
+  {
+    utils::ScopedTimer hash_timer("Fingerprinting source files", logger);
+
+    auto barrier = std::make_shared<utils::Barrier>(
+        compilation_executor, source_files.size());
+    for (size_t i = 0; i < source_files.size(); ++i) {
+      asio::post(
+          compilation_executor,
+          [i, &source_files, &fingerprints, &cache, barrier]() {
+            fingerprints[i] = ReadFingerprint(source_files[i], *cache);
+            barrier->Arrive();
+          });
+    }
+    co_await barrier->AsyncWait(asio::use_awaitable);
+  }
+
+  // A changed file can't be re-read into the same SourceManager (it caches
+  // contents by path and can't replace a buffer), so any conflict forces a
+  // fresh generation and every file is parsed again. Added, removed and
+  // touched-but-unchanged files keep the generation.
+  for (size_t i = 0; i < source_files.size(); ++i) {
+    if (fingerprints[i] &&
+        cache->HasConflict(source_files[i], fingerprints[i]->hash)) {
+      logger->debug(
+          "PreambleManager: {} changed, reparsing into new cache generation",
+          source_files[i]);
+      preamble->source_manager_ = cache->StartNewGeneration();
+      break;
+    }
+  }
+
   // Pre-allocate results vector
   using TreeResult = std::optional<std::shared_ptr<slang::syntax::SyntaxTree>>;
   std::vector<TreeResult> results(source_files.size());
 
+  // Reuse cached trees, collect the rest for parsing
+  std::vector<size_t> to_parse;
+  for (size_t i = 0; i < source_files.size(); ++i) {
+    if (fingerprints[i]) {
+      if (auto tree = cache->Lookup(
+              source_files[i], fingerprints[i]->hash, fingerprints[i]->mtime)) {
+        results[i] = std::move(tree);
+        continue;
+      }
+    }
+    to_parse.push_back(i);
+  }
+
+  logger->debug(
+      "PreambleManager: {} cached trees, {} files to parse",
+      source_files.size() - to_parse.size(), to_parse.size());
+
   // Parse syntax trees in parallel using thread pool
-  {
+  if (!to_parse.empty()) {
     utils::ScopedTimer parse_timer("Parsing syntax trees", logger);
 
     // Barrier for coordinating parallel parsing tasks
-    auto barrier = std::make_shared<utils::Barrier>(
-        compilation_executor, source_files.size());
+    auto barrier =
+        std::make_shared<utils::Barrier>(compilation_executor, to_parse.size());
 
     // Post blocking work to thread pool (parallel execution across threads)
-    for (size_t i = 0; i < source_files.size(); ++i) {
+    for (auto i : to_parse) {
       asio::post(
           compilation_executor,
-          [&preamble, i, &source_files, &results, &options, barrier]() {
+          [&preamble, i, &source_files, &results, &fingerprints, &options,
+           &cache, barrier]() {
             auto tree_result = slang::syntax::SyntaxTree::fromFile(
                 source_files[i].Path().string(), *preamble->source_manager_,
                 options);
 
             if (tree_result) {
               results[i] = tree_result.value();
+              if (fingerprints[i]) {
+                cache->Insert(
+                    source_files[i], fingerprints[i]->hash,
+                    fingerprints[i]->size, fingerprints[i]->mtime, *results[i]);
+              }
             } else {
               results[i] = std::nullopt;
             }
@@ -111,6 +250,47 @@ auto PreambleManager::CreateFromProjectLayout(
     co_await barrier->AsyncWait(asio::use_awaitable);
   }
 
+  cache->EndBuild();
+
+  // Identity of the preamble inputs: options, every source file and every
+  // header they included. An unchanged fingerprint means the rebuilt
+  // preamble is equivalent to the previous one. Headers come from the
+  // generation's SourceManager: a changed header starts a new generation
+  // (PreambleCache::Invalidate), where it is read again.
+  {
+    auto combine = [](uint64_t seed,
+                      std::vector<std::pair<std::string, uint64_t>>& hashes) {
+      std::ranges::sort(hashes);
+      for (const auto& [path, hash] : hashes) {
+        seed = utils::HashCombine(
+            utils::HashCombine(seed, utils::HashBytes(path)), hash);
+      }
+      return seed;
+    };
+
+    std::vector<std::pair<std::string, uint64_t>> header_hashes;
+    const auto& source_manager = *preamble->source_manager_;
+    for (auto buffer : source_manager.getAllBuffers()) {
+      if (source_manager.getIncludedFrom(buffer).valid()) {
+        header_hashes.emplace_back(
+            source_manager.getFullPath(buffer).string(),
+            utils::HashBytes(source_manager.getSourceText(buffer)));
+      }
+    }
+    preamble->header_fingerprint_ = combine(0, header_hashes);
+
+    std::vector<std::pair<std::string, uint64_t>> file_hashes;
+    file_hashes.reserve(source_files.size());
+    for (size_t i = 0; i < source_files.size(); ++i) {
+      file_hashes.emplace_back(
+          source_files[i].Path().string(),
+          fingerprints[i] ? fingerprints[i]->hash : 0);
+    }
+    preamble->content_fingerprint_ = combine(
+        utils::HashCombine(options_key, preamble->header_fingerprint_),
+        file_hashes);
+  }
+
   // Add trees to compilation sequentially (addSyntaxTree is NOT thread-safe)
   std::vector<std::string> failed_files;
   {
@@ -131,6 +311,9 @@ auto PreambleManager::CreateFromProjectLayout(
         failed_files.size(), failed_files[0]);
   }
 
+  co_await preamble->BuildRootSymbols(compilation_executor);
+  preamble->PreElaborate();
+
   auto before_mb = utils::GetRssMB();
 
   // Force mimalloc to return unused memory pages to OS
@@ -146,6 +329,163 @@ auto PreambleManager::CreateFromProjectLayout(
   co_return preamble;
 }
 
+auto PreambleManager::BuildRootSymbols(asio::any_io_executor executor)
+    -> asio::awaitable<void> {
+  utils::ScopedTimer timer("Indexing preamble root symbols", logger_);
+  const auto& root = preamble_compilation_->getRootNoFinalize();
+
+  auto get_or_add = [this](std::string_view name) -> RootSymbol& {
+    auto [it, inserted] = root_symbol_ids_.try_emplace(
+        name, static_cast<uint32_t>(root_symbols_.size()));
+    if (inserted) {
+      root_symbols_.push_back(RootSymbol{.name = name});
+    }
+    return root_symbols_[it->second];
+  };
+
+  for (const auto& [name, package] : GetPackageMap()) {
+    get_or_add(name).package = package;
+  }
+  for (const auto& [key, value] : GetDefinitionMap()) {
+    // Nested definitions can reuse a name; the root-level one wins
+    auto& symbol = get_or_add(std::get<0>(key));
+    if (!symbol.definition || std::get<1>(key) == &root) {
+      symbol.definition = value;
+    }
+  }
+
+  if (root_symbols_.empty()) {
+    co_return;
+  }
+
+  // Scan each symbol's syntax for names of other root symbols (read-only
+  // access to immutable syntax trees, safe in parallel)
+  auto barrier =
+      std::make_shared<utils::Barrier>(executor, root_symbols_.size());
+  for (auto& symbol : root_symbols_) {
+    asio::post(executor, [this, &symbol, barrier]() {
+      slang::flat_hash_set<std::string_view> names;
+      if (symbol.package != nullptr) {
+        if (const auto* syntax = symbol.package->getSyntax()) {
+          syntax::CollectIdentifiers(*syntax, names);
+        }
+      }
+      if (symbol.definition) {
+        for (const auto* definition : symbol.definition->first) {
+          if (const auto* syntax = definition->getSyntax()) {
+            syntax::CollectIdentifiers(*syntax, names);
+          }
+        }
+      }
+
+      for (auto name : names) {
+        auto it = root_symbol_ids_.find(name);
+        if (it != root_symbol_ids_.end() &&
+            &root_symbols_[it->second] != &symbol) {
+          symbol.dependencies.push_back(it->second);
+        }
+      }
+      barrier->Arrive();
+    });
+  }
+  co_await barrier->AsyncWait(asio::use_awaitable);
+
+  logger_->debug(
+      "PreambleManager: {} root symbols indexed", root_symbols_.size());
+}
+
+auto PreambleManager::PreElaborate() -> void {
+  utils::ScopedTimer timer("Pre-elaborating preamble scopes", logger_);
+
+  // Packages, plus the scopes definition bodies look names up in:
+  // compilation units ($unit declarations, file-level imports and typedefs)
+  // and the parents of nested definitions
+  slang::flat_hash_set<const slang::ast::Scope*> scopes;
+  for (const auto* unit : preamble_compilation_->getCompilationUnits()) {
+    scopes.insert(unit);
+  }
+  for (const auto& symbol : root_symbols_) {
+    if (symbol.package != nullptr) {
+      preamble_compilation_->forceElaborate(*symbol.package);
+    }
+    if (symbol.definition) {
+      for (const auto* definition : symbol.definition->first) {
+        if (const auto* parent = definition->getParentScope()) {
+          scopes.insert(parent);
+        }
+      }
+    }
+  }
+  for (const auto* scope : scopes) {
+    preamble_compilation_->forceElaborate(scope->asSymbol());
+  }
+
+  // Generic class specializations are still created (and inserted) lazily
+  // by whichever overlay asks first: mark symbols whose own scope or
+  // compilation unit declares one
+  slang::flat_hash_map<const slang::ast::Scope*, bool> unit_is_mutable;
+  auto in_mutable_unit = [&](const slang::ast::Symbol& symbol) {
+    const auto* unit = EnclosingCompilationUnit(symbol);
+    if (unit == nullptr) {
+      return false;
+    }
+    auto [it, inserted] = unit_is_mutable.try_emplace(unit, false);
+    if (inserted) {
+      it->second = DeclaresGenericClass(*unit);
+    }
+    return it->second;
+  };
+
+  size_t mutable_count = 0;
+  for (auto& symbol : root_symbols_) {
+    if (symbol.package != nullptr) {
+      symbol.mutable_on_use = DeclaresGenericClass(*symbol.package) ||
+                              in_mutable_unit(*symbol.package);
+    }
+    if (symbol.definition) {
+      for (const auto* definition : symbol.definition->first) {
+        symbol.mutable_on_use |= in_mutable_unit(*definition);
+      }
+    }
+    if (symbol.mutable_on_use) {
+      ++mutable_count;
+    }
+  }
+
+  logger_->debug(
+      "PreambleManager: {} root symbol(s) need serial overlay elaboration",
+      mutable_count);
+}
+
+auto PreambleManager::CollectReachableSymbols(
+    const slang::flat_hash_set<std::string_view>& names) const
+    -> std::vector<const RootSymbol*> {
+  std::vector<bool> visited(root_symbols_.size(), false);
+  std::vector<uint32_t> worklist;
+  for (auto name : names) {
+    if (auto it = root_symbol_ids_.find(name); it != root_symbol_ids_.end()) {
+      if (!visited[it->second]) {
+        visited[it->second] = true;
+        worklist.push_back(it->second);
+      }
+    }
+  }
+
+  std::vector<const RootSymbol*> result;
+  while (!worklist.empty()) {
+    auto id = worklist.back();
+    worklist.pop_back();
+    result.push_back(&root_symbols_[id]);
+    for (auto dependency : root_symbols_[id].dependencies) {
+      if (!visited[dependency]) {
+        visited[dependency] = true;
+        worklist.push_back(dependency);
+      }
+    }
+  }
+  return result;
+}
+
 auto PreambleManager::GetPackageMap() const -> const
     slang::flat_hash_map<std::string_view, const slang::ast::PackageSymbol*>& {
   return preamble_compilation_->getPackageMap();
@@ -157,6 +497,10 @@ auto PreambleManager::GetDefinitionMap() const -> const slang::flat_hash_map<
   return preamble_compilation_->getDefinitionMap();
 }
 
+auto PreambleManager::GetContentFingerprint() const -> uint64_t {
+  return content_fingerprint_;
+}
+
 auto PreambleManager::GetIncludeDirectories() const
     -> const std::vector<CanonicalPath>& {
   return include_directories_;
@@ -0,0 +1,199 @@
+#include "slangd/services/reference_index.hpp"
+
+#include <algorithm>
+
+#include "slangd/semantic/semantic_index.hpp"
+#include "slangd/utils/hash.hpp"
+
+namespace slangd::services {
+
+auto ReferenceIndex::SymbolKeyHash::operator()(const SymbolKey& key) const
+    -> size_t {
+  uint64_t hash = key.def_uri;
+  for (auto value :
+       {key.def_range.start.line, key.def_range.start.character,
+        key.def_range.end.line, key.def_range.end.character}) {
+    hash = utils::HashCombine(hash, static_cast<uint32_t>(value));
+  }
+  return static_cast<size_t>(hash);
+}
+
+auto ReferenceIndex::KeyLess(const SymbolKey& a, const SymbolKey& b) -> bool {
+  if (a.def_uri != b.def_uri) {
+    return a.def_uri < b.def_uri;
+  }
+  if (a.def_range.start != b.def_range.start) {
+    return a.def_range.start < b.def_range.start;
+  }
+  return a.def_range.end < b.def_range.end;
+}
+
+auto ReferenceIndex::Collect(const semantic::SemanticIndex& index)
+    -> FileReferences {
+  FileReferences result;
+  slang::flat_hash_map<uint32_t, uint32_t> local_uri_ids;
+
+  const auto& entries = index.GetSemanticEntries();
+  result.references.reserve(entries.size());
+  for (const auto& entry : entries) {
+    auto [it, inserted] = local_uri_ids.try_emplace(
+        entry.def_uri, static_cast<uint32_t>(result.def_uris.size()));
+    if (inserted) {
+      result.def_uris.emplace_back(index.GetString(entry.def_uri));
+    }
+    result.references.push_back(
+        Reference{
+            .def_uri = it->second,
+            .def_range = entry.def_range,
+            .range = entry.ref_range,
+            .is_declaration = entry.is_definition});
+  }
+  return result;
+}
+
+auto ReferenceIndex::Update(
+    std::string_view uri, Layer layer, FileReferences references) -> void {
+  std::vector<uint32_t> uri_ids;
+  uri_ids.reserve(references.def_uris.size());
+  for (const auto& def_uri : references.def_uris) {
+    uri_ids.push_back(strings_.Intern(def_uri));
+  }
+
+  std::vector<StoredReference> stored;
+  stored.reserve(references.references.size());
+  for (const auto& reference : references.references) {
+    stored.push_back(
+        StoredReference{
+            .key =
+                SymbolKey{
+                    .def_uri = uri_ids[reference.def_uri],
+                    .def_range = reference.def_range},
+            .range = reference.range,
+            .is_declaration = reference.is_declaration});
+  }
+  std::ranges::sort(
+      stored, [](const StoredReference& a, const StoredReference& b) {
+        return KeyLess(a.key, b.key);
+      });
+
+  auto [id_it, inserted] = file_ids_.try_emplace(
+      std::string(uri), static_cast<uint32_t>(files_.size()));
+  if (inserted) {
+    files_.push_back(
+        File{
+            .uri = std::string(uri),
+            .background = std::nullopt,
+            .overlay = std::nullopt});
+  }
+  auto file_id = id_it->second;
+  auto& file = files_[file_id];
+
+  RemovePostings(file_id, file);
+  (layer == Layer::kOverlay ? file.overlay : file.background) =
+      std::move(stored);
+  AddPostings(file_id, file);
+}
+
+auto ReferenceIndex::Remove(std::string_view uri, Layer layer) -> void {
+  auto it = file_ids_.find(std::string(uri));
+  if (it == file_ids_.end()) {
+    return;
+  }
+  auto file_id = it->second;
+  auto& file = files_[file_id];
+
+  RemovePostings(file_id, file);
+  (layer == Layer::kOverlay ? file.overlay : file.background).reset();
+  AddPostings(file_id, file);
+}
+
+auto ReferenceIndex::RetainBackground(
+    const slang::flat_hash_set<std::string>& uris) -> void {
+  for (uint32_t file_id = 0; file_id < files_.size(); ++file_id) {
+    auto& file = files_[file_id];
+    if (file.background && !uris.contains(file.uri)) {
+      RemovePostings(file_id, file);
+      file.background.reset();
+      AddPostings(file_id, file);
+    }
+  }
+}
+
+auto ReferenceIndex::FindReferences(
+    std::string_view def_uri, const lsp::Range& def_range,
+    bool include_declaration) const -> std::vector<lsp::Location> {
+  std::vector<lsp::Location> locations;
+  auto uri_id = strings_.Find(def_uri);
+  if (!uri_id) {
+    return locations;
+  }
+
+  SymbolKey key{.def_uri = *uri_id, .def_range = def_range};
+  auto posting = postings_.find(key);
+  if (posting == postings_.end()) {
+    return locations;
+  }
+
+  for (auto file_id : posting->second) {
+    const auto& file = files_[file_id];
+    const auto& refs = file.Active();
+    if (!refs) {
+      continue;
+    }
+    auto [first, last] = std::ranges::equal_range(
+        *refs, key, KeyLess, &StoredReference::key);
+    for (const auto& ref : std::ranges::subrange(first, last)) {
+      if (include_declaration || !ref.is_declaration) {
+        locations.push_back(lsp::Location{.uri = file.uri, .range = ref.range});
+      }
+    }
+  }
+  return locations;
+}
+
+auto ReferenceIndex::ReferenceCount() const -> size_t {
+  size_t count = 0;
+  for (const auto& file : files_) {
+    if (const auto& refs = file.Active()) {
+      count += refs->size();
+    }
+  }
+  return count;
+}
+
+auto ReferenceIndex::AddPostings(uint32_t file_id, const File& file) -> void {
+  // Both layers are added in one pass, so a repeated key always finds this
+  // file at the back of its list
+  for (const auto* refs : {&file.background, &file.overlay}) {
+    if (!*refs) {
+      continue;
+    }
+    for (const auto& ref : **refs) {
+      auto& files = postings_[ref.key];
+      if (files.empty() || files.back() != file_id) {
+        files.push_back(file_id);
+      }
+    }
+  }
+}
+
+auto ReferenceIndex::RemovePostings(uint32_t file_id, const File& file)
+    -> void {
+  for (const auto* refs : {&file.background, &file.overlay}) {
+    if (!*refs) {
+      continue;
+    }
+    for (const auto& ref : **refs) {
+      auto it = postings_.find(ref.key);
+      if (it == postings_.end()) {
+        continue;
+      }
+      std::erase(it->second, file_id);
+      if (it->second.empty()) {
+        postings_.erase(it);
+      }
+    }
+  }
+}
+
+}  // namespace slangd::services
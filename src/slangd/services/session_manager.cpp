@@ -1,18 +1,67 @@
 #include "slangd/services/session_manager.hpp"
 
-#include <mimalloc.h>
-#include <thread>
+#include <algorithm>
+#include <charconv>
+#include <cstdlib>
+#include <filesystem>
+#include <optional>
+#include <string_view>
+#include <system_error>
 
 #include <asio/co_spawn.hpp>
 #include <asio/detached.hpp>
 #include <asio/post.hpp>
 #include <asio/redirect_error.hpp>
 #include <asio/use_awaitable.hpp>
+#include <fmt/format.h>
 
 #include "slangd/services/overlay_session.hpp"
+#include "slangd/utils/barrier.hpp"
+#include "slangd/utils/canonical_path.hpp"
+#include "slangd/utils/mapped_file.hpp"
+#include "slangd/utils/scoped_timer.hpp"
+#include "slangd/utils/tracer.hpp"
 
 namespace slangd::services {
 
+namespace {
+
+auto MainText(const OverlaySession& session) -> std::string_view {
+  auto text = session.GetSourceManager().getSourceText(
+      session.GetMainBufferID());
+  // Slang buffers carry a NUL terminator that the document text does not
+  if (!text.empty() && text.back() == '\0') {
+    text.remove_suffix(1);
+  }
+  return text;
+}
+
+// File text for a sweep; MappedFile::Open also rejects empty files, which
+// still get a session
+auto ReadSweepFile(const std::string& uri) -> std::optional<std::string> {
+  auto path = CanonicalPath::FromUri(uri).Path();
+  if (auto file = utils::MappedFile::Open(path)) {
+    auto data = file->Data();
+    return std::string(reinterpret_cast<const char*>(data.data()), data.size());
+  }
+  std::error_code ec;
+  if (std::filesystem::file_size(path, ec) == 0 && !ec) {
+    return std::string();
+  }
+  return std::nullopt;
+}
+
+auto RecordMicros(
+    std::string_view histogram, std::chrono::steady_clock::duration duration)
+    -> void {
+  utils::Metrics::Instance().GetHistogram(histogram).Record(
+      static_cast<uint64_t>(
+          std::chrono::duration_cast<std::chrono::microseconds>(duration)
+              .count()));
+}
+
+}  // namespace
+
 SessionManager::PendingCreation::PendingCreation(
     asio::any_io_executor executor, int doc_version)
     : compilation_ready(executor),
@@ -25,33 +74,52 @@ SessionManager::SessionManager(
     std::shared_ptr<ProjectLayoutService> layout_service,
     std::shared_ptr<const PreambleManager> preamble_manager,
     std::shared_ptr<OpenDocumentTracker> open_tracker,
-    std::shared_ptr<spdlog::logger> logger)
+    std::shared_ptr<utils::PriorityScheduler> scheduler,
+    std::shared_ptr<IncludeCache> include_cache,
+    std::shared_ptr<spdlog::logger> logger, size_t memory_budget)
     : executor_(executor),
       logger_(std::move(logger)),
       layout_service_(std::move(layout_service)),
       preamble_manager_(std::move(preamble_manager)),
       open_tracker_(std::move(open_tracker)),
       session_strand_(asio::make_strand(executor)),
-      compilation_pool_(std::make_unique<asio::thread_pool>([] {
-        const auto hw_threads = std::thread::hardware_concurrency();
-        const auto num_threads = std::min(hw_threads / 2, 16U);
-        return num_threads == 0 ? 1U : num_threads;
-      }())),
-      overlay_strand_(asio::make_strand(compilation_pool_->get_executor())) {
-  // Multi-threaded pool enables parallel preamble syntax tree parsing
-  // overlay_strand_ serializes overlay elaboration (prevents concurrent
-  // preamble access - Slang compilation is not thread-safe)
+      memory_budget_(memory_budget),
+      scheduler_(std::move(scheduler)),
+      include_cache_(std::move(include_cache)),
+      serial_gate_(executor) {
+  // Multi-threaded scheduler: overlays build and elaborate in parallel
+  // serial_gate_ serializes only overlays that bind preamble symbols with
+  // lazily mutated state (Slang compilation is not thread-safe)
 }
 
-SessionManager::~SessionManager() {
-  compilation_pool_->join();
+auto SessionManager::DefaultMemoryBudget() -> size_t {
+  size_t megabytes = kDefaultMemoryBudgetMB;
+  if (const char* env = std::getenv("SLANGD_SESSION_MEMORY_MB")) {
+    std::string_view text(env);
+    size_t parsed = 0;
+    auto [end, ec] =
+        std::from_chars(text.data(), text.data() + text.size(), parsed);
+    if (ec == std::errc{} && end == text.data() + text.size() && parsed > 0) {
+      megabytes = parsed;
+    } else {
+      spdlog::warn(
+          "Ignoring invalid SLANGD_SESSION_MEMORY_MB='{}' (using {} MB)", text,
+          megabytes);
+    }
+  }
+  return megabytes * 1024 * 1024;
 }
 
 auto SessionManager::UpdateSession(
     std::string uri, std::string content, int version,
+    utils::TaskPriority priority,
     std::optional<CompilationReadyHook> on_compilation_ready,
-    std::optional<SessionReadyHook> on_session_ready) -> asio::awaitable<void> {
+    std::optional<SessionReadyHook> on_session_ready, uint64_t request_id)
+    -> asio::awaitable<void> {
   co_await asio::post(session_strand_, asio::use_awaitable);
+  if (shut_down_) {
+    co_return;
+  }
 
   // Capture shared_ptr snapshots to pass to background thread pool
   // Prevents data race when UpdatePreambleManager swaps these pointers
@@ -76,7 +144,17 @@ auto SessionManager::UpdateSession(
     logger_->debug(
         "SessionManager version changed: {} (old: {}, new: {})", uri,
         it->second.version, version);
-    sessions_.erase(uri);
+    // Keep serving navigation from the indexed session until the new version
+    // is indexed. A Phase 1 entry is an unfinished build of an older version;
+    // the stale session from before it (if any) stays.
+    if (it->second.phase >= SessionPhase::kIndexingComplete) {
+      stale_[uri] = StaleSession{
+          .session = std::move(it->second.session),
+          .version = it->second.version,
+          .mapper = {},
+          .footprint = it->second.footprint};
+    }
+    sessions_.erase(it);
   }
 
   // Check if pending session already exists
@@ -89,15 +167,22 @@ auto SessionManager::UpdateSession(
           "SessionManager: Cancelling pending session for {} (old version {}, "
           "new version {})",
           uri, it->second->version, version);
-      it->second->cancelled.store(true, std::memory_order_release);
+      it->second->cancellation.request_stop();
       pending_.erase(it);
+      utils::Metrics::Instance().GetCounter("session.cancelled").Add();
     }
   }
 
+  if (auto stale_it = stale_.find(uri); stale_it != stale_.end()) {
+    stale_it->second.mapper =
+        utils::PositionMapper(MainText(*stale_it->second.session), content);
+  }
+
   auto new_pending = StartSessionCreation(
-      uri, content, version, preamble, layout, on_compilation_ready,
-      on_session_ready);
+      uri, content, version, priority, preamble, layout, on_compilation_ready,
+      on_session_ready, request_id);
   pending_[uri] = new_pending;
+  PublishGauges();
 
   co_return;
 }
@@ -110,7 +195,7 @@ auto SessionManager::InvalidateSessions(std::vector<std::string> uris) -> void {
 
         for (const auto& uri : uris) {
           if (auto it = pending_.find(uri); it != pending_.end()) {
-            it->second->cancelled.store(true, std::memory_order_release);
+            it->second->cancellation.request_stop();
           }
           // Cancel cleanup timer if exists
           if (auto timer_it = cleanup_timers_.find(uri);
@@ -119,9 +204,11 @@ auto SessionManager::InvalidateSessions(std::vector<std::string> uris) -> void {
             cleanup_timers_.erase(timer_it);
           }
           sessions_.erase(uri);
+          stale_.erase(uri);
           pending_.erase(uri);
           logger_->debug("Session invalidated: {}", uri);
         }
+        PublishGauges();
         co_return;
       },
       asio::detached);
@@ -134,11 +221,14 @@ auto SessionManager::CancelPendingSession(std::string uri) -> void {
         co_await asio::post(session_strand_, asio::use_awaitable);
 
         if (auto it = pending_.find(uri); it != pending_.end()) {
-          it->second->cancelled.store(true, std::memory_order_release);
+          it->second->cancellation.request_stop();
           pending_.erase(it);
+          // Nothing will replace it now; don't keep serving an old version
+          stale_.erase(uri);
           logger_->debug(
               "Cancelled pending session for: {} (stored={}, pending={})", uri,
               sessions_.size(), pending_.size());
+          PublishGauges();
         }
 
         co_return;
@@ -154,10 +244,6 @@ auto SessionManager::UpdatePreambleManager(
   co_await asio::post(session_strand_, asio::use_awaitable);
 
   preamble_manager_ = std::move(preamble_manager);
-
-  // Force mimalloc to return unused memory pages to OS
-  // Note: old preamble may still be held by existing sessions
-  mi_collect(true);
 }
 
 auto SessionManager::InvalidateAllSessions() -> asio::awaitable<void> {
@@ -167,7 +253,7 @@ auto SessionManager::InvalidateAllSessions() -> asio::awaitable<void> {
 
   // Cancel all pending session creations
   for (auto& [uri, pending] : pending_) {
-    pending->cancelled.store(true, std::memory_order_release);
+    pending->cancellation.request_stop();
   }
 
   // Cancel all cleanup timers
@@ -190,58 +276,83 @@ auto SessionManager::InvalidateAllSessions() -> asio::awaitable<void> {
 
   // Now safe to clear maps - sessions hold preamble references
   // Clearing them drops old preamble refcount to 0 → destructor runs
+  // Their compilations and syntax trees unmap their arenas as they go (see
+  // docs/MEMORY_ARCHITECTURE.md), so no global heap collection is needed
   sessions_.clear();
+  stale_.clear();
   pending_.clear();
   cleanup_timers_.clear();
+  PublishGauges();
+}
 
-  // Force mimalloc to return unused memory pages to OS
-  mi_collect(true);
+auto SessionManager::Shutdown() -> asio::awaitable<void> {
+  co_await asio::post(session_strand_, asio::use_awaitable);
+  shut_down_ = true;
+  co_await InvalidateAllSessions();
 }
 
 auto SessionManager::StartSessionCreation(
     std::string uri, std::string content, int version,
+    utils::TaskPriority priority,
     std::shared_ptr<const PreambleManager> preamble_manager,
     std::shared_ptr<ProjectLayoutService> layout_service,
     std::optional<CompilationReadyHook> on_compilation_ready,
-    std::optional<SessionReadyHook> on_session_ready)
+    std::optional<SessionReadyHook> on_session_ready, uint64_t request_id)
     -> std::shared_ptr<PendingCreation> {
   auto pending = std::make_shared<PendingCreation>(executor_, version);
   pending->on_compilation_ready = std::move(on_compilation_ready);
   pending->on_session_ready = std::move(on_session_ready);
+  pending->request_id = request_id;
 
   // Create task with use_awaitable (captures preamble)
   auto task = asio::co_spawn(
       executor_,
-      [this, uri, content, pending, preamble_manager,
+      [this, uri, content, priority, pending, preamble_manager,
        layout_service]() -> asio::awaitable<void> {
         auto result = co_await asio::co_spawn(
-            overlay_strand_,
-            [uri, content, this, pending, preamble_manager, layout_service]()
+            scheduler_->GetExecutor(priority),
+            [uri, content, this, priority, pending, preamble_manager,
+             layout_service]()
                 -> asio::awaitable<
                     std::optional<std::shared_ptr<OverlaySession>>> {
+              utils::TraceSpan span(
+                  fmt::format("Session build: {}", uri), "session",
+                  pending->request_id);
+
               // Check cancellation flag (lock-free, stays on pool thread)
-              if (pending->cancelled.load(std::memory_order_acquire)) {
+              if (pending->cancellation.stop_requested()) {
                 logger_->debug(
                     "Session creation cancelled before compilation: {}", uri);
                 co_return std::nullopt;
               }
+              auto build_start = std::chrono::steady_clock::now();
 
               auto [source_manager, compilation, main_buffer_id] =
                   OverlaySession::BuildCompilation(
-                      uri, content, layout_service, preamble_manager, logger_);
+                      uri, content, layout_service, preamble_manager, logger_,
+                      include_cache_);
+              RecordMicros(
+                  "session.parse_us",
+                  std::chrono::steady_clock::now() - build_start);
 
               // Check again after expensive BuildCompilation
-              if (pending->cancelled.load(std::memory_order_acquire)) {
+              if (pending->cancellation.stop_requested()) {
                 logger_->debug(
                     "Session creation cancelled after compilation: {}", uri);
                 co_return std::nullopt;
               }
 
-              auto result = semantic::SemanticIndex::FromCompilation(
-                  *compilation, *source_manager, uri, main_buffer_id,
-                  preamble_manager.get(), logger_);
+              auto result = co_await BuildSemanticIndex(
+                  uri, *compilation, *source_manager, main_buffer_id,
+                  preamble_manager.get(), priority,
+                  pending->cancellation.get_token());
 
               if (!result) {
+                if (pending->cancellation.stop_requested()) {
+                  logger_->debug(
+                      "Session creation cancelled during elaboration: {}", uri);
+                  co_return std::nullopt;
+                }
                 logger_->error(
                     "Semantic indexing failed for '{}': {}", uri,
                     result.error());
@@ -250,6 +361,12 @@ auto SessionManager::StartSessionCreation(
               }
 
               auto semantic_index = std::move(*result);
+              auto build_duration =
+                  std::chrono::steady_clock::now() - build_start;
+              auto build_time =
+                  std::chrono::duration_cast<std::chrono::milliseconds>(
+                      build_duration);
+              RecordMicros("session.build_us", build_duration);
 
               // Switch to strand to check pending_ map and store results
               // (shared state requires strand protection)
@@ -258,7 +375,7 @@ auto SessionManager::StartSessionCreation(
               auto it = pending_.find(uri);
               if (it == pending_.end() ||
                   it->second->version != pending->version ||
-                  it->second->cancelled.load(std::memory_order_acquire)) {
+                  it->second->cancellation.stop_requested()) {
                 logger_->debug(
                     "Session creation cancelled after elaboration: {}", uri);
                 co_return std::nullopt;
@@ -276,10 +393,19 @@ auto SessionManager::StartSessionCreation(
                   source_manager, compilation_shared, std::move(semantic_index),
                   main_buffer_id, logger_, preamble_manager);
 
-              sessions_[uri] = SessionEntry{
+              auto& entry = sessions_[uri];
+              entry = SessionEntry{
                   .session = partial_session,
                   .version = pending->version,
-                  .phase = SessionPhase::kElaborationComplete};
+                  .phase = SessionPhase::kElaborationComplete,
+                  .footprint = partial_session->MemoryUsage(),
+                  .build_time = build_time,
+                  .retention = 0.0};
+              Touch(entry);
+              utils::Metrics::Instance()
+                  .GetHistogram("session.footprint_bytes")
+                  .Record(entry.footprint);
+              EnforceMemoryBudget(uri);
 
               // Execute Phase 1 hook if provided (on strand, session cannot be
               // cleaned up)
@@ -307,6 +433,7 @@ auto SessionManager::StartSessionCreation(
             if (auto session_it = sessions_.find(uri);
                 session_it != sessions_.end()) {
               session_it->second.phase = SessionPhase::kIndexingComplete;
+              stale_.erase(uri);
 
               // Execute Phase 2 hook if provided (on strand, session cannot be
               // cleaned up)
@@ -318,6 +445,7 @@ auto SessionManager::StartSessionCreation(
               session_ready_signaled = true;
             }
             pending_.erase(it);
+            PublishGauges();
           } else {
             logger_->debug(
                 "Session creation superseded during Phase 2: {}", uri);
@@ -336,11 +464,14 @@ auto SessionManager::StartSessionCreation(
           }
           pending->session_ready.Set();
 
-          // Clean up pending_ entry if it still points to this version
+          // Clean up pending_ entry if it still points to this version. The
+          // stale session goes with it: no newer build would replace it.
           auto it = pending_.find(uri);
           if (it != pending_.end() && it->second->version == pending->version) {
             pending_.erase(it);
+            stale_.erase(uri);
           }
+          PublishGauges();
         }
 
         // Signal completion (success or failure)
@@ -358,6 +489,191 @@ auto SessionManager::StartSessionCreation(
   return pending;
 }
 
+auto SessionManager::BuildSemanticIndex(
+    const std::string& uri, slang::ast::Compilation& compilation,
+    const slang::SourceManager& source_manager, slang::BufferID main_buffer_id,
+    const PreambleManager* preamble_manager, utils::TaskPriority priority,
+    std::stop_token stop_token)
+    -> asio::awaitable<
+        std::expected<std::unique_ptr<semantic::SemanticIndex>, std::string>> {
+  auto build_index = [&]() {
+    return semantic::SemanticIndex::FromCompilation(
+        compilation, source_manager, uri, main_buffer_id, preamble_manager,
+        logger_, stop_token);
+  };
+
+  // Overlays elaborate in parallel against the pre-elaborated preamble,
+  // unless they bind preamble state that is still mutated lazily (see
+  // PreambleManager::PreElaborate)
+  if (OverlaySession::RequiresSerialElaboration(compilation)) {
+    auto lease = co_await serial_gate_.Acquire(priority);
+    co_await asio::post(
+        scheduler_->GetExecutor(priority), asio::use_awaitable);
+    co_return build_index();
+  }
+  co_return build_index();
+}
+
+auto SessionManager::WithTransientSession(
+    std::string uri, std::string content, utils::TaskPriority priority,
+    std::function<void(const OverlaySession&)> callback)
+    -> asio::awaitable<bool> {
+  co_await asio::post(session_strand_, asio::use_awaitable);
+  auto preamble_manager = preamble_manager_;
+  auto layout_service = layout_service_;
+
+  co_return co_await asio::co_spawn(
+      scheduler_->GetExecutor(priority),
+      [&]() -> asio::awaitable<bool> {
+        // No include cache: sweeps would pull in every header of the project
+        auto [source_manager, compilation, main_buffer_id] =
+            OverlaySession::BuildCompilation(
+                uri, content, layout_service, preamble_manager, logger_);
+
+        auto result = co_await BuildSemanticIndex(
+            uri, *compilation, *source_manager, main_buffer_id,
+            preamble_manager.get(), priority);
+        if (!result) {
+          logger_->debug(
+              "Transient session failed for '{}': {}", uri, result.error());
+          co_return false;
+        }
+
+        // Never stored: dropped (on this thread) once the callback returns
+        auto session = OverlaySession::CreateFromParts(
+            source_manager,
+            std::shared_ptr<slang::ast::Compilation>(std::move(compilation)),
+            std::move(*result), main_buffer_id, logger_, preamble_manager);
+        callback(*session);
+        co_return true;
+      },
+      asio::use_awaitable);
+}
+
+auto SessionManager::SweepFiles(
+    const std::vector<std::string>& uris, utils::TaskPriority priority,
+    std::function<void(size_t, const OverlaySession&)> on_session,
+    std::function<void(size_t, bool)> on_file, SweepOptions options)
+    -> asio::awaitable<void> {
+  auto max_workers = options.max_workers > 0 ? options.max_workers
+                                             : scheduler_->ThreadCount();
+  auto worker_count = std::max<size_t>(1, std::min(max_workers, uris.size()));
+  auto barrier = std::make_shared<utils::Barrier>(executor_, worker_count);
+  size_t next = 0;
+  for (size_t i = 0; i < worker_count; ++i) {
+    asio::co_spawn(
+        executor_,
+        [&, barrier]() -> asio::awaitable<void> {
+          while (next < uris.size() &&
+                 (!options.keep_going || options.keep_going())) {
+            auto index = next++;
+            bool built = false;
+            if (auto content = ReadSweepFile(uris[index])) {
+              built = co_await WithTransientSession(
+                  uris[index], std::move(*content), priority,
+                  [&](const OverlaySession& session) {
+                    on_session(index, session);
+                  });
+              co_await asio::post(executor_, asio::use_awaitable);
+            }
+            on_file(index, built);
+          }
+          barrier->Arrive();
+        },
+        asio::detached);
+  }
+  co_await barrier->AsyncWait(asio::use_awaitable);
+}
+
+auto SessionManager::Touch(SessionEntry& entry) -> void {
+  constexpr double kBytesPerMB = 1024.0 * 1024.0;
+  auto megabytes =
+      std::max(static_cast<double>(entry.footprint) / kBytesPerMB, 1.0);
+  auto build_ms = std::max(static_cast<double>(entry.build_time.count()), 1.0);
+  entry.retention = retention_inflation_ + (build_ms / megabytes);
+}
+
+auto SessionManager::EnforceMemoryBudget(const std::string& keep_uri)
+    -> void {
+  size_t total = 0;
+  for (const auto& [uri, entry] : sessions_) {
+    total += entry.footprint;
+  }
+  for (const auto& [uri, stale] : stale_) {
+    total += stale.footprint;
+  }
+
+  // Stale sessions go first, largest first; navigation falls back to
+  // waiting for the replacement
+  while (total > memory_budget_ && !stale_.empty()) {
+    auto victim = std::ranges::max_element(
+        stale_, {}, [](const auto& item) { return item.second.footprint; });
+    total -= victim->second.footprint;
+    logger_->debug(
+        "Stale session evicted: {} ({} KB), {} MB stored", victim->first,
+        victim->second.footprint / 1024, total / (1024 * 1024));
+    stale_.erase(victim);
+    utils::Metrics::Instance().GetCounter("session.evictions").Add();
+  }
+
+  while (total > memory_budget_) {
+    // Closed documents go first; open ones only when closed ones are gone
+    auto victim = sessions_.end();
+    bool victim_open = true;
+    for (auto it = sessions_.begin(); it != sessions_.end(); ++it) {
+      // Sessions still upgrading to Phase 2 are about to be handed out
+      if (it->first == keep_uri ||
+          it->second.phase < SessionPhase::kIndexingComplete) {
+        continue;
+      }
+      bool open = open_tracker_->Contains(it->first);
+      if (victim == sessions_.end() || (!open && victim_open) ||
+          (open == victim_open &&
+           it->second.retention < victim->second.retention)) {
+        victim = it;
+        victim_open = open;
+      }
+    }
+    if (victim == sessions_.end()) {
+      break;
+    }
+
+    retention_inflation_ = victim->second.retention;
+    total -= victim->second.footprint;
+    logger_->debug(
+        "Session evicted: {} ({} KB, {} build, {}), {} MB stored",
+        victim->first, victim->second.footprint / 1024,
+        utils::ScopedTimer::FormatDuration(victim->second.build_time),
+        victim_open ? "open" : "closed", total / (1024 * 1024));
+    if (auto timer_it = cleanup_timers_.find(victim->first);
+        timer_it != cleanup_timers_.end()) {
+      timer_it->second->cancel();
+      cleanup_timers_.erase(timer_it);
+    }
+    sessions_.erase(victim);
+    utils::Metrics::Instance().GetCounter("session.evictions").Add();
+  }
+  PublishGauges();
+}
+
+auto SessionManager::PublishGauges() -> void {
+  size_t stored_bytes = 0;
+  for (const auto& [uri, entry] : sessions_) {
+    stored_bytes += entry.footprint;
+  }
+  for (const auto& [uri, stale] : stale_) {
+    stored_bytes += stale.footprint;
+  }
+  auto& metrics = utils::Metrics::Instance();
+  metrics.GetGauge("session.stored")
+      .Set(static_cast<int64_t>(sessions_.size()));
+  metrics.GetGauge("session.stored_bytes")
+      .Set(static_cast<int64_t>(stored_bytes));
+  metrics.GetGauge("session.pending")
+      .Set(static_cast<int64_t>(pending_.size()));
+  metrics.GetGauge("session.stale").Set(static_cast<int64_t>(stale_.size()));
+}
+
 auto SessionManager::ScheduleCleanup(std::string uri) -> void {
   asio::co_spawn(
       executor_,
@@ -390,11 +706,13 @@ auto SessionManager::ScheduleCleanup(std::string uri) -> void {
                   if (auto timer_it = cleanup_timers_.find(uri);
                       timer_it != cleanup_timers_.end()) {
                     sessions_.erase(uri);
+                    stale_.erase(uri);
                     cleanup_timers_.erase(uri);
 
                     logger_->debug(
                         "Session removed after cleanup delay: {} (stored={})",
                         uri, sessions_.size());
+                    PublishGauges();
                   }
 
                   co_return;
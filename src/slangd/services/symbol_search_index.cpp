@@ -0,0 +1,159 @@
+#include "slangd/services/symbol_search_index.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <tuple>
+#include <utility>
+
+namespace slangd::services {
+
+namespace {
+
+constexpr size_t kTrigramLength = 3;
+
+auto FoldChar(char c) -> char {
+  return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+auto Fold(std::string_view text) -> std::string {
+  std::string folded(text);
+  std::ranges::transform(folded, folded.begin(), FoldChar);
+  return folded;
+}
+
+auto TrigramAt(std::string_view text, size_t pos) -> uint32_t {
+  return (static_cast<uint32_t>(static_cast<unsigned char>(text[pos])) << 16) |
+         (static_cast<uint32_t>(static_cast<unsigned char>(text[pos + 1]))
+          << 8) |
+         static_cast<uint32_t>(static_cast<unsigned char>(text[pos + 2]));
+}
+
+// Lower is better
+enum class MatchClass : uint8_t { kExact, kPrefix, kSubstring };
+
+}  // namespace
+
+auto SymbolSearchIndex::Build(std::span<const FileIndex* const> files)
+    -> SymbolSearchIndex {
+  SymbolSearchIndex index;
+
+  // (trigram, entry) pairs, grouped into postings below
+  std::vector<std::pair<uint32_t, uint32_t>> pairs;
+  for (uint32_t file = 0; file < files.size(); ++file) {
+    auto symbols = files[file]->GetSymbols();
+    for (uint32_t symbol = 0; symbol < symbols.size(); ++symbol) {
+      auto name = files[file]->GetName(symbols[symbol].name);
+      auto entry_id = static_cast<uint32_t>(index.entries_.size());
+      index.entries_.push_back(
+          Entry{
+              .hit = Hit{.file = file, .symbol = symbol},
+              .offset = static_cast<uint32_t>(index.folded_.size()),
+              .length = static_cast<uint32_t>(name.size())});
+      std::ranges::transform(
+          name, std::back_inserter(index.folded_), FoldChar);
+
+      auto folded = index.FoldedName(index.entries_.back());
+      for (size_t pos = 0; pos + kTrigramLength <= folded.size(); ++pos) {
+        pairs.emplace_back(TrigramAt(folded, pos), entry_id);
+      }
+    }
+  }
+
+  // A trigram repeated within one name is posted once
+  std::ranges::sort(pairs);
+  auto [first, last] = std::ranges::unique(pairs);
+  pairs.erase(first, last);
+
+  index.postings_.reserve(pairs.size());
+  for (const auto& [trigram, entry_id] : pairs) {
+    if (index.trigrams_.empty() || index.trigrams_.back() != trigram) {
+      index.trigrams_.push_back(trigram);
+      index.posting_offsets_.push_back(
+          static_cast<uint32_t>(index.postings_.size()));
+    }
+    index.postings_.push_back(entry_id);
+  }
+  index.posting_offsets_.push_back(
+      static_cast<uint32_t>(index.postings_.size()));
+  return index;
+}
+
+auto SymbolSearchIndex::Postings(uint32_t trigram) const
+    -> std::span<const uint32_t> {
+  auto it = std::ranges::lower_bound(trigrams_, trigram);
+  if (it == trigrams_.end() || *it != trigram) {
+    return {};
+  }
+  auto slot = static_cast<size_t>(it - trigrams_.begin());
+  return std::span(postings_).subspan(
+      posting_offsets_[slot],
+      posting_offsets_[slot + 1] - posting_offsets_[slot]);
+}
+
+auto SymbolSearchIndex::Search(std::string_view query, size_t limit) const
+    -> std::vector<Hit> {
+  auto folded_query = Fold(query);
+
+  std::vector<uint32_t> candidates;
+  if (folded_query.size() < kTrigramLength) {
+    candidates.resize(entries_.size());
+    for (uint32_t i = 0; i < candidates.size(); ++i) {
+      candidates[i] = i;
+    }
+  } else {
+    // Intersect from the rarest trigram so the working set only shrinks
+    std::vector<std::span<const uint32_t>> lists;
+    for (size_t pos = 0; pos + kTrigramLength <= folded_query.size(); ++pos) {
+      auto list = Postings(TrigramAt(folded_query, pos));
+      if (list.empty()) {
+        return {};
+      }
+      lists.push_back(list);
+    }
+    std::ranges::sort(lists, {}, &std::span<const uint32_t>::size);
+
+    candidates.assign(lists.front().begin(), lists.front().end());
+    std::vector<uint32_t> next;
+    for (size_t i = 1; i < lists.size() && !candidates.empty(); ++i) {
+      next.clear();
+      std::ranges::set_intersection(
+          candidates, lists[i], std::back_inserter(next));
+      std::swap(candidates, next);
+    }
+  }
+
+  // Trigrams may match out of order; confirm the substring
+  using Ranked = std::tuple<MatchClass, uint32_t, uint32_t>;
+  std::vector<Ranked> ranked;
+  for (auto entry_id : candidates) {
+    const auto& entry = entries_[entry_id];
+    auto name = FoldedName(entry);
+    auto pos = name.find(folded_query);
+    if (pos == std::string_view::npos) {
+      continue;
+    }
+    auto match = name.size() == folded_query.size() ? MatchClass::kExact
+                 : pos == 0                         ? MatchClass::kPrefix
+                                                    : MatchClass::kSubstring;
+    ranked.emplace_back(match, entry.length, entry_id);
+  }
+
+  auto count = std::min(limit, ranked.size());
+  std::ranges::partial_sort(ranked, ranked.begin() + count);
+
+  std::vector<Hit> hits;
+  hits.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    hits.push_back(entries_[std::get<2>(ranked[i])].hit);
+  }
+  return hits;
+}
+
+auto SymbolSearchIndex::MemoryUsage() const -> size_t {
+  return (entries_.capacity() * sizeof(Entry)) + folded_.capacity() +
+         ((trigrams_.capacity() + posting_offsets_.capacity() +
+           postings_.capacity()) *
+          sizeof(uint32_t));
+}
+
+}  // namespace slangd::services
@@ -0,0 +1,330 @@
+#include "slangd/services/workspace_index.hpp"
+
+#include <algorithm>
+
+#include <asio/co_spawn.hpp>
+#include <asio/post.hpp>
+#include <asio/use_awaitable.hpp>
+#include <fmt/format.h>
+#include <slang/ast/Compilation.h>
+#include <slang/syntax/SyntaxTree.h>
+#include <slang/text/SourceManager.h>
+#include <slang/util/Hash.h>
+
+#include "slangd/syntax/index_collector.hpp"
+#include "slangd/utils/barrier.hpp"
+#include "slangd/utils/hash.hpp"
+#include "slangd/utils/path_utils.hpp"
+#include "slangd/utils/scoped_timer.hpp"
+
+namespace slangd::services {
+
+namespace {
+
+constexpr std::string_view kShardExtension = ".idx";
+
+// <file name>.<path hash>.idx: readable, and unique per path
+auto ShardFileName(std::string_view path) -> std::string {
+  return fmt::format(
+      "{}.{:016x}{}", std::filesystem::path(path).filename().string(),
+      utils::HashBytes(path), kShardExtension);
+}
+
+enum class ShardSource { kReused, kImported, kLoaded, kCollected };
+
+struct ShardJob {
+  const slang::syntax::SyntaxTree* tree;
+  std::string path;
+  std::string uri;
+  std::string_view text;
+  std::shared_ptr<const FileIndex> index;
+  ShardSource source = ShardSource::kCollected;
+};
+
+}  // namespace
+
+auto WorkspaceIndex::Build(
+    std::shared_ptr<const PreambleManager> preamble,
+    std::shared_ptr<const WorkspaceIndex> previous,
+    std::filesystem::path cache_dir, asio::any_io_executor executor,
+    std::shared_ptr<spdlog::logger> logger,
+    std::shared_ptr<const IndexArtifact> artifact)
+    -> asio::awaitable<std::shared_ptr<const WorkspaceIndex>> {
+  logger = logger ? logger : spdlog::default_logger();
+  auto index = std::make_shared<WorkspaceIndex>();
+  if (!preamble) {
+    co_return index;
+  }
+  utils::ScopedTimer timer("Workspace index build", logger);
+
+  if (!cache_dir.empty()) {
+    std::error_code ec;
+    std::filesystem::create_directories(cache_dir, ec);
+    if (ec) {
+      logger->warn(
+          "WorkspaceIndex: cannot create {} ({}), index is not persisted",
+          cache_dir.string(), ec.message());
+      cache_dir.clear();
+    }
+  }
+
+  slang::flat_hash_map<std::string_view, std::shared_ptr<const FileIndex>>
+      previous_shards;
+  if (previous) {
+    for (const auto& file : previous->files_) {
+      // By URI: imported shards carry the path of the machine that built them
+      previous_shards.emplace(file.uri, file.index);
+    }
+  }
+
+  // Defines and include dirs change what the syntax of unchanged text is
+  auto options_key = preamble->GetOptionsKey();
+
+  std::vector<ShardJob> jobs;
+  for (const auto& tree : preamble->GetCompilation().getSyntaxTrees()) {
+    auto buffers = tree->getSourceBufferIds();
+    if (buffers.empty()) {
+      continue;
+    }
+    const auto& source_manager = tree->sourceManager();
+    auto path = source_manager.getFullPath(buffers.front()).string();
+    auto uri = PathToUri(path);
+    jobs.push_back(
+        ShardJob{
+            .tree = tree.get(),
+            .path = std::move(path),
+            .uri = std::move(uri),
+            .text = source_manager.getSourceText(buffers.front()),
+            .index = nullptr});
+  }
+
+  if (!jobs.empty()) {
+    auto barrier = std::make_shared<utils::Barrier>(executor, jobs.size());
+    for (auto& job : jobs) {
+      asio::post(
+          executor,
+          [&job, &previous_shards, &artifact, &cache_dir, &logger,
+           options_key, barrier]() {
+            auto content_hash = utils::HashBytes(job.text);
+            auto shard_path = cache_dir.empty()
+                                  ? std::filesystem::path{}
+                                  : cache_dir / ShardFileName(job.path);
+
+            if (auto it = previous_shards.find(job.uri);
+                it != previous_shards.end() &&
+                it->second->Matches(content_hash, options_key)) {
+              job.index = it->second;
+              job.source = ShardSource::kReused;
+            } else if (artifact) {
+              job.index = artifact->Find(job.path, content_hash, options_key);
+              job.source = ShardSource::kImported;
+            }
+            if (!job.index && !shard_path.empty()) {
+              job.index = FileIndex::Load(
+                  shard_path, job.path, content_hash, options_key);
+              job.source = ShardSource::kLoaded;
+            }
+
+            if (!job.index) {
+              job.index = FileIndex::Build(
+                  job.path, content_hash, options_key,
+                  syntax::CollectIndexEntries(*job.tree));
+              job.source = ShardSource::kCollected;
+              if (!shard_path.empty() && !job.index->Save(shard_path)) {
+                logger->debug(
+                    "WorkspaceIndex: failed to write {}", shard_path.string());
+              }
+            }
+            barrier->Arrive();
+          });
+    }
+    co_await barrier->AsyncWait(asio::use_awaitable);
+  }
+
+  index->files_.reserve(jobs.size());
+  for (auto& job : jobs) {
+    switch (job.source) {
+      case ShardSource::kReused:
+        ++index->stats_.reused;
+        break;
+      case ShardSource::kImported:
+        ++index->stats_.imported;
+        break;
+      case ShardSource::kLoaded:
+        ++index->stats_.loaded;
+        break;
+      case ShardSource::kCollected:
+        ++index->stats_.collected;
+        break;
+    }
+    index->files_.push_back(
+        File{.uri = std::move(job.uri), .index = std::move(job.index)});
+  }
+  std::ranges::sort(index->files_, {}, &File::uri);
+  index->stats_.files = index->files_.size();
+
+  // Linear in the number of declarations; kept off the caller's executor
+  index->symbol_search_ = co_await asio::co_spawn(
+      executor,
+      [&index]() -> asio::awaitable<SymbolSearchIndex> {
+        std::vector<const FileIndex*> shards;
+        shards.reserve(index->files_.size());
+        for (const auto& file : index->files_) {
+          shards.push_back(file.index.get());
+        }
+        co_return SymbolSearchIndex::Build(shards);
+      },
+      asio::use_awaitable);
+
+  // Drop shards of files that left the workspace
+  if (!cache_dir.empty()) {
+    slang::flat_hash_set<std::string> live;
+    for (const auto& job : jobs) {
+      live.insert(ShardFileName(job.path));
+    }
+    std::error_code ec;
+    for (const auto& entry :
+         std::filesystem::directory_iterator(cache_dir, ec)) {
+      auto name = entry.path().filename().string();
+      if (name.ends_with(kShardExtension) && !live.contains(name)) {
+        std::filesystem::remove(entry.path(), ec);
+      }
+    }
+  }
+
+  logger->debug(
+      "WorkspaceIndex: {} files ({} reused, {} imported, {} loaded, {} "
+      "collected), {} KB in memory",
+      index->stats_.files, index->stats_.reused, index->stats_.imported,
+      index->stats_.loaded, index->stats_.collected,
+      index->MemoryUsage() / 1024);
+
+  co_return index;
+}
+
+auto WorkspaceIndex::FromArtifact(const IndexArtifact& artifact)
+    -> std::shared_ptr<const WorkspaceIndex> {
+  auto index = std::make_shared<WorkspaceIndex>();
+  artifact.ForEachSweptShard(
+      [&](std::string_view path, std::shared_ptr<const FileIndex> shard) {
+        index->files_.push_back(
+            File{.uri = PathToUri(path), .index = std::move(shard)});
+      });
+  std::ranges::sort(index->files_, {}, &File::uri);
+  index->stats_.files = index->files_.size();
+  index->stats_.imported = index->files_.size();
+  return index;
+}
+
+auto WorkspaceIndex::DefaultCacheDirectory(const CanonicalPath& workspace_root)
+    -> std::filesystem::path {
+  return workspace_root.Path() / ".cache" / "slangd" / "index";
+}
+
+auto WorkspaceIndex::FindOccurrences(
+    std::string_view name, bool include_declarations) const
+    -> std::vector<lsp::Location> {
+  std::vector<lsp::Location> locations;
+  for (const auto& file : files_) {
+    for (const auto& record : file.index->FindOccurrences(name)) {
+      if (include_declarations || record.is_definition == 0) {
+        locations.push_back(
+            lsp::Location{
+                .uri = file.uri, .range = FileIndex::ToRange(record)});
+      }
+    }
+  }
+  return locations;
+}
+
+auto WorkspaceIndex::FilesAffectedSince(const WorkspaceIndex& previous) const
+    -> std::vector<std::string> {
+  slang::flat_hash_set<std::string> affected;
+  slang::flat_hash_set<std::string_view> declared;
+  auto add_declarations = [&declared](const FileIndex& shard) {
+    for (const auto& symbol : shard.GetSymbols()) {
+      declared.insert(shard.GetName(symbol.name));
+    }
+  };
+
+  for (const auto& file : files_) {
+    const auto* old = previous.GetFile(file.uri);
+    if (old != nullptr && old->Matches(
+                              file.index->GetContentHash(),
+                              file.index->GetOptionsKey())) {
+      continue;
+    }
+    affected.insert(file.uri);
+    // Old names too: uses of a removed or renamed declaration must go
+    add_declarations(*file.index);
+    if (old != nullptr) {
+      add_declarations(*old);
+    }
+  }
+  for (const auto& file : previous.files_) {
+    if (GetFile(file.uri) == nullptr) {
+      add_declarations(*file.index);
+    }
+  }
+
+  for (auto name : declared) {
+    for (const auto& location : FindOccurrences(name, false)) {
+      affected.insert(location.uri);
+    }
+  }
+
+  std::vector<std::string> uris(affected.begin(), affected.end());
+  std::ranges::sort(uris);
+  return uris;
+}
+
+auto WorkspaceIndex::SearchSymbols(std::string_view query, size_t limit) const
+    -> std::vector<lsp::WorkspaceSymbol> {
+  std::vector<lsp::WorkspaceSymbol> symbols;
+  for (const auto& hit : symbol_search_.Search(query, limit)) {
+    const auto& file = files_[hit.file];
+    const auto& record = file.index->GetSymbols()[hit.symbol];
+    std::optional<std::string> container;
+    if (record.container != FileIndex::kNoName) {
+      container = std::string(file.index->GetName(record.container));
+    }
+    symbols.push_back(
+        lsp::WorkspaceSymbol{
+            .name = std::string(file.index->GetName(record.name)),
+            .kind = static_cast<lsp::SymbolKind>(record.kind),
+            .tags = std::nullopt,
+            .containerName = std::move(container),
+            .location =
+                lsp::Location{
+                    .uri = file.uri, .range = FileIndex::ToRange(record)},
+            .data = std::nullopt});
+  }
+  return symbols;
+}
+
+auto WorkspaceIndex::GetFile(std::string_view uri) const -> const FileIndex* {
+  auto it = std::ranges::lower_bound(files_, uri, {}, &File::uri);
+  if (it == files_.end() || it->uri != uri) {
+    return nullptr;
+  }
+  return it->index.get();
+}
+
+auto WorkspaceIndex::ForEachFile(
+    const std::function<void(std::string_view uri, const FileIndex&)>&
+        callback) const -> void {
+  for (const auto& file : files_) {
+    callback(file.uri, *file.index);
+  }
+}
+
+auto WorkspaceIndex::MemoryUsage() const -> size_t {
+  size_t bytes =
+      (files_.capacity() * sizeof(File)) + symbol_search_.MemoryUsage();
+  for (const auto& file : files_) {
+    bytes += file.uri.capacity() + file.index->MemoryUsage();
+  }
+  return bytes;
+}
+
+}  // namespace slangd::services
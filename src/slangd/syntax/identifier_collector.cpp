@@ -0,0 +1,31 @@
+#include "slangd/syntax/identifier_collector.hpp"
+
+#include <vector>
+
+#include <slang/syntax/SyntaxNode.h>
+
+namespace slangd::syntax {
+
+auto CollectIdentifiers(
+    const slang::syntax::SyntaxNode& node,
+    slang::flat_hash_set<std::string_view>& names) -> void {
+  // Iterative walk: deeply nested expressions would overflow a recursive one
+  std::vector<const slang::syntax::SyntaxNode*> stack{&node};
+  while (!stack.empty()) {
+    const auto* current = stack.back();
+    stack.pop_back();
+
+    for (size_t i = 0; i < current->getChildCount(); ++i) {
+      if (const auto* child = current->childNode(i)) {
+        stack.push_back(child);
+        continue;
+      }
+      auto token = current->childToken(i);
+      if (token.kind == slang::parsing::TokenKind::Identifier) {
+        names.insert(token.valueText());
+      }
+    }
+  }
+}
+
+}  // namespace slangd::syntax
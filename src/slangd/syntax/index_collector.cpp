@@ -0,0 +1,223 @@
+#include "slangd/syntax/index_collector.hpp"
+
+#include <algorithm>
+#include <optional>
+
+#include <slang/syntax/AllSyntax.h>
+#include <slang/syntax/SyntaxTree.h>
+#include <slang/text/SourceManager.h>
+#include <slang/util/Hash.h>
+
+#include "slangd/utils/line_index.hpp"
+
+namespace slangd::syntax {
+
+namespace {
+
+using slang::parsing::Token;
+using slang::parsing::TokenKind;
+using slang::syntax::SyntaxKind;
+using slang::syntax::SyntaxNode;
+
+class IndexCollector {
+ public:
+  IndexCollector(
+      const slang::SourceManager& source_manager, slang::BufferID buffer)
+      : buffer_(buffer), line_index_(source_manager.getSourceText(buffer)) {
+  }
+
+  auto Run(const SyntaxNode& root) -> IndexedFile {
+    // Iterative walk: deeply nested expressions would overflow a recursive
+    // one. Declarations are recorded when their node is popped, before the
+    // name token (a descendant) is reached.
+    std::vector<Frame> stack{{.node = &root, .container = {}}};
+    while (!stack.empty()) {
+      auto [node, container] = stack.back();
+      stack.pop_back();
+
+      auto child_container = AddDeclarations(*node, container);
+      for (size_t i = node->getChildCount(); i-- > 0;) {
+        if (const auto* child = node->childNode(i)) {
+          stack.push_back({.node = child, .container = child_container});
+          continue;
+        }
+        AddOccurrence(node->childToken(i));
+      }
+    }
+
+    std::ranges::sort(result_.symbols, {}, [](const IndexedSymbol& symbol) {
+      return symbol.range.start;
+    });
+    std::ranges::sort(result_.occurrences, {}, [](const auto& occurrence) {
+      return occurrence.range.start;
+    });
+    return std::move(result_);
+  }
+
+ private:
+  struct Frame {
+    const SyntaxNode* node;
+    std::string_view container;
+  };
+
+  // Range of a token of this file's own buffer, nullopt otherwise
+  [[nodiscard]] auto ToRange(Token token) const -> std::optional<lsp::Range> {
+    auto location = token.location();
+    if (token.isMissing() || location.buffer() != buffer_) {
+      return std::nullopt;
+    }
+    auto start = line_index_.PositionAt(location.offset());
+    auto end = start;
+    end.character += static_cast<int>(token.rawText().size());
+    return lsp::Range{.start = start, .end = end};
+  }
+
+  auto AddSymbol(Token name, lsp::SymbolKind kind, std::string_view container)
+      -> void {
+    if (name.valueText().empty()) {
+      return;
+    }
+    if (auto range = ToRange(name)) {
+      result_.symbols.push_back(
+          IndexedSymbol{
+              .name = name.valueText(),
+              .container = container,
+              .kind = kind,
+              .range = *range});
+      definition_offsets_.insert(name.location().offset());
+    }
+  }
+
+  auto AddOccurrence(Token token) -> void {
+    if (token.kind != TokenKind::Identifier || token.valueText().empty()) {
+      return;
+    }
+    if (auto range = ToRange(token)) {
+      result_.occurrences.push_back(
+          IndexedOccurrence{
+              .name = token.valueText(),
+              .range = *range,
+              .is_definition =
+                  definition_offsets_.contains(token.location().offset())});
+    }
+  }
+
+  template <typename Declarators>
+  auto AddDeclarators(
+      const Declarators& declarators, lsp::SymbolKind kind,
+      std::string_view container) -> void {
+    for (const auto& declarator : declarators) {
+      AddSymbol(declarator->name, kind, container);
+    }
+  }
+
+  // Record what `node` declares; returns the container for its children
+  auto AddDeclarations(const SyntaxNode& node, std::string_view container)
+      -> std::string_view {
+    using namespace slang::syntax;
+
+    switch (node.kind) {
+      case SyntaxKind::ModuleDeclaration:
+      case SyntaxKind::InterfaceDeclaration:
+      case SyntaxKind::PackageDeclaration:
+      case SyntaxKind::ProgramDeclaration: {
+        auto kind = lsp::SymbolKind::kModule;
+        if (node.kind == SyntaxKind::PackageDeclaration) {
+          kind = lsp::SymbolKind::kPackage;
+        } else if (node.kind == SyntaxKind::InterfaceDeclaration) {
+          kind = lsp::SymbolKind::kInterface;
+        }
+        auto name = node.as<ModuleDeclarationSyntax>().header->name;
+        AddSymbol(name, kind, container);
+        return name.valueText();
+      }
+      case SyntaxKind::ClassDeclaration: {
+        auto name = node.as<ClassDeclarationSyntax>().name;
+        AddSymbol(name, lsp::SymbolKind::kClass, container);
+        return name.valueText();
+      }
+      case SyntaxKind::FunctionDeclaration:
+      case SyntaxKind::TaskDeclaration: {
+        const auto& prototype = *node.as<FunctionDeclarationSyntax>().prototype;
+        auto name = prototype.name->getLastToken();
+        AddSymbol(name, lsp::SymbolKind::kFunction, container);
+        return name.valueText();
+      }
+      case SyntaxKind::TypedefDeclaration: {
+        const auto& typedef_syntax = node.as<TypedefDeclarationSyntax>();
+        auto kind = lsp::SymbolKind::kClass;
+        if (typedef_syntax.type != nullptr) {
+          if (typedef_syntax.type->kind == SyntaxKind::EnumType) {
+            kind = lsp::SymbolKind::kEnum;
+          } else if (typedef_syntax.type->kind == SyntaxKind::StructType) {
+            kind = lsp::SymbolKind::kStruct;
+          }
+        }
+        AddSymbol(typedef_syntax.name, kind, container);
+        break;
+      }
+      case SyntaxKind::ParameterDeclaration:
+        AddDeclarators(
+            node.as<ParameterDeclarationSyntax>().declarators,
+            lsp::SymbolKind::kConstant, container);
+        break;
+      case SyntaxKind::TypeParameterDeclaration:
+        AddDeclarators(
+            node.as<TypeParameterDeclarationSyntax>().declarators,
+            lsp::SymbolKind::kTypeParameter, container);
+        break;
+      case SyntaxKind::DataDeclaration:
+        AddDeclarators(
+            node.as<DataDeclarationSyntax>().declarators,
+            lsp::SymbolKind::kVariable, container);
+        break;
+      case SyntaxKind::NetDeclaration:
+        AddDeclarators(
+            node.as<NetDeclarationSyntax>().declarators,
+            lsp::SymbolKind::kVariable, container);
+        break;
+      case SyntaxKind::EnumType:
+        AddDeclarators(
+            node.as<EnumTypeSyntax>().members, lsp::SymbolKind::kEnumMember,
+            container);
+        break;
+      case SyntaxKind::StructType:
+      case SyntaxKind::UnionType:
+        for (const auto& member : node.as<StructUnionTypeSyntax>().members) {
+          AddDeclarators(
+              member->declarators, lsp::SymbolKind::kField, container);
+        }
+        break;
+      case SyntaxKind::ImplicitAnsiPort: {
+        const auto& port = node.as<ImplicitAnsiPortSyntax>();
+        if (port.declarator != nullptr) {
+          AddSymbol(
+              port.declarator->name, lsp::SymbolKind::kVariable, container);
+        }
+        break;
+      }
+      default:
+        break;
+    }
+    return container;
+  }
+
+  slang::BufferID buffer_;
+  utils::LineIndex line_index_;
+  slang::flat_hash_set<size_t> definition_offsets_;
+  IndexedFile result_;
+};
+
+}  // namespace
+
+auto CollectIndexEntries(const slang::syntax::SyntaxTree& tree)
+    -> IndexedFile {
+  auto buffers = tree.getSourceBufferIds();
+  if (buffers.empty()) {
+    return {};
+  }
+  IndexCollector collector(tree.sourceManager(), buffers.front());
+  return collector.Run(tree.root());
+}
+
+}  // namespace slangd::syntax
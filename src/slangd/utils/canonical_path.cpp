@@ -12,6 +12,13 @@ auto CanonicalPath::FromUri(std::string_view uri) -> CanonicalPath {
   return CanonicalPath(UriToPath(uri));
 }
 
+auto CanonicalPath::FromNormalized(std::filesystem::path path)
+    -> CanonicalPath {
+  CanonicalPath result;
+  result.path_ = std::move(path);
+  return result;
+}
+
 auto CanonicalPath::CurrentPath() -> CanonicalPath {
   return CanonicalPath(std::filesystem::current_path());
 }
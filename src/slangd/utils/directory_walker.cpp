@@ -0,0 +1,208 @@
+#include "slangd/utils/directory_walker.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+
+namespace slangd::utils {
+
+namespace {
+
+class ParallelWalker {
+ public:
+  ParallelWalker(
+      const DirectoryWalkOptions& options, size_t num_threads,
+      std::shared_ptr<spdlog::logger> logger)
+      : options_(options), workers_(num_threads), logger_(std::move(logger)) {
+  }
+
+  auto Run(const std::vector<CanonicalPath>& roots)
+      -> std::vector<CanonicalPath> {
+    for (size_t i = 0; i < roots.size(); ++i) {
+      Push(i % workers_.size(), roots[i].Path());
+    }
+
+    {
+      std::vector<std::jthread> threads;
+      threads.reserve(workers_.size());
+      for (size_t i = 0; i < workers_.size(); ++i) {
+        threads.emplace_back([this, i]() { WorkerLoop(i); });
+      }
+    }
+
+    std::vector<CanonicalPath> files;
+    for (auto& worker : workers_) {
+      files.insert(
+          files.end(), std::make_move_iterator(worker.files.begin()),
+          std::make_move_iterator(worker.files.end()));
+    }
+    return files;
+  }
+
+ private:
+  struct Worker {
+    std::mutex mutex;
+    std::deque<std::filesystem::path> pending;
+    // Only touched by the owning thread
+    std::vector<CanonicalPath> files;
+  };
+
+  auto Push(size_t self, std::filesystem::path directory) -> void {
+    outstanding_.fetch_add(1, std::memory_order_relaxed);
+    {
+      std::lock_guard lock(workers_[self].mutex);
+      workers_[self].pending.push_back(std::move(directory));
+    }
+    // Wake a parked worker to steal it
+    signal_.fetch_add(1, std::memory_order_release);
+    signal_.notify_one();
+  }
+
+  // Newest own work first (depth-first, cache friendly); otherwise steal the
+  // oldest directory of another worker (likely the largest subtree)
+  auto Pop(size_t self) -> std::optional<std::filesystem::path> {
+    {
+      auto& own = workers_[self];
+      std::lock_guard lock(own.mutex);
+      if (!own.pending.empty()) {
+        auto directory = std::move(own.pending.back());
+        own.pending.pop_back();
+        return directory;
+      }
+    }
+    for (size_t offset = 1; offset < workers_.size(); ++offset) {
+      auto& victim = workers_[(self + offset) % workers_.size()];
+      std::lock_guard lock(victim.mutex);
+      if (!victim.pending.empty()) {
+        auto directory = std::move(victim.pending.front());
+        victim.pending.pop_front();
+        return directory;
+      }
+    }
+    return std::nullopt;
+  }
+
+  auto WorkerLoop(size_t self) -> void {
+    while (true) {
+      // Read before looking for work: any later push or the end of the walk
+      // changes it, so the wait below cannot miss a wakeup
+      auto signal = signal_.load(std::memory_order_acquire);
+      if (auto directory = Pop(self)) {
+        ScanDirectory(self, *directory);
+        // Children were pushed before this, so zero means the walk is done
+        if (outstanding_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+          signal_.fetch_add(1, std::memory_order_release);
+          signal_.notify_all();
+        }
+        continue;
+      }
+      if (outstanding_.load(std::memory_order_acquire) == 0) {
+        return;
+      }
+      // Park instead of spinning while other workers scan
+      signal_.wait(signal, std::memory_order_acquire);
+    }
+  }
+
+  auto ScanDirectory(size_t self, const std::filesystem::path& directory)
+      -> void {
+    DIR* handle = opendir(directory.c_str());
+    if (handle == nullptr) {
+      logger_->debug(
+          "WalkDirectories: cannot open {}: {}", directory.string(),
+          std::strerror(errno));
+      return;
+    }
+
+    while (const auto* entry = readdir(handle)) {
+      std::string_view name(entry->d_name);
+      if (name == "." || name == "..") {
+        continue;
+      }
+
+      auto type = entry->d_type;
+      if (type == DT_UNKNOWN) {
+        // Filesystem doesn't report types (some network mounts)
+        struct stat info{};
+        if (fstatat(dirfd(handle), entry->d_name, &info, AT_SYMLINK_NOFOLLOW) !=
+            0) {
+          continue;
+        }
+        type = S_ISDIR(info.st_mode)   ? DT_DIR
+               : S_ISREG(info.st_mode) ? DT_REG
+               : S_ISLNK(info.st_mode) ? DT_LNK
+                                       : DT_UNKNOWN;
+      }
+
+      if (type == DT_DIR) {
+        auto child = directory / name;
+        if (!options_.should_descend || options_.should_descend(child)) {
+          Push(self, std::move(child));
+        }
+      } else if (type == DT_REG) {
+        if (options_.should_collect(name)) {
+          workers_[self].files.push_back(
+              CanonicalPath::FromNormalized(directory / name));
+        }
+      } else if (type == DT_LNK && options_.should_collect(name)) {
+        // Symlinked files are collected by their resolved path
+        struct stat info{};
+        if (fstatat(dirfd(handle), entry->d_name, &info, 0) == 0 &&
+            S_ISREG(info.st_mode)) {
+          workers_[self].files.emplace_back(directory / name);
+        }
+      }
+    }
+    closedir(handle);
+  }
+
+  const DirectoryWalkOptions& options_;
+  std::vector<Worker> workers_;
+  std::atomic<size_t> outstanding_{0};
+  // Bumped on every push and when the walk ends; idle workers wait on it
+  std::atomic<uint32_t> signal_{0};
+  std::shared_ptr<spdlog::logger> logger_;
+};
+
+}  // namespace
+
+auto WalkDirectories(
+    const std::vector<CanonicalPath>& roots,
+    const DirectoryWalkOptions& options, std::shared_ptr<spdlog::logger> logger)
+    -> std::vector<CanonicalPath> {
+  logger = logger ? logger : spdlog::default_logger();
+
+  // Drop roots nested in other roots so no subtree is walked twice
+  auto sorted_roots = roots;
+  std::sort(sorted_roots.begin(), sorted_roots.end());
+  std::vector<CanonicalPath> unique_roots;
+  for (const auto& root : sorted_roots) {
+    if (std::ranges::none_of(unique_roots, [&](const CanonicalPath& kept) {
+          return root.IsSubPathOf(kept);
+        })) {
+      unique_roots.push_back(root);
+    }
+  }
+
+  auto num_threads = options.num_threads;
+  if (num_threads == 0) {
+    num_threads = std::max(1U, std::thread::hardware_concurrency());
+  }
+
+  ParallelWalker walker(options, num_threads, logger);
+  auto files = walker.Run(unique_roots);
+  std::sort(files.begin(), files.end());
+  return files;
+}
+
+}  // namespace slangd::utils
@@ -0,0 +1,113 @@
+#include "slangd/utils/hash.hpp"
+
+#include <bit>
+#include <cstring>
+
+namespace slangd::utils {
+
+namespace {
+
+constexpr uint64_t kPrime1 = 0x9E3779B185EBCA87ULL;
+constexpr uint64_t kPrime2 = 0xC2B2AE3D27D4EB4FULL;
+constexpr uint64_t kPrime3 = 0x165667B19E3779F9ULL;
+constexpr uint64_t kPrime4 = 0x85EBCA77C2B2AE63ULL;
+constexpr uint64_t kPrime5 = 0x27D4EB2F165667C5ULL;
+
+auto Read64(const char* p) -> uint64_t {
+  uint64_t value = 0;
+  std::memcpy(&value, p, sizeof(value));
+  if constexpr (std::endian::native == std::endian::big) {
+    value = std::byteswap(value);
+  }
+  return value;
+}
+
+auto Read32(const char* p) -> uint32_t {
+  uint32_t value = 0;
+  std::memcpy(&value, p, sizeof(value));
+  if constexpr (std::endian::native == std::endian::big) {
+    value = std::byteswap(value);
+  }
+  return value;
+}
+
+auto Round(uint64_t acc, uint64_t input) -> uint64_t {
+  acc += input * kPrime2;
+  acc = std::rotl(acc, 31);
+  return acc * kPrime1;
+}
+
+auto MergeRound(uint64_t acc, uint64_t value) -> uint64_t {
+  acc ^= Round(0, value);
+  return acc * kPrime1 + kPrime4;
+}
+
+auto Avalanche(uint64_t hash) -> uint64_t {
+  hash ^= hash >> 33;
+  hash *= kPrime2;
+  hash ^= hash >> 29;
+  hash *= kPrime3;
+  hash ^= hash >> 32;
+  return hash;
+}
+
+}  // namespace
+
+auto HashBytes(std::string_view data, uint64_t seed) -> uint64_t {
+  const char* p = data.data();
+  const char* end = p + data.size();
+  uint64_t hash = 0;
+
+  if (data.size() >= 32) {
+    uint64_t v1 = seed + kPrime1 + kPrime2;
+    uint64_t v2 = seed + kPrime2;
+    uint64_t v3 = seed;
+    uint64_t v4 = seed - kPrime1;
+
+    const char* limit = end - 32;
+    do {
+      v1 = Round(v1, Read64(p));
+      v2 = Round(v2, Read64(p + 8));
+      v3 = Round(v3, Read64(p + 16));
+      v4 = Round(v4, Read64(p + 24));
+      p += 32;
+    } while (p <= limit);
+
+    hash = std::rotl(v1, 1) + std::rotl(v2, 7) + std::rotl(v3, 12) +
+           std::rotl(v4, 18);
+    hash = MergeRound(hash, v1);
+    hash = MergeRound(hash, v2);
+    hash = MergeRound(hash, v3);
+    hash = MergeRound(hash, v4);
+  } else {
+    hash = seed + kPrime5;
+  }
+
+  hash += static_cast<uint64_t>(data.size());
+
+  while (p + 8 <= end) {
+    hash ^= Round(0, Read64(p));
+    hash = std::rotl(hash, 27) * kPrime1 + kPrime4;
+    p += 8;
+  }
+
+  if (p + 4 <= end) {
+    hash ^= static_cast<uint64_t>(Read32(p)) * kPrime1;
+    hash = std::rotl(hash, 23) * kPrime2 + kPrime3;
+    p += 4;
+  }
+
+  while (p < end) {
+    hash ^= static_cast<uint64_t>(static_cast<unsigned char>(*p)) * kPrime5;
+    hash = std::rotl(hash, 11) * kPrime1;
+    ++p;
+  }
+
+  return Avalanche(hash);
+}
+
+auto HashCombine(uint64_t hash, uint64_t value) -> uint64_t {
+  return Avalanche(Round(hash, value) + kPrime4);
+}
+
+}  // namespace slangd::utils
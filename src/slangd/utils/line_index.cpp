@@ -0,0 +1,53 @@
+#include "slangd/utils/line_index.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace slangd::utils {
+
+LineIndex::LineIndex(std::string_view text) : size_(text.size()) {
+  // Typical source lines are 30-40 bytes
+  line_starts_.reserve((text.size() / 32) + 1);
+  line_starts_.push_back(0);
+
+  const char* begin = text.data();
+  const char* end = begin + text.size();
+  const char* cursor = begin;
+  while (cursor < end) {
+    const auto* newline = static_cast<const char*>(
+        std::memchr(cursor, '\n', static_cast<size_t>(end - cursor)));
+    if (newline == nullptr) {
+      break;
+    }
+    line_starts_.push_back(static_cast<size_t>(newline - begin) + 1);
+    cursor = newline + 1;
+  }
+}
+
+auto LineIndex::OffsetAt(const lsp::Position& position) const -> size_t {
+  if (position.line < 0) {
+    return 0;
+  }
+  auto line = static_cast<size_t>(position.line);
+  if (line >= line_starts_.size()) {
+    return size_;
+  }
+
+  auto line_start = line_starts_[line];
+  // Line end is the '\n' position (or the end of the buffer)
+  auto line_end =
+      line + 1 < line_starts_.size() ? line_starts_[line + 1] - 1 : size_;
+  auto column = static_cast<size_t>(std::max(position.character, 0));
+  return std::min(line_start + column, line_end);
+}
+
+auto LineIndex::PositionAt(size_t offset) const -> lsp::Position {
+  offset = std::min(offset, size_);
+  auto it = std::ranges::upper_bound(line_starts_, offset);
+  auto line = static_cast<size_t>(it - line_starts_.begin()) - 1;
+  return lsp::Position{
+      .line = static_cast<int>(line),
+      .character = static_cast<int>(offset - line_starts_[line])};
+}
+
+}  // namespace slangd::utils
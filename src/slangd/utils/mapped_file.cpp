@@ -0,0 +1,61 @@
+#include "slangd/utils/mapped_file.hpp"
+
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace slangd::utils {
+
+auto MappedFile::Open(const std::filesystem::path& path)
+    -> std::optional<MappedFile> {
+  int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    return std::nullopt;
+  }
+
+  struct stat info{};
+  if (fstat(fd, &info) != 0 || info.st_size <= 0) {
+    close(fd);
+    return std::nullopt;
+  }
+
+  auto size = static_cast<size_t>(info.st_size);
+  void* address = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  // The mapping keeps its own reference to the file
+  close(fd);
+  if (address == MAP_FAILED) {
+    return std::nullopt;
+  }
+  return MappedFile(address, size);
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : address_(std::exchange(other.address_, nullptr)),
+      size_(std::exchange(other.size_, 0)) {
+}
+
+auto MappedFile::operator=(MappedFile&& other) noexcept -> MappedFile& {
+  if (this != &other) {
+    Reset();
+    address_ = std::exchange(other.address_, nullptr);
+    size_ = std::exchange(other.size_, 0);
+  }
+  return *this;
+}
+
+MappedFile::~MappedFile() {
+  Reset();
+}
+
+auto MappedFile::Reset() -> void {
+  if (address_ != nullptr) {
+    munmap(address_, size_);
+    address_ = nullptr;
+    size_ = 0;
+  }
+}
+
+}  // namespace slangd::utils
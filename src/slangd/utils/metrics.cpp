@@ -0,0 +1,181 @@
+#include "slangd/utils/metrics.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <fstream>
+
+#include <unistd.h>
+
+namespace slangd::utils {
+
+namespace {
+
+template <typename T>
+auto GetOrCreate(
+    std::map<std::string, std::unique_ptr<T>, std::less<>>& registry,
+    std::string_view name) -> T& {
+  auto it = registry.find(name);
+  if (it == registry.end()) {
+    it = registry.emplace(std::string(name), std::make_unique<T>()).first;
+  }
+  return *it->second;
+}
+
+}  // namespace
+
+auto Histogram::Record(uint64_t value) -> void {
+  buckets_[BucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+  sum_.fetch_add(value, std::memory_order_relaxed);
+
+  auto min = min_.load(std::memory_order_relaxed);
+  while (value < min &&
+         !min_.compare_exchange_weak(min, value, std::memory_order_relaxed)) {
+  }
+  auto max = max_.load(std::memory_order_relaxed);
+  while (value > max &&
+         !max_.compare_exchange_weak(max, value, std::memory_order_relaxed)) {
+  }
+}
+
+auto Histogram::Summarize() const -> Summary {
+  // Concurrent Record() calls may land between these loads; the summary is
+  // approximate while recording, like any sampled metric
+  std::array<uint64_t, kBucketCount> counts{};
+  Summary summary;
+  for (size_t i = 0; i < kBucketCount; ++i) {
+    counts[i] = buckets_[i].load(std::memory_order_relaxed);
+    summary.count += counts[i];
+  }
+  if (summary.count == 0) {
+    return summary;
+  }
+  summary.sum = sum_.load(std::memory_order_relaxed);
+  summary.min = min_.load(std::memory_order_relaxed);
+  summary.max = max_.load(std::memory_order_relaxed);
+
+  // Smallest bucket whose cumulative count reaches the rank, reported as the
+  // bucket's upper bound (never above the recorded maximum)
+  auto percentile = [&](uint64_t per_mille) {
+    auto rank = std::max<uint64_t>(
+        1, ((summary.count * per_mille) + 999) / 1000);
+    uint64_t seen = 0;
+    for (size_t i = 0; i < kBucketCount; ++i) {
+      seen += counts[i];
+      if (seen >= rank) {
+        return std::min(BucketUpperBound(i), summary.max);
+      }
+    }
+    return summary.max;
+  };
+  summary.p50 = percentile(500);
+  summary.p90 = percentile(900);
+  summary.p99 = percentile(990);
+  return summary;
+}
+
+auto Histogram::BucketIndex(uint64_t value) -> size_t {
+  if (value < kSubBuckets) {
+    return static_cast<size_t>(value);
+  }
+  // Top kSubBucketBits bits below the leading one pick the sub-bucket
+  auto magnitude = static_cast<size_t>(std::bit_width(value)) - 1;
+  auto shift = magnitude - kSubBucketBits;
+  auto sub_bucket = static_cast<size_t>(value >> shift) - kSubBuckets;
+  return kSubBuckets + (shift * kSubBuckets) + sub_bucket;
+}
+
+auto Histogram::BucketUpperBound(size_t index) -> uint64_t {
+  if (index < kSubBuckets) {
+    return index;
+  }
+  auto shift = (index - kSubBuckets) / kSubBuckets;
+  auto sub_bucket = (index - kSubBuckets) % kSubBuckets;
+  auto lower = uint64_t{kSubBuckets + sub_bucket} << shift;
+  return lower + ((uint64_t{1} << shift) - 1);
+}
+
+LatencyTimer::~LatencyTimer() {
+  auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - start_);
+  histogram_.Record(static_cast<uint64_t>(elapsed.count()));
+}
+
+auto Metrics::Instance() -> Metrics& {
+  // Never destroyed: worker threads may still record during shutdown
+  static auto* instance = new Metrics();
+  return *instance;
+}
+
+auto Metrics::GetCounter(std::string_view name) -> Counter& {
+  std::lock_guard lock(mutex_);
+  return GetOrCreate(counters_, name);
+}
+
+auto Metrics::GetGauge(std::string_view name) -> Gauge& {
+  std::lock_guard lock(mutex_);
+  return GetOrCreate(gauges_, name);
+}
+
+auto Metrics::GetHistogram(std::string_view name) -> Histogram& {
+  std::lock_guard lock(mutex_);
+  return GetOrCreate(histograms_, name);
+}
+
+auto Metrics::ExportJson() const -> nlohmann::json {
+  auto uptime = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - start_);
+  nlohmann::json result{
+      {"uptimeMs", uptime.count()},
+      {"rssBytes", ResidentBytes()},
+      {"counters", nlohmann::json::object()},
+      {"gauges", nlohmann::json::object()},
+      {"histograms", nlohmann::json::object()},
+      {"hitRates", nlohmann::json::object()}};
+
+  std::lock_guard lock(mutex_);
+  for (const auto& [name, counter] : counters_) {
+    result["counters"][name] = counter->Value();
+  }
+  for (const auto& [name, gauge] : gauges_) {
+    result["gauges"][name] = gauge->Value();
+  }
+  for (const auto& [name, histogram] : histograms_) {
+    auto summary = histogram->Summarize();
+    result["histograms"][name] = {
+        {"count", summary.count}, {"sum", summary.sum},
+        {"min", summary.min},     {"p50", summary.p50},
+        {"p90", summary.p90},     {"p99", summary.p99},
+        {"max", summary.max}};
+  }
+
+  constexpr std::string_view kHitsSuffix = ".hits";
+  for (const auto& [name, hits] : counters_) {
+    if (!name.ends_with(kHitsSuffix)) {
+      continue;
+    }
+    auto prefix = name.substr(0, name.size() - kHitsSuffix.size());
+    auto misses = counters_.find(prefix + ".misses");
+    if (misses == counters_.end()) {
+      continue;
+    }
+    auto total = hits->Value() + misses->second->Value();
+    if (total > 0) {
+      result["hitRates"][prefix] =
+          static_cast<double>(hits->Value()) / static_cast<double>(total);
+    }
+  }
+  return result;
+}
+
+auto Metrics::ResidentBytes() -> size_t {
+  // statm: total and resident sizes in pages
+  std::ifstream statm("/proc/self/statm");
+  size_t total_pages = 0;
+  size_t resident_pages = 0;
+  if (!(statm >> total_pages >> resident_pages)) {
+    return 0;
+  }
+  return resident_pages * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+}
+
+}  // namespace slangd::utils
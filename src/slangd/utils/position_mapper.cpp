@@ -0,0 +1,93 @@
+#include "slangd/utils/position_mapper.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace slangd::utils {
+
+namespace {
+
+// Line/column of the end of `prefix`
+auto EndOf(std::string_view prefix) -> std::pair<int, int> {
+  auto line = std::ranges::count(prefix, '\n');
+  auto last_newline = prefix.rfind('\n');
+  auto column = last_newline == std::string_view::npos
+                    ? prefix.size()
+                    : prefix.size() - last_newline - 1;
+  return {static_cast<int>(line), static_cast<int>(column)};
+}
+
+}  // namespace
+
+PositionMapper::PositionMapper(
+    std::string_view old_text, std::string_view new_text) {
+  auto limit = std::min(old_text.size(), new_text.size());
+  size_t prefix = 0;
+  while (prefix < limit && old_text[prefix] == new_text[prefix]) {
+    ++prefix;
+  }
+  size_t suffix = 0;
+  while (suffix < limit - prefix &&
+         old_text[old_text.size() - suffix - 1] ==
+             new_text[new_text.size() - suffix - 1]) {
+    ++suffix;
+  }
+
+  auto to_point = [](std::string_view text) {
+    auto [line, character] = EndOf(text);
+    return Point{.line = line, .character = character};
+  };
+  change_start_ = to_point(old_text.substr(0, prefix));
+  old_end_ = to_point(old_text.substr(0, old_text.size() - suffix));
+  new_end_ = to_point(new_text.substr(0, new_text.size() - suffix));
+}
+
+auto PositionMapper::ToOld(const lsp::Position& position) const
+    -> std::optional<lsp::Position> {
+  return Map(position, new_end_, old_end_);
+}
+
+auto PositionMapper::ToNew(const lsp::Position& position) const
+    -> std::optional<lsp::Position> {
+  return Map(position, old_end_, new_end_);
+}
+
+auto PositionMapper::ToNew(const lsp::Range& range) const
+    -> std::optional<lsp::Range> {
+  auto start = ToNew(range.start);
+  auto end = ToNew(range.end);
+  if (!start || !end) {
+    return std::nullopt;
+  }
+  // A range spanning the changed region no longer describes the same text
+  Point old_start{.line = range.start.line, .character = range.start.character};
+  Point old_end{.line = range.end.line, .character = range.end.character};
+  if (old_start < change_start_ && old_end > change_start_) {
+    return std::nullopt;
+  }
+  return lsp::Range{.start = *start, .end = *end};
+}
+
+auto PositionMapper::Map(
+    const lsp::Position& position, Point from_end, Point to_end) const
+    -> std::optional<lsp::Position> {
+  Point point{.line = position.line, .character = position.character};
+  if (point < change_start_) {
+    return position;
+  }
+  if (point < from_end) {
+    return std::nullopt;
+  }
+
+  // After the change: lines shift, and so do columns on its last line
+  if (point.line == from_end.line) {
+    return lsp::Position{
+        .line = to_end.line,
+        .character = to_end.character + (point.character - from_end.character)};
+  }
+  return lsp::Position{
+      .line = point.line + (to_end.line - from_end.line),
+      .character = point.character};
+}
+
+}  // namespace slangd::utils
@@ -0,0 +1,120 @@
+#include "slangd/utils/priority_scheduler.hpp"
+
+#include <algorithm>
+#include <exception>
+
+#include <fmt/format.h>
+
+#include "slangd/utils/tracer.hpp"
+
+namespace slangd::utils {
+
+PriorityScheduler::PriorityScheduler(
+    size_t num_threads, std::shared_ptr<spdlog::logger> logger)
+    : thread_count_(std::max(size_t{1}, num_threads)),
+      queued_gauge_(Metrics::Instance().GetGauge("scheduler.queued")),
+      running_gauge_(Metrics::Instance().GetGauge("scheduler.running")),
+      logger_(logger ? logger : spdlog::default_logger()) {
+  workers_.reserve(thread_count_);
+  for (size_t i = 0; i < thread_count_; ++i) {
+    workers_.emplace_back([this, i]() {
+      Tracer::Instance().SetThreadName(fmt::format("scheduler-{}", i));
+      WorkerLoop();
+    });
+  }
+}
+
+PriorityScheduler::~PriorityScheduler() {
+  Join();
+  // Shut down services (e.g. strands) before dropping leftover handlers
+  shutdown();
+  for (auto& queue : queues_) {
+    queue.clear();
+  }
+}
+
+auto PriorityScheduler::DefaultThreadCount() -> size_t {
+  auto hw_threads = static_cast<size_t>(std::thread::hardware_concurrency());
+  return hw_threads > 1 ? hw_threads - 1 : 1;
+}
+
+auto PriorityScheduler::Join() -> void {
+  {
+    std::lock_guard lock(mutex_);
+    draining_ = true;
+  }
+  condition_.notify_all();
+
+  for (auto& worker : workers_) {
+    if (worker.joinable() && worker.get_id() != std::this_thread::get_id()) {
+      worker.join();
+    }
+  }
+  std::lock_guard lock(mutex_);
+  stopped_ = true;
+}
+
+auto PriorityScheduler::Enqueue(
+    TaskPriority priority, std::move_only_function<void()> task) -> void {
+  {
+    std::lock_guard lock(mutex_);
+    if (stopped_) {
+      // Nothing runs it: the owner joined while work was still being posted
+      logger_->warn("Task posted after Join will never run");
+    }
+    queues_[static_cast<size_t>(priority)].push_back(std::move(task));
+    ++pending_;
+    PublishLocked();
+  }
+  condition_.notify_one();
+}
+
+auto PriorityScheduler::WorkerLoop() -> void {
+  while (true) {
+    std::move_only_function<void()> task;
+    {
+      std::unique_lock lock(mutex_);
+      condition_.wait(lock, [this]() {
+        return pending_ > 0 || (draining_ && running_ == 0);
+      });
+      if (pending_ == 0) {
+        // Draining and nothing left that could post more work
+        condition_.notify_all();
+        return;
+      }
+
+      auto queue = std::ranges::find_if(
+          queues_, [](const auto& q) { return !q.empty(); });
+      task = std::move(queue->front());
+      queue->pop_front();
+      --pending_;
+      ++running_;
+      PublishLocked();
+    }
+
+    try {
+      task();
+    } catch (const std::exception& e) {
+      logger_->error("PriorityScheduler: task threw: {}", e.what());
+    } catch (...) {
+      logger_->error("PriorityScheduler: task threw unknown exception");
+    }
+    task = nullptr;
+
+    {
+      std::lock_guard lock(mutex_);
+      --running_;
+      PublishLocked();
+      if (draining_ && running_ == 0 && pending_ == 0) {
+        condition_.notify_all();
+      }
+    }
+  }
+}
+
+auto PriorityScheduler::PublishLocked() -> void {
+  queued_gauge_.Set(static_cast<int64_t>(pending_));
+  running_gauge_.Set(static_cast<int64_t>(running_));
+}
+
+}  // namespace slangd::utils
@@ -2,11 +2,14 @@
 
 #include <fmt/format.h>
 
+#include "slangd/utils/tracer.hpp"
+
 namespace slangd::utils {
 
 ScopedTimer::ScopedTimer(
     std::string operation_name, std::shared_ptr<spdlog::logger> logger)
     : start_(std::chrono::steady_clock::now()),
+      thread_(Tracer::CurrentThreadId()),
       operation_name_(std::move(operation_name)),
       logger_(logger ? logger : spdlog::default_logger()) {
 }
@@ -14,6 +17,18 @@ ScopedTimer::ScopedTimer(
 ScopedTimer::~ScopedTimer() {
   auto elapsed = GetElapsed();
   logger_->debug("{} completed ({})", operation_name_, FormatDuration(elapsed));
+
+  Tracer::Instance().Record(
+      Tracer::Span{
+          .name = std::move(operation_name_),
+          .category = "timer",
+          .start_us = std::chrono::duration_cast<std::chrono::microseconds>(
+                          start_.time_since_epoch())
+                          .count(),
+          .end_us = Tracer::NowMicros(),
+          .begin_thread = thread_,
+          .end_thread = Tracer::CurrentThreadId(),
+          .request_id = 0});
 }
 
 auto ScopedTimer::GetElapsed() const -> std::chrono::milliseconds {
@@ -0,0 +1,35 @@
+#include "slangd/utils/string_interner.hpp"
+
+namespace slangd::utils {
+
+auto StringInterner::Intern(std::string_view text) -> Id {
+  if (auto it = ids_.find(text); it != ids_.end()) {
+    return it->second;
+  }
+
+  auto id = static_cast<Id>(strings_.size());
+  const auto& stored = strings_.emplace_back(text);
+  ids_.emplace(std::string_view(stored), id);
+  return id;
+}
+
+auto StringInterner::Find(std::string_view text) const -> std::optional<Id> {
+  if (auto it = ids_.find(text); it != ids_.end()) {
+    return it->second;
+  }
+  return std::nullopt;
+}
+
+auto StringInterner::MemoryUsage() const -> size_t {
+  size_t bytes = strings_.size() * sizeof(std::string);
+  for (const auto& text : strings_) {
+    // Short strings live inside the std::string object
+    if (text.capacity() >= sizeof(std::string)) {
+      bytes += text.capacity() + 1;
+    }
+  }
+  bytes += ids_.size() * (sizeof(std::string_view) + sizeof(Id));
+  return bytes;
+}
+
+}  // namespace slangd::utils
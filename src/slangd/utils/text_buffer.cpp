@@ -0,0 +1,152 @@
+#include "slangd/utils/text_buffer.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace slangd::utils {
+
+TextBuffer::TextBuffer(std::string_view text) {
+  Assign(text);
+}
+
+auto TextBuffer::Assign(std::string_view text) -> void {
+  chunks_.clear();
+  SplitInto(text, chunks_);
+  size_ = text.size();
+}
+
+auto TextBuffer::MakeChunk(std::string_view text) -> Chunk {
+  return Chunk{
+      .text = std::string(text),
+      .newlines = static_cast<size_t>(std::ranges::count(text, '\n'))};
+}
+
+auto TextBuffer::SplitInto(std::string_view text, std::vector<Chunk>& out)
+    -> void {
+  while (!text.empty()) {
+    // Don't leave a tiny tail chunk behind
+    auto take =
+        text.size() < kChunkSize + kMinChunkSize ? text.size() : kChunkSize;
+    out.push_back(MakeChunk(text.substr(0, take)));
+    text.remove_prefix(take);
+  }
+}
+
+auto TextBuffer::ToString() const -> std::string {
+  std::string result;
+  result.reserve(size_);
+  for (const auto& chunk : chunks_) {
+    result += chunk.text;
+  }
+  return result;
+}
+
+auto TextBuffer::OffsetAt(const lsp::Position& position) const -> size_t {
+  if (position.line < 0) {
+    return 0;
+  }
+  auto target_line = static_cast<size_t>(position.line);
+
+  // Find the chunk and position where the target line starts
+  size_t index = 0;
+  size_t chunk_start = 0;
+  size_t pos = 0;
+  if (target_line > 0) {
+    size_t line = 0;
+    for (; index < chunks_.size(); ++index) {
+      const auto& chunk = chunks_[index];
+      if (line + chunk.newlines >= target_line) {
+        break;
+      }
+      line += chunk.newlines;
+      chunk_start += chunk.text.size();
+    }
+    if (index == chunks_.size()) {
+      return size_;
+    }
+
+    const auto& text = chunks_[index].text;
+    for (; pos < text.size(); ++pos) {
+      if (text[pos] == '\n' && ++line == target_line) {
+        ++pos;
+        break;
+      }
+    }
+  }
+
+  // Advance `character` UTF-16 code units, stopping at the end of the line.
+  // Only lead bytes are checked, so a stop never splits a UTF-8 sequence.
+  auto target_units = static_cast<size_t>(std::max(position.character, 0));
+  size_t units = 0;
+  for (; index < chunks_.size(); ++index) {
+    const auto& text = chunks_[index].text;
+    for (; pos < text.size(); ++pos) {
+      auto byte = static_cast<unsigned char>(text[pos]);
+      if ((byte & 0xC0) == 0x80) {
+        continue;
+      }
+      if (units >= target_units || byte == '\n' || byte == '\r') {
+        return chunk_start + pos;
+      }
+      // 4-byte sequences are surrogate pairs (2 code units) in UTF-16
+      units += byte >= 0xF0 ? 2 : 1;
+    }
+    chunk_start += text.size();
+    pos = 0;
+  }
+  return size_;
+}
+
+auto TextBuffer::Replace(const lsp::Range& range, std::string_view text)
+    -> void {
+  auto start = OffsetAt(range.start);
+  auto end = std::max(start, OffsetAt(range.end));
+
+  if (chunks_.empty()) {
+    Assign(text);
+    return;
+  }
+
+  // Chunk containing `offset` and the chunk's start offset (the last chunk
+  // for the end of the document)
+  auto locate = [this](size_t offset) -> std::pair<size_t, size_t> {
+    size_t chunk_start = 0;
+    for (size_t i = 0; i + 1 < chunks_.size(); ++i) {
+      if (offset < chunk_start + chunks_[i].text.size()) {
+        return {i, chunk_start};
+      }
+      chunk_start += chunks_[i].text.size();
+    }
+    return {chunks_.size() - 1, chunk_start};
+  };
+  auto [first, first_start] = locate(start);
+  auto [last, last_start] = locate(end);
+
+  std::string merged;
+  merged.reserve(
+      (start - first_start) + text.size() +
+      (last_start + chunks_[last].text.size() - end));
+  merged.append(chunks_[first].text, 0, start - first_start);
+  merged.append(text);
+  merged.append(chunks_[last].text, end - last_start);
+
+  // Fold small leftovers into the next chunk to avoid fragmentation
+  if (merged.size() < kMinChunkSize && last + 1 < chunks_.size()) {
+    ++last;
+    merged.append(chunks_[last].text);
+  }
+
+  std::vector<Chunk> replacement;
+  SplitInto(merged, replacement);
+
+  auto first_it = chunks_.begin() + static_cast<std::ptrdiff_t>(first);
+  auto last_it = chunks_.begin() + static_cast<std::ptrdiff_t>(last + 1);
+  auto insert_at = chunks_.erase(first_it, last_it);
+  chunks_.insert(
+      insert_at, std::make_move_iterator(replacement.begin()),
+      std::make_move_iterator(replacement.end()));
+
+  size_ = size_ - (end - start) + text.size();
+}
+
+}  // namespace slangd::utils
@@ -0,0 +1,208 @@
+#include "slangd/utils/tracer.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+
+#include <fmt/format.h>
+#include <nlohmann/json.hpp>
+#include <unistd.h>
+
+namespace slangd::utils {
+
+class Tracer::LocalHandle {
+ public:
+  LocalHandle() = default;
+  LocalHandle(const LocalHandle&) = delete;
+  LocalHandle(LocalHandle&&) = delete;
+  auto operator=(const LocalHandle&) -> LocalHandle& = delete;
+  auto operator=(LocalHandle&&) -> LocalHandle& = delete;
+
+  ~LocalHandle() {
+    if (buffer) {
+      std::lock_guard lock(buffer->mutex);
+      buffer->retired = true;
+    }
+  }
+
+  std::shared_ptr<ThreadBuffer> buffer;
+};
+
+auto Tracer::Instance() -> Tracer& {
+  // Never destroyed: threads may still record during static destruction
+  static auto* instance = new Tracer();
+  return *instance;
+}
+
+auto Tracer::NowMicros() -> int64_t {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+auto Tracer::CurrentThreadId() -> uint32_t {
+  static std::atomic<uint32_t> next_id{1};
+  thread_local uint32_t id = next_id.fetch_add(1, std::memory_order_relaxed);
+  return id;
+}
+
+auto Tracer::SetThreadName(std::string name) -> void {
+  auto& buffer = LocalBuffer();
+  std::lock_guard lock(buffer.mutex);
+  buffer.thread_name = std::move(name);
+}
+
+auto Tracer::Record(Span span) -> void {
+  auto& buffer = LocalBuffer();
+  std::lock_guard lock(buffer.mutex);
+  if (buffer.spans.size() < kSpansPerThread) {
+    buffer.spans.push_back(std::move(span));
+    return;
+  }
+  buffer.spans[buffer.next] = std::move(span);
+  buffer.next = (buffer.next + 1) % kSpansPerThread;
+}
+
+auto Tracer::SpanCount() const -> size_t {
+  size_t count = 0;
+  for (const auto& buffer : Snapshot()) {
+    std::lock_guard lock(buffer->mutex);
+    count += buffer->spans.size();
+  }
+  return count;
+}
+
+auto Tracer::ExportChromeTrace() const -> std::string {
+  auto events = nlohmann::json::array();
+  for (const auto& buffer : Snapshot()) {
+    std::lock_guard lock(buffer->mutex);
+    if (!buffer->thread_name.empty() && !buffer->retired) {
+      events.push_back(
+          {{"ph", "M"},
+           {"name", "thread_name"},
+           {"pid", 1},
+           {"tid", buffer->thread_id},
+           {"args", {{"name", buffer->thread_name}}}});
+    }
+
+    for (const auto& span : buffer->spans) {
+      nlohmann::json args = nlohmann::json::object();
+      if (span.request_id != 0) {
+        args["request"] = span.request_id;
+      }
+
+      if (span.request_id == 0 && span.begin_thread == span.end_thread) {
+        events.push_back(
+            {{"ph", "X"},
+             {"name", span.name},
+             {"cat", span.category},
+             {"ts", span.start_us},
+             {"dur", span.end_us - span.start_us},
+             {"pid", 1},
+             {"tid", span.begin_thread},
+             {"args", args}});
+        continue;
+      }
+
+      // Async pair; the ID only has to be unique among overlapping spans
+      auto id = fmt::format(
+          "{}:{}:{}", span.begin_thread, span.start_us, span.request_id);
+      events.push_back(
+          {{"ph", "b"},
+           {"name", span.name},
+           {"cat", span.category},
+           {"id", id},
+           {"ts", span.start_us},
+           {"pid", 1},
+           {"tid", span.begin_thread},
+           {"args", args}});
+      events.push_back(
+          {{"ph", "e"},
+           {"name", span.name},
+           {"cat", span.category},
+           {"id", id},
+           {"ts", span.end_us},
+           {"pid", 1},
+           {"tid", span.end_thread}});
+    }
+  }
+
+  nlohmann::json trace{
+      {"traceEvents", std::move(events)}, {"displayTimeUnit", "ms"}};
+  return trace.dump();
+}
+
+auto Tracer::WriteChromeTrace(const std::filesystem::path& path) const
+    -> std::expected<size_t, std::string> {
+  auto spans = SpanCount();
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  if (!out) {
+    return std::unexpected(
+        fmt::format("Cannot open trace file '{}'", path.string()));
+  }
+  out << ExportChromeTrace();
+  if (!out) {
+    return std::unexpected(
+        fmt::format("Failed to write trace file '{}'", path.string()));
+  }
+  return spans;
+}
+
+auto Tracer::DefaultTracePath() -> std::filesystem::path {
+  std::error_code ec;
+  auto directory = std::filesystem::temp_directory_path(ec);
+  if (ec) {
+    directory = "/tmp";
+  }
+  return directory / fmt::format("slangd-trace-{}.json", getpid());
+}
+
+auto Tracer::LocalBuffer() -> ThreadBuffer& {
+  thread_local LocalHandle handle;
+  if (handle.buffer) {
+    return *handle.buffer;
+  }
+
+  std::lock_guard lock(registry_mutex_);
+  for (const auto& buffer : buffers_) {
+    std::lock_guard buffer_lock(buffer->mutex);
+    if (buffer->retired) {
+      // Keep the spans of the exited thread; they carry their thread IDs
+      buffer->retired = false;
+      buffer->thread_id = CurrentThreadId();
+      buffer->thread_name.clear();
+      handle.buffer = buffer;
+      return *handle.buffer;
+    }
+  }
+  auto buffer = std::make_shared<ThreadBuffer>();
+  buffer->thread_id = CurrentThreadId();
+  buffers_.push_back(buffer);
+  handle.buffer = std::move(buffer);
+  return *handle.buffer;
+}
+
+auto Tracer::Snapshot() const -> std::vector<std::shared_ptr<ThreadBuffer>> {
+  std::lock_guard lock(registry_mutex_);
+  return buffers_;
+}
+
+TraceSpan::TraceSpan(
+    std::string name, std::string_view category, uint64_t request_id)
+    : span_{
+          .name = std::move(name),
+          .category = category,
+          .start_us = Tracer::NowMicros(),
+          .end_us = 0,
+          .begin_thread = Tracer::CurrentThreadId(),
+          .end_thread = 0,
+          .request_id = request_id} {
+}
+
+TraceSpan::~TraceSpan() {
+  span_.end_us = Tracer::NowMicros();
+  span_.end_thread = Tracer::CurrentThreadId();
+  Tracer::Instance().Record(std::move(span_));
+}
+
+}  // namespace slangd::utils
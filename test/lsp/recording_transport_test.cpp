@@ -0,0 +1,51 @@
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "lsp/recording_transport.hpp"
+
+namespace {
+
+auto WriteFile(const std::string& name, const std::string& content)
+    -> std::filesystem::path {
+  auto path = std::filesystem::temp_directory_path() / name;
+  std::ofstream(path) << content;
+  return path;
+}
+
+}  // namespace
+
+TEST_CASE("ReadRecording parses recorded lines", "[lsp]") {
+  auto path = WriteFile(
+      "slangd_recording_test.jsonl",
+      R"({"timeUs":10,"direction":"in","message":"{\"id\":1}"})"
+      "\n"
+      R"({"timeUs":25,"direction":"out","message":"{\"id\":1,\"result\":null}"})"
+      "\n");
+
+  auto recording = lsp::ReadRecording(path);
+  REQUIRE(recording.has_value());
+  REQUIRE(recording->size() == 2);
+  REQUIRE((*recording)[0].time.count() == 10);
+  REQUIRE((*recording)[0].direction == lsp::RecordedMessage::Direction::kIn);
+  REQUIRE((*recording)[0].message == R"({"id":1})");
+  REQUIRE((*recording)[1].direction == lsp::RecordedMessage::Direction::kOut);
+
+  std::filesystem::remove(path);
+}
+
+TEST_CASE("ReadRecording rejects truncated lines", "[lsp]") {
+  auto path = WriteFile(
+      "slangd_recording_truncated_test.jsonl",
+      R"({"timeUs":10,"direction":"in","message":"{\"id\":1}"})"
+      "\n"
+      R"({"timeUs":25,"direc)");
+
+  auto recording = lsp::ReadRecording(path);
+  REQUIRE_FALSE(recording.has_value());
+  REQUIRE(recording.error().find(":2:") != std::string::npos);
+
+  std::filesystem::remove(path);
+}
@@ -64,9 +64,10 @@ class MultiFileSemanticFixture : public SemanticTestFixture,
     const auto& entries = index.GetSemanticEntries();
     return std::ranges::any_of(
         entries,
-        [&current_file_uri](const slangd::semantic::SemanticEntry& entry) {
+        [&](const slangd::semantic::SemanticEntry& entry) {
           // Cross-file if definition URI differs from current file URI
-          return !entry.is_definition && entry.def_loc.uri != current_file_uri;
+          return !entry.is_definition &&
+                 index.GetString(entry.def_uri) != current_file_uri;
         });
   }
 
@@ -315,7 +315,7 @@ class SemanticTestFixture {
     std::vector<std::string> found_symbol_names;
 
     for (const auto& entry : semantic_entries) {
-      found_symbol_names.push_back(entry.name);
+      found_symbol_names.emplace_back(index.GetName(entry));
     }
 
     for (const auto& expected : expected_symbols) {
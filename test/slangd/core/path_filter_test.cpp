@@ -0,0 +1,108 @@
+#include "slangd/core/path_filter.hpp"
+
+#include <cstdlib>
+#include <regex>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+#include <spdlog/spdlog.h>
+
+constexpr auto kLogLevel = spdlog::level::debug;
+
+auto main(int argc, char* argv[]) -> int {
+  spdlog::set_level(kLogLevel);
+  spdlog::set_pattern("[%l] %v");
+
+  // Suppress Bazel test sharding warnings
+  setenv("TEST_SHARD_INDEX", "0", 0);
+  setenv("TEST_TOTAL_SHARDS", "1", 0);
+  setenv("TEST_SHARD_STATUS_FILE", "", 0);
+
+  return Catch::Session().run(argc, argv);
+}
+
+using slangd::PathFilter;
+
+TEST_CASE("PathFilter matches the same paths as std::regex", "[path_filter]") {
+  const std::vector<std::string> patterns = {
+      ".*/generated/.*",
+      "rtl/.*\\.sv$",
+      "^rtl/.*",
+      ".*_tb\\.sv",
+      "rtl/.+/.*\\.sv",
+      "tb/top.sv",
+      ".*/build/.*?",
+      "(rtl|tb)/.*",
+      "rtl/[a-z]+\\.sv",
+      "rtl/\\w+\\.sv",
+      ".*\\.svh?",
+  };
+  const std::vector<std::string> paths = {
+      "rtl/design.sv",
+      "rtl/design.svh",
+      "rtl/subdir/module.sv",
+      "rtl/generated/gen.sv",
+      "tb/generated/wrapper.sv",
+      "tb/top.sv",
+      "tb/topXsv",
+      "tb/top_tb.sv",
+      "rtl/build/output.sv",
+      "common/defines.svh",
+      "rtl/.sv",
+      "rtl/a_b.sv",
+      "",
+  };
+
+  for (const auto& pattern : patterns) {
+    auto filter = PathFilter::Compile({pattern}, {});
+    std::regex reference(pattern);
+    for (const auto& path : paths) {
+      INFO("pattern: " << pattern << ", path: " << path);
+      REQUIRE(filter.ShouldInclude(path) == std::regex_match(path, reference));
+    }
+  }
+}
+
+TEST_CASE(
+    "PathFilter only falls back to std::regex when needed", "[path_filter]") {
+  auto filter = PathFilter::Compile(
+      {"rtl/.*\\.sv$", "(rtl|tb)/.*"}, {".*/generated/.*", "rtl/\\w+\\.sv"});
+  REQUIRE(filter.RegexFallbackCount() == 2);
+}
+
+TEST_CASE("PathFilter combines PathMatch and PathExclude", "[path_filter]") {
+  auto filter =
+      PathFilter::Compile({"rtl/.*", "tb/.*"}, {".*/generated/.*", ".*_tb.sv"});
+
+  REQUIRE(filter.ShouldInclude("rtl/design.sv"));
+  REQUIRE(filter.ShouldInclude("tb/testbench.sv"));
+  REQUIRE_FALSE(filter.ShouldInclude("common/utils.sv"));
+  REQUIRE_FALSE(filter.ShouldInclude("rtl/generated/gen.sv"));
+  REQUIRE_FALSE(filter.ShouldInclude("tb/top_tb.sv"));
+
+  REQUIRE(PathFilter{}.ShouldInclude("anything.sv"));
+}
+
+TEST_CASE("PathFilter includes everything on invalid regex", "[path_filter]") {
+  auto filter = PathFilter::Compile({"rtl/.*"}, {"[invalid"});
+  REQUIRE(filter.ShouldInclude("rtl/design.sv"));
+  REQUIRE(filter.ShouldInclude("tb/testbench.sv"));
+}
+
+TEST_CASE(
+    "PathFilter prunes directories only when all contents are excluded",
+    "[path_filter]") {
+  auto filter = PathFilter::Compile(
+      {}, {".*/generated/.*", "build/.*", ".*_tb\\.sv", "(sim|syn)/.*"});
+
+  REQUIRE(filter.ExcludesDirectory("rtl/generated"));
+  REQUIRE(filter.ExcludesDirectory("rtl/generated/deep"));
+  REQUIRE(filter.ExcludesDirectory("build"));
+  REQUIRE_FALSE(filter.ExcludesDirectory("rtl"));
+  REQUIRE_FALSE(filter.ExcludesDirectory("generated"));
+  REQUIRE_FALSE(filter.ExcludesDirectory("rtl/build"));
+
+  // Regex fallbacks are never used for pruning
+  REQUIRE_FALSE(filter.ExcludesDirectory("sim"));
+}
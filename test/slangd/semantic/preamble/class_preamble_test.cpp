@@ -1,5 +1,8 @@
 #include <cstdlib>
+#include <latch>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include <asio.hpp>
 #include <catch2/catch_all.hpp>
@@ -22,6 +25,7 @@ auto main(int argc, char* argv[]) -> int {
   return Catch::Session().run(argc, argv);
 }
 
+using slangd::services::OverlaySession;
 using slangd::test::MultiFileSemanticFixture;
 using slangd::test::RunAsyncTest;
 using Fixture = MultiFileSemanticFixture;
@@ -277,3 +281,194 @@ TEST_CASE(
     co_return;
   });
 }
+
+TEST_CASE(
+    "Generic classes in preamble packages require serial elaboration",
+    "[class][preamble][specialization][concurrency]") {
+  RunAsyncTest([](asio::any_io_executor executor) -> asio::awaitable<void> {
+    Fixture fixture;
+
+    const std::string generic_pkg = R"(
+      package generic_pkg;
+        class Box#(parameter int WIDTH = 8);
+          logic [WIDTH-1:0] value;
+        endclass
+      endpackage
+    )";
+
+    const std::string plain_pkg = R"(
+      package plain_pkg;
+        parameter DEPTH = 4;
+      endpackage
+    )";
+
+    const std::string generic_user = R"(
+      module generic_user;
+        generic_pkg::Box#(16) box;
+      endmodule
+    )";
+
+    const std::string plain_user = R"(
+      module plain_user;
+        logic [plain_pkg::DEPTH-1:0] data;
+      endmodule
+    )";
+
+    fixture.CreateFile("generic_pkg.sv", generic_pkg);
+    fixture.CreateFile("plain_pkg.sv", plain_pkg);
+    fixture.CreateFile("generic_user.sv", generic_user);
+    fixture.CreateFile("plain_user.sv", plain_user);
+
+    // Specializations are cached on the shared preamble class symbol
+    auto generic_session =
+        co_await fixture.BuildSession("generic_user.sv", executor);
+    REQUIRE(OverlaySession::RequiresSerialElaboration(
+        generic_session->GetCompilation()));
+
+    // Pre-elaborated package: safe to elaborate concurrently
+    auto plain_session =
+        co_await fixture.BuildSession("plain_user.sv", executor);
+    REQUIRE_FALSE(OverlaySession::RequiresSerialElaboration(
+        plain_session->GetCompilation()));
+
+    co_return;
+  });
+}
+
+TEST_CASE(
+    "Overlays binding lazily specialized classes elaborate serially",
+    "[class][preamble][specialization][concurrency]") {
+  RunAsyncTest([](asio::any_io_executor executor) -> asio::awaitable<void> {
+    Fixture fixture;
+    fixture.CreateFile("plain_pkg.sv", "package plain_pkg; int p; endpackage");
+    fixture.CreateFile(
+        "unit_top.sv",
+        "class box #(type T = int); T value; endclass\n"
+        "module unit_top; box #(byte) b = new; endmodule\n");
+    fixture.CreateFile(
+        "nested_pkg.sv",
+        "package nested_pkg;\n"
+        "  class outer; class inner #(int W = 1); endclass endclass\n"
+        "endpackage\n");
+
+    auto preamble = co_await fixture.BuildPreambleManager(executor);
+    auto layout_service = slangd::ProjectLayoutService::Create(
+        executor, fixture.GetTempDir(), spdlog::default_logger());
+    auto requires_serial = [&](std::string content) {
+      auto [source_manager, compilation, buffer] =
+          OverlaySession::BuildCompilation(
+              "file:///overlay.sv", std::move(content), layout_service,
+              preamble);
+      return OverlaySession::RequiresSerialElaboration(*compilation);
+    };
+
+    REQUIRE_FALSE(
+        requires_serial("module user; import plain_pkg::*; endmodule"));
+    // Generic class at compilation-unit scope of a bound definition
+    REQUIRE(requires_serial("module user; unit_top u(); endmodule"));
+    // Generic class nested in a package class
+    REQUIRE(requires_serial("module user; import nested_pkg::*; endmodule"));
+
+    co_return;
+  });
+}
+
+// Run under ThreadSanitizer in CI (--config=tsan): overlays that pass
+// RequiresSerialElaboration() must not race on the shared preamble
+TEST_CASE(
+    "Overlays elaborate concurrently against one preamble",
+    "[class][preamble][concurrency][stress]") {
+  RunAsyncTest([](asio::any_io_executor executor) -> asio::awaitable<void> {
+    Fixture fixture;
+
+    const std::string def = R"(
+      package shared_pkg;
+        parameter DEPTH = 4;
+        typedef logic [DEPTH-1:0] word_t;
+        typedef enum { IDLE, BUSY } state_t;
+
+        class Packet;
+          word_t payload;
+          function automatic word_t checksum();
+            return payload ^ DEPTH;
+          endfunction
+        endclass
+
+        function automatic word_t widen(logic [1:0] value);
+          return word_t'(value);
+        endfunction
+      endpackage
+    )";
+    fixture.CreateFile("shared_pkg.sv", def);
+    fixture.CreateFile(
+        "leaf.sv",
+        "module leaf #(parameter int W = 1) (input logic [W-1:0] d);\n"
+        "endmodule\n");
+
+    auto preamble = co_await fixture.BuildPreambleManager(executor);
+    auto layout_service = slangd::ProjectLayoutService::Create(
+        executor, fixture.GetTempDir(), spdlog::default_logger());
+
+    constexpr size_t kThreads = 8;
+    constexpr size_t kRounds = 4;
+    auto overlay_text = [](size_t id) {
+      return fmt::format(
+          "module user_{0};\n"
+          "  import shared_pkg::*;\n"
+          "  word_t data;\n"
+          "  state_t state;\n"
+          "  Packet packet = new;\n"
+          "  leaf #(.W({1})) u_leaf(.d(data[{1}-1:0]));\n"
+          "  initial data = widen(2'b{2:02b}) + packet.checksum();\n"
+          "endmodule\n",
+          id, (id % 4) + 1, id % 4);
+    };
+
+    struct Result {
+      bool serial = true;
+      bool resolved = false;
+      size_t errors = 0;
+    };
+    std::vector<Result> results(kThreads * kRounds);
+    {
+      // Released together so the elaborations overlap
+      std::latch start(kThreads);
+      std::vector<std::jthread> threads;
+      threads.reserve(kThreads);
+      for (size_t t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&, t]() {
+          start.arrive_and_wait();
+          for (size_t round = 0; round < kRounds; ++round) {
+            auto id = (round * kThreads) + t;
+            auto text = overlay_text(id);
+            auto uri = fmt::format("file:///user_{}.sv", id);
+            auto& result = results[id];
+
+            auto [source_manager, compilation, buffer] =
+                OverlaySession::BuildCompilation(
+                    uri, text, layout_service, preamble);
+            result.serial =
+                OverlaySession::RequiresSerialElaboration(*compilation);
+
+            auto session =
+                OverlaySession::Create(uri, text, layout_service, preamble);
+            for (const auto& diag : Fixture::GetDiagnostics(*session)) {
+              result.errors +=
+                  diag.severity == lsp::DiagnosticSeverity::kError ? 1 : 0;
+            }
+            result.resolved = Fixture::VerifySymbolReference(
+                session->GetSemanticIndex(), uri, text, "word_t");
+          }
+        });
+      }
+    }
+
+    for (const auto& result : results) {
+      REQUIRE_FALSE(result.serial);
+      REQUIRE(result.errors == 0);
+      REQUIRE(result.resolved);
+    }
+
+    co_return;
+  });
+}
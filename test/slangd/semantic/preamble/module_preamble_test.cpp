@@ -396,3 +396,43 @@ TEST_CASE(
     co_return;
   });
 }
+
+TEST_CASE(
+    "Preamble symbols used only by a cross-file module are bound",
+    "[module][preamble][transitive]") {
+  RunAsyncTest([](asio::any_io_executor executor) -> asio::awaitable<void> {
+    Fixture fixture;
+
+    const std::string pkg = R"(
+      package width_pkg;
+        typedef logic [15:0] word_t;
+      endpackage
+    )";
+
+    const std::string def = R"(
+      module wrapper import width_pkg::*; #(parameter word_t INIT = 0) (
+        output word_t value
+      );
+        assign value = INIT;
+      endmodule
+    )";
+
+    // width_pkg is never named here; it must be bound through wrapper
+    const std::string ref = R"(
+      module top;
+        logic [15:0] result;
+        wrapper #(.INIT(16'h1234)) inst (.value(result));
+      endmodule
+    )";
+
+    fixture.CreateFile("width_pkg.sv", pkg);
+    fixture.CreateFile("wrapper.sv", def);
+    fixture.CreateFile("top.sv", ref);
+
+    auto session = co_await fixture.BuildSession("top.sv", executor);
+    Fixture::AssertNoErrors(*session);
+    Fixture::AssertCrossFileDef(*session, ref, def, "wrapper", 0, 0);
+
+    co_return;
+  });
+}
@@ -0,0 +1,66 @@
+#include "slangd/semantic/semantic_index.hpp"
+
+#include <cstdlib>
+#include <memory>
+#include <stop_token>
+#include <string>
+
+#include <catch2/catch_all.hpp>
+#include <slang/ast/Compilation.h>
+#include <slang/syntax/SyntaxTree.h>
+#include <slang/text/SourceManager.h>
+#include <spdlog/spdlog.h>
+
+#include "slangd/utils/compilation_options.hpp"
+
+constexpr auto kLogLevel = spdlog::level::debug;
+
+auto main(int argc, char* argv[]) -> int {
+  spdlog::set_level(kLogLevel);
+  spdlog::set_pattern("[%l] %v");
+
+  // Suppress Bazel test sharding warnings
+  setenv("TEST_SHARD_INDEX", "0", 0);
+  setenv("TEST_TOTAL_SHARDS", "1", 0);
+  setenv("TEST_SHARD_STATUS_FILE", "", 0);
+
+  return Catch::Session().run(argc, argv);
+}
+
+using slangd::semantic::SemanticIndex;
+
+TEST_CASE(
+    "SemanticIndex::FromCompilation stops once stop is requested",
+    "[semantic_index]") {
+  const std::string source = R"(
+    package cancel_pkg;
+      typedef logic [7:0] byte_t;
+    endpackage
+
+    module cancel_top;
+      cancel_pkg::byte_t data;
+    endmodule
+  )";
+
+  auto options = slangd::utils::CreateLspCompilationOptions();
+  slang::SourceManager source_manager;
+  auto buffer = source_manager.assignText("/cancel.sv", source);
+  auto compilation = std::make_unique<slang::ast::Compilation>(options);
+  compilation->addSyntaxTree(
+      slang::syntax::SyntaxTree::fromBuffer(buffer, source_manager, options));
+
+  std::stop_source stop;
+  stop.request_stop();
+  auto result = SemanticIndex::FromCompilation(
+      *compilation, source_manager, "file:///cancel.sv", buffer.id, nullptr,
+      spdlog::default_logger(), stop.get_token());
+
+  REQUIRE_FALSE(result.has_value());
+  REQUIRE(result.error().starts_with("Indexing cancelled"));
+
+  // The same compilation still indexes without a stop request
+  auto rebuilt = SemanticIndex::FromCompilation(
+      *compilation, source_manager, "file:///cancel.sv", buffer.id);
+  REQUIRE(rebuilt.has_value());
+  REQUIRE_FALSE((*rebuilt)->GetSemanticEntries().empty());
+}
@@ -0,0 +1,90 @@
+#include "slangd/services/batch_checker.hpp"
+
+#include <cstdlib>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <asio.hpp>
+#include <catch2/catch_all.hpp>
+#include <spdlog/spdlog.h>
+
+#include "test/slangd/common/async_fixture.hpp"
+#include "test/slangd/common/file_fixture.hpp"
+
+constexpr auto kLogLevel = spdlog::level::debug;
+
+auto main(int argc, char* argv[]) -> int {
+  spdlog::set_level(kLogLevel);
+  spdlog::set_pattern("[%l] %v");
+
+  setenv("TEST_SHARD_INDEX", "0", 0);
+  setenv("TEST_TOTAL_SHARDS", "1", 0);
+  setenv("TEST_SHARD_STATUS_FILE", "", 0);
+
+  return Catch::Session().run(argc, argv);
+}
+
+using slangd::services::BatchChecker;
+using slangd::services::BatchCheckSummary;
+using slangd::services::FileCheckResult;
+using slangd::test::RunAsyncTest;
+
+TEST_CASE(
+    "BatchChecker reports diagnostics of every project file",
+    "[batch_checker]") {
+  slangd::test::FileTestFixture fixture("slangd_batch_checker_test");
+  fixture.CreateFile(
+      "pkg.sv", "package pkg; typedef logic [7:0] byte_t; endpackage");
+  fixture.CreateFile(
+      "good.sv", "module good; import pkg::*; byte_t value; endmodule");
+  fixture.CreateFile(
+      "bad.sv",
+      "module bad; initial begin undefined_variable = 1; end endmodule");
+
+  RunAsyncTest([&](asio::any_io_executor executor) -> asio::awaitable<void> {
+    BatchChecker checker(executor, fixture.GetTempDir(), 2);
+    std::map<std::string, FileCheckResult> results;
+    auto summary = co_await checker.Run([&](const FileCheckResult& result) {
+      results[result.path.Path().filename().string()] = result;
+    });
+
+    REQUIRE(summary.files == 3);
+    REQUIRE(summary.unchecked == 0);
+    REQUIRE(summary.errors >= 1);
+    REQUIRE(results.size() == 3);
+    REQUIRE(results["pkg.sv"].checked);
+    REQUIRE(results["pkg.sv"].diagnostics.empty());
+    REQUIRE(results["good.sv"].diagnostics.empty());
+
+    const auto& bad = results["bad.sv"].diagnostics;
+    REQUIRE_FALSE(bad.empty());
+    REQUIRE(bad[0].message.find("undefined_variable") != std::string::npos);
+  });
+}
+
+TEST_CASE("ToSarif converts diagnostics to SARIF results", "[batch_checker]") {
+  FileCheckResult result{
+      .path = slangd::CanonicalPath::FromNormalized("/work/bad.sv"),
+      .checked = true};
+  result.diagnostics.push_back(
+      lsp::Diagnostic{
+          .range = {.start = {.line = 2, .character = 4},
+                    .end = {.line = 2, .character = 9}},
+          .severity = lsp::DiagnosticSeverity::kWarning,
+          .code = "UnusedDefinition",
+          .message = "unused"});
+
+  auto sarif = slangd::services::ToSarif({result});
+  REQUIRE(sarif["version"] == "2.1.0");
+  const auto& results = sarif["runs"][0]["results"];
+  REQUIRE(results.size() == 1);
+  REQUIRE(results[0]["level"] == "warning");
+  REQUIRE(results[0]["ruleId"] == "UnusedDefinition");
+
+  const auto& location = results[0]["locations"][0]["physicalLocation"];
+  REQUIRE(location["artifactLocation"]["uri"] == "file:///work/bad.sv");
+  REQUIRE(location["region"]["startLine"] == 3);
+  REQUIRE(location["region"]["startColumn"] == 5);
+  REQUIRE(location["region"]["endColumn"] == 10);
+}
@@ -0,0 +1,147 @@
+#include "slangd/services/include_cache.hpp"
+
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+
+#include <catch2/catch_all.hpp>
+#include <slang/text/SourceManager.h>
+#include <spdlog/spdlog.h>
+
+#include "slangd/services/overlay_session.hpp"
+#include "test/slangd/common/file_fixture.hpp"
+
+constexpr auto kLogLevel = spdlog::level::debug;
+
+auto main(int argc, char* argv[]) -> int {
+  spdlog::set_level(kLogLevel);
+  spdlog::set_pattern("[%l] %v");
+
+  setenv("TEST_SHARD_INDEX", "0", 0);
+  setenv("TEST_TOTAL_SHARDS", "1", 0);
+  setenv("TEST_SHARD_STATUS_FILE", "", 0);
+
+  return Catch::Session().run(argc, argv);
+}
+
+using slangd::services::IncludeCache;
+using slangd::services::OverlaySession;
+
+namespace {
+
+constexpr std::string_view kTopContent = R"(
+`include "regs.svh"
+module top;
+  logic [`REG_WIDTH-1:0] r;
+endmodule
+)";
+
+class IncludeCacheFixture : public slangd::test::FileTestFixture {
+ public:
+  IncludeCacheFixture() : FileTestFixture("slangd_include_cache_test") {
+  }
+
+  [[nodiscard]] auto TopUri() const -> std::string {
+    return slangd::CanonicalPath(GetTempDir().Path() / "top.sv").ToUri();
+  }
+
+  // Text of the include buffer the build of top.sv used
+  auto BuildAndGetIncludeText(const std::shared_ptr<IncludeCache>& cache)
+      -> std::string {
+    auto [source_manager, compilation, main_buffer_id] =
+        OverlaySession::BuildCompilation(
+            TopUri(), std::string(kTopContent), nullptr, nullptr,
+            spdlog::default_logger(), cache);
+    for (auto buffer : source_manager->getAllBuffers()) {
+      if (source_manager->getIncludedFrom(buffer).valid()) {
+        return std::string(source_manager->getSourceText(buffer));
+      }
+    }
+    return {};
+  }
+};
+
+}  // namespace
+
+TEST_CASE(
+    "IncludeCache serves includes of the previous build", "[include_cache]") {
+  IncludeCacheFixture fixture;
+  auto header = fixture.CreateFile("regs.svh", "`define REG_WIDTH 32\n");
+  auto cache = std::make_shared<IncludeCache>();
+
+  REQUIRE(fixture.BuildAndGetIncludeText(cache).contains("32"));
+  REQUIRE(cache->GetStats().entries == 1);
+  REQUIRE(cache->GetStats().hits == 0);
+
+  // Same size and mtime: only a build served from the cache still sees 32
+  auto mtime = std::filesystem::last_write_time(header.Path());
+  fixture.CreateFile("regs.svh", "`define REG_WIDTH 64\n");
+  std::filesystem::last_write_time(header.Path(), mtime);
+
+  REQUIRE(fixture.BuildAndGetIncludeText(cache).contains("32"));
+  REQUIRE(cache->GetStats().hits == 1);
+  REQUIRE(cache->GetStats().entries == 1);
+}
+
+TEST_CASE(
+    "IncludeCache rereads includes changed without an event",
+    "[include_cache]") {
+  IncludeCacheFixture fixture;
+  fixture.CreateFile("regs.svh", "`define REG_WIDTH 32\n");
+  auto cache = std::make_shared<IncludeCache>();
+
+  REQUIRE(fixture.BuildAndGetIncludeText(cache).contains("32"));
+
+  // e.g. a header outside the workspace: the file's size and mtime differ
+  // from the cached entry's
+  fixture.CreateFile("regs.svh", "`define REG_WIDTH 8\n");
+  REQUIRE(fixture.BuildAndGetIncludeText(cache).contains("8"));
+  REQUIRE(cache->GetStats().hits == 0);
+  REQUIRE(cache->GetStats().misses == 1);
+  REQUIRE(cache->GetStats().entries == 1);
+}
+
+TEST_CASE("IncludeCache rereads invalidated includes", "[include_cache]") {
+  IncludeCacheFixture fixture;
+  auto header = fixture.CreateFile("regs.svh", "`define REG_WIDTH 32\n");
+  auto cache = std::make_shared<IncludeCache>();
+
+  REQUIRE(fixture.BuildAndGetIncludeText(cache).contains("32"));
+
+  fixture.CreateFile("regs.svh", "`define REG_WIDTH 8\n");
+  cache->Invalidate(header);
+  REQUIRE(cache->GetStats().entries == 0);
+
+  REQUIRE(fixture.BuildAndGetIncludeText(cache).contains("8"));
+  REQUIRE(cache->GetStats().entries == 1);
+}
+
+TEST_CASE("IncludeCache forgets includes of closed files", "[include_cache]") {
+  IncludeCacheFixture fixture;
+  fixture.CreateFile("regs.svh", "`define REG_WIDTH 32\n");
+  auto cache = std::make_shared<IncludeCache>();
+
+  fixture.BuildAndGetIncludeText(cache);
+  REQUIRE(cache->GetStats().entries == 1);
+
+  cache->Forget(fixture.TopUri());
+  REQUIRE(cache->GetStats().entries == 0);
+  REQUIRE(cache->GetStats().bytes == 0);
+
+  // Nothing to seed: the next build reads from disk
+  REQUIRE(fixture.BuildAndGetIncludeText(cache).contains("32"));
+  REQUIRE(cache->GetStats().hits == 0);
+}
+
+TEST_CASE("IncludeCache Clear drops all contents", "[include_cache]") {
+  IncludeCacheFixture fixture;
+  fixture.CreateFile("regs.svh", "`define REG_WIDTH 32\n");
+  auto cache = std::make_shared<IncludeCache>();
+
+  fixture.BuildAndGetIncludeText(cache);
+  REQUIRE(cache->GetStats().bytes > 0);
+
+  cache->Clear();
+  REQUIRE(cache->GetStats().entries == 0);
+  REQUIRE(cache->GetStats().bytes == 0);
+}
@@ -0,0 +1,64 @@
+#include "slangd/services/index_builder.hpp"
+
+#include <cstdlib>
+#include <filesystem>
+#include <set>
+#include <string>
+#include <string_view>
+
+#include <asio.hpp>
+#include <catch2/catch_all.hpp>
+#include <spdlog/spdlog.h>
+
+#include "slangd/services/index_artifact.hpp"
+#include "test/slangd/common/async_fixture.hpp"
+#include "test/slangd/common/file_fixture.hpp"
+
+constexpr auto kLogLevel = spdlog::level::debug;
+
+auto main(int argc, char* argv[]) -> int {
+  spdlog::set_level(kLogLevel);
+  spdlog::set_pattern("[%l] %v");
+
+  setenv("TEST_SHARD_INDEX", "0", 0);
+  setenv("TEST_TOTAL_SHARDS", "1", 0);
+  setenv("TEST_SHARD_STATUS_FILE", "", 0);
+
+  return Catch::Session().run(argc, argv);
+}
+
+using slangd::services::IndexArtifact;
+using slangd::services::IndexBuilder;
+using slangd::test::RunAsyncTest;
+
+TEST_CASE(
+    "IndexBuilder writes shards and swept references of every file",
+    "[index_builder]") {
+  slangd::test::FileTestFixture fixture("slangd_index_builder_test");
+  fixture.CreateFile(
+      "pkg.sv", "package pkg; typedef logic [7:0] byte_t; endpackage");
+  fixture.CreateFile(
+      "top.sv", "module top; import pkg::*; byte_t value; endmodule");
+  auto artifact_path = fixture.GetTempDir().Path() / "out" / "index.slia";
+
+  RunAsyncTest([&](asio::any_io_executor executor) -> asio::awaitable<void> {
+    IndexBuilder builder(executor, fixture.GetTempDir(), 2);
+    auto summary = co_await builder.Run(artifact_path);
+
+    REQUIRE(summary.has_value());
+    REQUIRE(summary->files == 2);
+    REQUIRE(summary->swept == 2);
+    REQUIRE(summary->bytes > 0);
+  });
+
+  auto artifact = IndexArtifact::Open(artifact_path, fixture.GetTempDir());
+  REQUIRE(artifact.has_value());
+  REQUIRE((*artifact)->FileCount() == 2);
+
+  std::set<std::string> swept;
+  (*artifact)->ForEachSweptShard(
+      [&](std::string_view path, const auto& /*shard*/) {
+        swept.insert(std::filesystem::path(path).filename().string());
+      });
+  REQUIRE(swept == std::set<std::string>{"pkg.sv", "top.sv"});
+}
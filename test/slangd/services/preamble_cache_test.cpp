@@ -0,0 +1,194 @@
+#include "slangd/services/preamble_cache.hpp"
+
+#include <cstdlib>
+#include <string>
+
+#include <asio.hpp>
+#include <catch2/catch_all.hpp>
+#include <spdlog/spdlog.h>
+
+#include "slangd/core/project_layout_service.hpp"
+#include "slangd/services/preamble_manager.hpp"
+#include "test/slangd/common/async_fixture.hpp"
+#include "test/slangd/common/file_fixture.hpp"
+
+constexpr auto kLogLevel = spdlog::level::debug;
+
+auto main(int argc, char* argv[]) -> int {
+  spdlog::set_level(kLogLevel);
+  spdlog::set_pattern("[%l] %v");
+
+  setenv("TEST_SHARD_INDEX", "0", 0);
+  setenv("TEST_TOTAL_SHARDS", "1", 0);
+  setenv("TEST_SHARD_STATUS_FILE", "", 0);
+
+  return Catch::Session().run(argc, argv);
+}
+
+using slangd::services::PreambleCache;
+using slangd::services::PreambleManager;
+using slangd::test::RunAsyncTest;
+
+namespace {
+
+class PreambleCacheFixture : public slangd::test::FileTestFixture {
+ public:
+  PreambleCacheFixture() : FileTestFixture("slangd_preamble_cache_test") {
+  }
+
+  auto Build(
+      asio::any_io_executor executor, std::shared_ptr<PreambleCache> cache)
+      -> asio::awaitable<std::shared_ptr<PreambleManager>> {
+    auto layout_service = slangd::ProjectLayoutService::Create(
+        executor, GetTempDir(), spdlog::default_logger());
+    auto result = co_await PreambleManager::CreateFromProjectLayout(
+        layout_service, executor, spdlog::default_logger(), cache);
+    REQUIRE(result.has_value());
+    co_return *result;
+  }
+};
+
+}  // namespace
+
+TEST_CASE(
+    "PreambleCache reuses syntax trees for unchanged files",
+    "[preamble_cache]") {
+  PreambleCacheFixture fixture;
+  fixture.CreateFile("pkg_a.sv", "package pkg_a; parameter A = 1; endpackage");
+  fixture.CreateFile("pkg_b.sv", "package pkg_b; parameter B = 2; endpackage");
+
+  RunAsyncTest([&](asio::any_io_executor executor) -> asio::awaitable<void> {
+    auto cache = std::make_shared<PreambleCache>();
+
+    auto first = co_await fixture.Build(executor, cache);
+    REQUIRE(first->GetPackageMap().contains("pkg_a"));
+    REQUIRE(cache->GetStats().hits == 0);
+
+    auto second = co_await fixture.Build(executor, cache);
+    REQUIRE(second->GetPackageMap().contains("pkg_b"));
+
+    auto stats = cache->GetStats();
+    REQUIRE(stats.hits == 2);
+    REQUIRE(stats.generations == 1);
+    REQUIRE(stats.entries == 2);
+    REQUIRE(&first->GetSourceManager() == &second->GetSourceManager());
+  });
+}
+
+TEST_CASE(
+    "PreambleCache starts a new generation when a file changes",
+    "[preamble_cache]") {
+  PreambleCacheFixture fixture;
+  fixture.CreateFile("pkg_a.sv", "package pkg_a; parameter A = 1; endpackage");
+
+  RunAsyncTest([&](asio::any_io_executor executor) -> asio::awaitable<void> {
+    auto cache = std::make_shared<PreambleCache>();
+    co_await fixture.Build(executor, cache);
+
+    fixture.CreateFile(
+        "pkg_a.sv", "package pkg_a_renamed; parameter A = 1; endpackage");
+    auto rebuilt = co_await fixture.Build(executor, cache);
+
+    REQUIRE(rebuilt->GetPackageMap().contains("pkg_a_renamed"));
+    REQUIRE_FALSE(rebuilt->GetPackageMap().contains("pkg_a"));
+    REQUIRE(cache->GetStats().generations == 2);
+  });
+}
+
+TEST_CASE("PreambleCache evicts trees for removed files", "[preamble_cache]") {
+  PreambleCacheFixture fixture;
+  fixture.CreateFile("pkg_a.sv", "package pkg_a; parameter A = 1; endpackage");
+  fixture.CreateFile("pkg_b.sv", "package pkg_b; parameter B = 2; endpackage");
+
+  RunAsyncTest([&](asio::any_io_executor executor) -> asio::awaitable<void> {
+    auto cache = std::make_shared<PreambleCache>();
+    co_await fixture.Build(executor, cache);
+
+    std::filesystem::remove(fixture.GetTempDir().Path() / "pkg_b.sv");
+    auto rebuilt = co_await fixture.Build(executor, cache);
+
+    REQUIRE_FALSE(rebuilt->GetPackageMap().contains("pkg_b"));
+    auto stats = cache->GetStats();
+    REQUIRE(stats.entries == 1);
+    REQUIRE(stats.evictions == 1);
+    REQUIRE(stats.generations == 1);
+  });
+}
+
+TEST_CASE(
+    "PreambleCache invalidates the generation for untracked files",
+    "[preamble_cache]") {
+  PreambleCacheFixture fixture;
+  fixture.CreateFile("pkg_a.sv", "package pkg_a; parameter A = 1; endpackage");
+
+  RunAsyncTest([&](asio::any_io_executor executor) -> asio::awaitable<void> {
+    auto cache = std::make_shared<PreambleCache>();
+    co_await fixture.Build(executor, cache);
+
+    // Tracked file: re-validated by hash, generation kept
+    cache->Invalidate(fixture.GetTempDir() / "pkg_a.sv");
+    co_await fixture.Build(executor, cache);
+    REQUIRE(cache->GetStats().generations == 1);
+
+    // Untracked file (e.g. an include header): generation dropped
+    cache->Invalidate(fixture.GetTempDir() / "defs.svh");
+    co_await fixture.Build(executor, cache);
+    REQUIRE(cache->GetStats().generations == 2);
+  });
+}
+
+TEST_CASE(
+    "PreambleManager fingerprint tracks preamble inputs", "[preamble_cache]") {
+  PreambleCacheFixture fixture;
+  fixture.CreateFile("pkg_a.sv", "package pkg_a; parameter A = 1; endpackage");
+
+  RunAsyncTest([&](asio::any_io_executor executor) -> asio::awaitable<void> {
+    auto cache = std::make_shared<PreambleCache>();
+    auto first = co_await fixture.Build(executor, cache);
+
+    // Rewrite with identical content (e.g. save without edits)
+    fixture.CreateFile(
+        "pkg_a.sv", "package pkg_a; parameter A = 1; endpackage");
+    cache->Invalidate(fixture.GetTempDir() / "pkg_a.sv");
+    auto touched = co_await fixture.Build(executor, cache);
+    REQUIRE(
+        touched->GetContentFingerprint() == first->GetContentFingerprint());
+    REQUIRE(cache->GetStats().generations == 1);
+
+    fixture.CreateFile(
+        "pkg_a.sv", "package pkg_a; parameter A = 2; endpackage");
+    auto edited = co_await fixture.Build(executor, cache);
+    REQUIRE(edited->GetContentFingerprint() != first->GetContentFingerprint());
+  });
+}
+
+TEST_CASE(
+    "PreambleManager fingerprint tracks included headers",
+    "[preamble_cache]") {
+  PreambleCacheFixture fixture;
+  // Not a layout source file (unlike .svh), so only reached as an include
+  auto header = fixture.CreateFile("names.inc", "`define PKG_NAME pkg_old\n");
+  fixture.CreateFile(
+      "pkg.sv", "`include \"names.inc\"\npackage `PKG_NAME; endpackage\n");
+
+  RunAsyncTest([&](asio::any_io_executor executor) -> asio::awaitable<void> {
+    auto cache = std::make_shared<PreambleCache>();
+    auto first = co_await fixture.Build(executor, cache);
+    REQUIRE(first->GetPackageMap().contains("pkg_old"));
+
+    // Header edit: no source file changed, the watcher event alone
+    // invalidates the generation
+    fixture.CreateFile("names.inc", "`define PKG_NAME pkg_new\n");
+    cache->Invalidate(header);
+    auto rebuilt = co_await fixture.Build(executor, cache);
+    REQUIRE(rebuilt->GetPackageMap().contains("pkg_new"));
+    REQUIRE(
+        rebuilt->GetContentFingerprint() != first->GetContentFingerprint());
+
+    // Same header content again: equivalent preamble
+    cache->Invalidate(header);
+    auto touched = co_await fixture.Build(executor, cache);
+    REQUIRE(
+        touched->GetContentFingerprint() == rebuilt->GetContentFingerprint());
+  });
+}
@@ -0,0 +1,162 @@
+#include "slangd/services/reference_index.hpp"
+
+#include <string>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+#include <spdlog/spdlog.h>
+
+constexpr auto kLogLevel = spdlog::level::debug;
+
+auto main(int argc, char* argv[]) -> int {
+  spdlog::set_level(kLogLevel);
+  spdlog::set_pattern("[%l] %v");
+  return Catch::Session().run(argc, argv);
+}
+
+using slangd::services::ReferenceIndex;
+
+namespace {
+
+constexpr auto kPkgUri = "file:///rtl/pkg.sv";
+constexpr auto kTopUri = "file:///rtl/top.sv";
+
+auto MakeRange(int line, int start, int end) -> lsp::Range {
+  return lsp::Range{
+      .start = lsp::Position{.line = line, .character = start},
+      .end = lsp::Position{.line = line, .character = end}};
+}
+
+// WIDTH declared in pkg.sv line 1
+const auto kWidthDef = MakeRange(1, 12, 17);
+// DEPTH declared in pkg.sv line 2
+const auto kDepthDef = MakeRange(2, 12, 17);
+
+// pkg.sv: both declarations (self references)
+auto PkgReferences() -> ReferenceIndex::FileReferences {
+  return ReferenceIndex::FileReferences{
+      .def_uris = {kPkgUri},
+      .references = {
+          {.def_uri = 0,
+           .def_range = kWidthDef,
+           .range = kWidthDef,
+           .is_declaration = true},
+          {.def_uri = 0,
+           .def_range = kDepthDef,
+           .range = kDepthDef,
+           .is_declaration = true}}};
+}
+
+// top.sv: uses of WIDTH on the given lines
+auto TopReferences(const std::vector<int>& lines)
+    -> ReferenceIndex::FileReferences {
+  ReferenceIndex::FileReferences refs{.def_uris = {kPkgUri}, .references = {}};
+  for (auto line : lines) {
+    refs.references.push_back(
+        {.def_uri = 0,
+         .def_range = kWidthDef,
+         .range = MakeRange(line, 4, 9),
+         .is_declaration = false});
+  }
+  return refs;
+}
+
+auto Lines(const std::vector<lsp::Location>& locations, const char* uri)
+    -> std::vector<int> {
+  std::vector<int> lines;
+  for (const auto& location : locations) {
+    if (location.uri == uri) {
+      lines.push_back(location.range.start.line);
+    }
+  }
+  std::ranges::sort(lines);
+  return lines;
+}
+
+}  // namespace
+
+TEST_CASE("ReferenceIndex finds references across files", "[reference_index]") {
+  ReferenceIndex index;
+  index.Update(kPkgUri, ReferenceIndex::Layer::kBackground, PkgReferences());
+  index.Update(
+      kTopUri, ReferenceIndex::Layer::kBackground, TopReferences({5, 3}));
+
+  auto with_decl = index.FindReferences(kPkgUri, kWidthDef, true);
+  REQUIRE(with_decl.size() == 3);
+  REQUIRE(Lines(with_decl, kPkgUri) == std::vector<int>{1});
+  REQUIRE(Lines(with_decl, kTopUri) == std::vector<int>{3, 5});
+
+  auto without_decl = index.FindReferences(kPkgUri, kWidthDef, false);
+  REQUIRE(without_decl.size() == 2);
+  REQUIRE(Lines(without_decl, kPkgUri).empty());
+
+  // DEPTH is only declared
+  REQUIRE(index.FindReferences(kPkgUri, kDepthDef, true).size() == 1);
+  REQUIRE(index.FindReferences(kPkgUri, kDepthDef, false).empty());
+}
+
+TEST_CASE("ReferenceIndex misses unknown symbols", "[reference_index]") {
+  ReferenceIndex index;
+  REQUIRE(index.FindReferences(kPkgUri, kWidthDef, true).empty());
+
+  index.Update(kPkgUri, ReferenceIndex::Layer::kBackground, PkgReferences());
+  REQUIRE(index.FindReferences(kTopUri, kWidthDef, true).empty());
+  REQUIRE(index.FindReferences(kPkgUri, MakeRange(9, 0, 1), true).empty());
+}
+
+TEST_CASE("ReferenceIndex overlay hides background", "[reference_index]") {
+  ReferenceIndex index;
+  index.Update(kPkgUri, ReferenceIndex::Layer::kBackground, PkgReferences());
+  index.Update(
+      kTopUri, ReferenceIndex::Layer::kBackground, TopReferences({3, 5}));
+
+  // Unsaved edit moved the uses
+  index.Update(kTopUri, ReferenceIndex::Layer::kOverlay, TopReferences({7}));
+  REQUIRE(
+      Lines(index.FindReferences(kPkgUri, kWidthDef, false), kTopUri) ==
+      std::vector<int>{7});
+
+  // Closing the document falls back to the saved content
+  index.Remove(kTopUri, ReferenceIndex::Layer::kOverlay);
+  REQUIRE(
+      Lines(index.FindReferences(kPkgUri, kWidthDef, false), kTopUri) ==
+      std::vector<int>{3, 5});
+}
+
+TEST_CASE("ReferenceIndex overlay can drop all uses", "[reference_index]") {
+  ReferenceIndex index;
+  index.Update(kPkgUri, ReferenceIndex::Layer::kBackground, PkgReferences());
+  index.Update(
+      kTopUri, ReferenceIndex::Layer::kBackground, TopReferences({3}));
+  index.Update(kTopUri, ReferenceIndex::Layer::kOverlay, TopReferences({}));
+
+  REQUIRE(index.FindReferences(kPkgUri, kWidthDef, false).empty());
+  REQUIRE(index.ReferenceCount() == 2);
+}
+
+TEST_CASE("ReferenceIndex update replaces a layer", "[reference_index]") {
+  ReferenceIndex index;
+  index.Update(
+      kTopUri, ReferenceIndex::Layer::kBackground, TopReferences({1, 2}));
+  index.Update(kTopUri, ReferenceIndex::Layer::kBackground, TopReferences({4}));
+
+  REQUIRE(
+      Lines(index.FindReferences(kPkgUri, kWidthDef, false), kTopUri) ==
+      std::vector<int>{4});
+  REQUIRE(index.ReferenceCount() == 1);
+}
+
+TEST_CASE(
+    "ReferenceIndex retains only listed background files",
+    "[reference_index]") {
+  ReferenceIndex index;
+  index.Update(kPkgUri, ReferenceIndex::Layer::kBackground, PkgReferences());
+  index.Update(
+      kTopUri, ReferenceIndex::Layer::kBackground, TopReferences({3}));
+
+  index.RetainBackground({kPkgUri});
+
+  auto locations = index.FindReferences(kPkgUri, kWidthDef, true);
+  REQUIRE(locations.size() == 1);
+  REQUIRE(locations[0].uri == kPkgUri);
+}
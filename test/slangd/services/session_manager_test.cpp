@@ -0,0 +1,264 @@
+#include "slangd/services/session_manager.hpp"
+
+#include <cstdlib>
+#include <future>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include <asio.hpp>
+#include <catch2/catch_all.hpp>
+#include <spdlog/spdlog.h>
+
+#include "slangd/core/project_layout_service.hpp"
+#include "slangd/services/include_cache.hpp"
+#include "slangd/services/open_document_tracker.hpp"
+#include "slangd/services/overlay_session.hpp"
+#include "slangd/utils/canonical_path.hpp"
+#include "slangd/utils/position_mapper.hpp"
+#include "slangd/utils/priority_scheduler.hpp"
+#include "test/slangd/common/async_fixture.hpp"
+
+constexpr auto kLogLevel = spdlog::level::debug;
+
+auto main(int argc, char* argv[]) -> int {
+  spdlog::set_level(kLogLevel);
+  spdlog::set_pattern("[%l] %v");
+
+  setenv("TEST_SHARD_INDEX", "0", 0);
+  setenv("TEST_TOTAL_SHARDS", "1", 0);
+  setenv("TEST_SHARD_STATUS_FILE", "", 0);
+
+  return Catch::Session().run(argc, argv);
+}
+
+using slangd::services::OverlaySession;
+using slangd::services::SessionManager;
+using slangd::test::RunAsyncTest;
+using slangd::utils::PositionMapper;
+using slangd::utils::PriorityScheduler;
+using slangd::utils::TaskPriority;
+
+namespace {
+
+constexpr std::string_view kUri = "file:///stale_top.sv";
+
+const std::string kFirstVersion =
+    "module stale_top;\n"
+    "  logic first;\n"
+    "endmodule\n";
+
+// One line inserted above everything else
+const std::string kSecondVersion = "// edited\n" + kFirstVersion;
+
+struct Harness {
+  std::shared_ptr<PriorityScheduler> scheduler;
+  std::unique_ptr<SessionManager> manager;
+};
+
+// One scheduler thread, so a blocking task holds back every session build
+auto MakeHarness(asio::any_io_executor executor) -> Harness {
+  auto layout_service = slangd::ProjectLayoutService::Create(
+      executor, slangd::CanonicalPath::CurrentPath(),
+      spdlog::default_logger());
+  auto scheduler = std::make_shared<PriorityScheduler>(1);
+  auto manager = std::make_unique<SessionManager>(
+      executor, layout_service, nullptr,
+      std::make_shared<slangd::services::OpenDocumentTracker>(), scheduler,
+      std::make_shared<slangd::services::IncludeCache>(),
+      spdlog::default_logger());
+  return {.scheduler = scheduler, .manager = std::move(manager)};
+}
+
+// Occupies the scheduler's thread until Open() or destruction (so a failed
+// REQUIRE does not leave the scheduler's destructor joining forever)
+class SchedulerBlock {
+ public:
+  explicit SchedulerBlock(PriorityScheduler& scheduler) {
+    asio::post(
+        scheduler.GetExecutor(TaskPriority::kFocused),
+        [released = release_.get_future().share()]() { released.wait(); });
+  }
+  SchedulerBlock(const SchedulerBlock&) = delete;
+  SchedulerBlock(SchedulerBlock&&) = delete;
+  auto operator=(const SchedulerBlock&) -> SchedulerBlock& = delete;
+  auto operator=(SchedulerBlock&&) -> SchedulerBlock& = delete;
+  ~SchedulerBlock() {
+    Open();
+  }
+
+  auto Open() -> void {
+    if (!opened_) {
+      opened_ = true;
+      release_.set_value();
+    }
+  }
+
+ private:
+  std::promise<void> release_;
+  bool opened_ = false;
+};
+
+auto MainText(const OverlaySession& session) -> std::string {
+  return std::string(
+      session.GetSourceManager().getSourceText(session.GetMainBufferID()));
+}
+
+}  // namespace
+
+TEST_CASE(
+    "SessionManager serves the previous session while rebuilding",
+    "[session_manager]") {
+  RunAsyncTest([](asio::any_io_executor executor) -> asio::awaitable<void> {
+    auto harness = MakeHarness(executor);
+    auto& manager = *harness.manager;
+    std::string uri(kUri);
+
+    co_await manager.UpdateSession(
+        uri, kFirstVersion, 1, TaskPriority::kFocused);
+    auto first = co_await manager.WithSession(
+        uri, [](const OverlaySession& session) { return MainText(session); });
+    REQUIRE(first.has_value());
+    REQUIRE(first->starts_with("module stale_top;"));
+
+    SchedulerBlock block(*harness.scheduler);
+    co_await manager.UpdateSession(
+        uri, kSecondVersion, 2, TaskPriority::kFocused);
+
+    // Answered by version 1 without waiting; `first` is on line 2 of the
+    // current text and on line 1 of the served one
+    auto snapshot = co_await manager.WithSnapshot(
+        uri, [](const OverlaySession& session, const PositionMapper& mapper) {
+          return std::pair(
+              MainText(session),
+              mapper.ToOld(lsp::Position{.line = 2, .character = 8}));
+        });
+    REQUIRE(snapshot.has_value());
+    REQUIRE(snapshot->first.starts_with("module stale_top;"));
+    REQUIRE(snapshot->second.has_value());
+    REQUIRE(snapshot->second->line == 1);
+    REQUIRE(snapshot->second->character == 8);
+
+    // Inside the inserted line there is no counterpart
+    auto inserted = co_await manager.WithSnapshot(
+        uri, [](const OverlaySession&, const PositionMapper& mapper) {
+          return mapper.ToOld(lsp::Position{.line = 0, .character = 3});
+        });
+    REQUIRE(inserted.has_value());
+    REQUIRE_FALSE(inserted->has_value());
+
+    block.Open();
+    auto second = co_await manager.WithSession(
+        uri, [](const OverlaySession& session) { return MainText(session); });
+    REQUIRE(second.has_value());
+    REQUIRE(second->starts_with("// edited"));
+
+    // Once version 2 is indexed it is served directly
+    auto current = co_await manager.WithSnapshot(
+        uri, [](const OverlaySession& session, const PositionMapper& mapper) {
+          return std::pair(MainText(session), mapper.IsIdentity());
+        });
+    REQUIRE(current.has_value());
+    REQUIRE(current->first.starts_with("// edited"));
+    REQUIRE(current->second);
+    co_await manager.Shutdown();
+  });
+}
+
+TEST_CASE(
+    "SessionManager drops the previous session when its rebuild is cancelled",
+    "[session_manager]") {
+  RunAsyncTest([](asio::any_io_executor executor) -> asio::awaitable<void> {
+    auto harness = MakeHarness(executor);
+    auto& manager = *harness.manager;
+    std::string uri(kUri);
+
+    co_await manager.UpdateSession(
+        uri, kFirstVersion, 1, TaskPriority::kFocused);
+    auto first = co_await manager.WithSession(
+        uri, [](const OverlaySession&) { return true; });
+    REQUIRE(first.has_value());
+
+    SchedulerBlock block(*harness.scheduler);
+    co_await manager.UpdateSession(
+        uri, kSecondVersion, 2, TaskPriority::kFocused);
+    manager.CancelPendingSession(uri);
+    // Let the cancellation reach the session strand first
+    co_await asio::post(executor, asio::use_awaitable);
+
+    auto snapshot = co_await manager.WithSnapshot(
+        uri, [](const OverlaySession&, const PositionMapper&) { return true; });
+    REQUIRE_FALSE(snapshot.has_value());
+
+    // A later version still builds, and the cancelled build drains before it
+    block.Open();
+    co_await manager.UpdateSession(
+        uri, kSecondVersion, 3, TaskPriority::kFocused);
+    auto third = co_await manager.WithSession(
+        uri, [](const OverlaySession& session) { return MainText(session); });
+    REQUIRE(third.has_value());
+    REQUIRE(third->starts_with("// edited"));
+    co_await manager.Shutdown();
+  });
+}
+
+TEST_CASE(
+    "SessionManager stores nothing for a cancelled build", "[session_manager]") {
+  RunAsyncTest([](asio::any_io_executor executor) -> asio::awaitable<void> {
+    auto harness = MakeHarness(executor);
+    auto& manager = *harness.manager;
+    std::string uri(kUri);
+    std::string other_uri = "file:///other_top.sv";
+
+    SchedulerBlock block(*harness.scheduler);
+    co_await manager.UpdateSession(
+        uri, kFirstVersion, 1, TaskPriority::kFocused);
+    manager.CancelPendingSession(uri);
+    // Let the cancellation reach the session strand first
+    co_await asio::post(executor, asio::use_awaitable);
+    co_await manager.UpdateSession(
+        other_uri, "module other_top;\nendmodule\n", 1,
+        TaskPriority::kFocused);
+
+    // One scheduler thread: the cancelled build is queued first, so it has
+    // finished once the other session is ready
+    block.Open();
+    auto other = co_await manager.WithSession(
+        other_uri, [](const OverlaySession&) { return true; });
+    REQUIRE(other.has_value());
+
+    auto session = co_await manager.WithSession(
+        uri, [](const OverlaySession&) { return true; });
+    REQUIRE_FALSE(session.has_value());
+    co_await manager.Shutdown();
+  });
+}
+
+TEST_CASE(
+    "SessionManager Shutdown waits for its builds and keeps the scheduler",
+    "[session_manager]") {
+  RunAsyncTest([](asio::any_io_executor executor) -> asio::awaitable<void> {
+    auto harness = MakeHarness(executor);
+    auto& manager = *harness.manager;
+    std::string uri(kUri);
+
+    co_await manager.UpdateSession(
+        uri, kFirstVersion, 1, TaskPriority::kFocused);
+    co_await manager.Shutdown();
+
+    // Updates after shutdown are dropped
+    co_await manager.UpdateSession(
+        uri, kSecondVersion, 2, TaskPriority::kFocused);
+    auto session = co_await manager.WithSession(
+        uri, [](const OverlaySession&) { return true; });
+    REQUIRE_FALSE(session.has_value());
+
+    // The scheduler belongs to the caller and still runs work (a joined
+    // one would never resume this coroutine)
+    co_await asio::post(
+        harness.scheduler->GetExecutor(TaskPriority::kBackground),
+        asio::use_awaitable);
+    co_await asio::post(executor, asio::use_awaitable);
+  });
+}
@@ -0,0 +1,117 @@
+#include "slangd/services/symbol_search_index.hpp"
+
+#include <initializer_list>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+#include <spdlog/spdlog.h>
+
+#include "slangd/syntax/index_collector.hpp"
+
+constexpr auto kLogLevel = spdlog::level::debug;
+
+auto main(int argc, char* argv[]) -> int {
+  spdlog::set_level(kLogLevel);
+  spdlog::set_pattern("[%l] %v");
+  return Catch::Session().run(argc, argv);
+}
+
+using slangd::services::FileIndex;
+using slangd::services::SymbolSearchIndex;
+
+namespace {
+
+using Names = std::vector<std::string>;
+
+auto MakeShard(std::string_view path, const Names& names)
+    -> std::shared_ptr<const FileIndex> {
+  slangd::syntax::IndexedFile file;
+  for (size_t i = 0; i < names.size(); ++i) {
+    auto line = static_cast<int>(i);
+    file.symbols.push_back(
+        slangd::syntax::IndexedSymbol{
+            .name = names[i],
+            .container = {},
+            .kind = lsp::SymbolKind::kModule,
+            .range = lsp::Range{
+                .start = {.line = line, .character = 7},
+                .end = {
+                    .line = line,
+                    .character = 7 + static_cast<int>(names[i].size())}}});
+  }
+  return FileIndex::Build(path, 0, 0, file);
+}
+
+// Search results as names
+class SearchFixture {
+ public:
+  SearchFixture(std::initializer_list<Names> files) {
+    for (const auto& names : files) {
+      auto path = "/rtl/f" + std::to_string(shards_.size()) + ".sv";
+      shards_.push_back(MakeShard(path, names));
+      raw_.push_back(shards_.back().get());
+    }
+    index_ = SymbolSearchIndex::Build(raw_);
+  }
+
+  auto Search(std::string_view query, size_t limit = 100) -> Names {
+    Names names;
+    for (const auto& hit : index_.Search(query, limit)) {
+      const auto* shard = raw_[hit.file];
+      names.emplace_back(
+          shard->GetName(shard->GetSymbols()[hit.symbol].name));
+    }
+    return names;
+  }
+
+ private:
+  std::vector<std::shared_ptr<const FileIndex>> shards_;
+  std::vector<const FileIndex*> raw_;
+  SymbolSearchIndex index_;
+};
+
+}  // namespace
+
+TEST_CASE(
+    "SymbolSearchIndex finds substrings across files", "[symbol_search]") {
+  SearchFixture fixture{
+      {"uart_tx", "uart_rx", "spi_master"}, {"axi_uart_bridge", "fifo"}};
+
+  auto names = fixture.Search("uart");
+  std::ranges::sort(names);
+  REQUIRE(names == Names{"axi_uart_bridge", "uart_rx", "uart_tx"});
+  REQUIRE(fixture.Search("master") == Names{"spi_master"});
+  REQUIRE(fixture.Search("i2c").empty());
+}
+
+TEST_CASE("SymbolSearchIndex ignores case", "[symbol_search]") {
+  SearchFixture fixture{{"AxiLiteSlave", "axi_stream"}};
+
+  REQUIRE(fixture.Search("axilite") == Names{"AxiLiteSlave"});
+  REQUIRE(fixture.Search("AXI_STR") == Names{"axi_stream"});
+}
+
+TEST_CASE("SymbolSearchIndex verifies trigram order", "[symbol_search]") {
+  // "abcxbcd" contains every trigram of "abcd" but not the substring
+  SearchFixture fixture{{"abcxbcd", "xabcdx"}};
+
+  REQUIRE(fixture.Search("abcd") == Names{"xabcdx"});
+}
+
+TEST_CASE("SymbolSearchIndex ranks exact and prefix first", "[symbol_search]") {
+  SearchFixture fixture{{"my_fifo_ctrl", "fifo_ctrl", "fifo", "fifo_wide"}};
+
+  REQUIRE(
+      fixture.Search("fifo") ==
+      Names{"fifo", "fifo_ctrl", "fifo_wide", "my_fifo_ctrl"});
+  REQUIRE(fixture.Search("fifo", 2) == Names{"fifo", "fifo_ctrl"});
+}
+
+TEST_CASE("SymbolSearchIndex handles short queries", "[symbol_search]") {
+  SearchFixture fixture{{"top", "tb_top", "alu"}};
+
+  REQUIRE(fixture.Search("to") == Names{"top", "tb_top"});
+  REQUIRE(fixture.Search("").size() == 3);
+}
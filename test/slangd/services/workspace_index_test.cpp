@@ -0,0 +1,336 @@
+#include "slangd/services/workspace_index.hpp"
+
+#include <cstdlib>
+#include <fstream>
+#include <string>
+
+#include <asio.hpp>
+#include <catch2/catch_all.hpp>
+#include <spdlog/spdlog.h>
+
+#include "slangd/core/project_layout_service.hpp"
+#include "slangd/services/preamble_manager.hpp"
+#include "slangd/services/reference_index.hpp"
+#include "test/slangd/common/async_fixture.hpp"
+#include "test/slangd/common/file_fixture.hpp"
+
+constexpr auto kLogLevel = spdlog::level::debug;
+
+auto main(int argc, char* argv[]) -> int {
+  spdlog::set_level(kLogLevel);
+  spdlog::set_pattern("[%l] %v");
+
+  setenv("TEST_SHARD_INDEX", "0", 0);
+  setenv("TEST_TOTAL_SHARDS", "1", 0);
+  setenv("TEST_SHARD_STATUS_FILE", "", 0);
+
+  return Catch::Session().run(argc, argv);
+}
+
+using slangd::services::FileIndex;
+using slangd::services::IndexArtifact;
+using slangd::services::PreambleManager;
+using slangd::services::ReferenceIndex;
+using slangd::services::WorkspaceIndex;
+using slangd::test::RunAsyncTest;
+
+namespace {
+
+class WorkspaceIndexFixture : public slangd::test::FileTestFixture {
+ public:
+  WorkspaceIndexFixture() : FileTestFixture("slangd_workspace_index_test") {
+  }
+
+  auto BuildPreamble(asio::any_io_executor executor)
+      -> asio::awaitable<std::shared_ptr<const PreambleManager>> {
+    auto layout_service = slangd::ProjectLayoutService::Create(
+        executor, GetTempDir(), spdlog::default_logger());
+    auto result = co_await PreambleManager::CreateFromProjectLayout(
+        layout_service, executor, spdlog::default_logger());
+    REQUIRE(result.has_value());
+    co_return *result;
+  }
+
+  auto BuildIndex(
+      asio::any_io_executor executor,
+      std::shared_ptr<const WorkspaceIndex> previous, bool persist = true,
+      std::shared_ptr<const IndexArtifact> artifact = nullptr)
+      -> asio::awaitable<std::shared_ptr<const WorkspaceIndex>> {
+    auto preamble = co_await BuildPreamble(executor);
+    co_return co_await WorkspaceIndex::Build(
+        preamble, std::move(previous),
+        persist ? GetCacheDir() : std::filesystem::path{}, executor, nullptr,
+        std::move(artifact));
+  }
+
+  // Outside the workspace root: shards must not be discovered as sources
+  [[nodiscard]] auto GetCacheDir() const -> std::filesystem::path {
+    return GetTempDir().Path().parent_path() / "slangd_workspace_index_cache";
+  }
+};
+
+constexpr std::string_view kPackage = R"(
+package bus_pkg;
+  parameter int WIDTH = 8;
+  typedef logic [WIDTH-1:0] word_t;
+endpackage
+)";
+
+constexpr std::string_view kModule = R"(
+module consumer;
+  import bus_pkg::*;
+  word_t data;
+  logic [bus_pkg::WIDTH-1:0] raw;
+endmodule
+)";
+
+}  // namespace
+
+TEST_CASE(
+    "WorkspaceIndex finds declarations and occurrences across files",
+    "[workspace_index]") {
+  WorkspaceIndexFixture fixture;
+  fixture.CreateFile("bus_pkg.sv", kPackage);
+  fixture.CreateFile("consumer.sv", kModule);
+
+  RunAsyncTest([&](asio::any_io_executor executor) -> asio::awaitable<void> {
+    auto index = co_await fixture.BuildIndex(executor, nullptr, false);
+    REQUIRE(index->GetStats().files == 2);
+    REQUIRE(index->GetStats().collected == 2);
+
+    // One use in each file, plus the declaration
+    auto references = index->FindOccurrences("WIDTH", false);
+    REQUIRE(references.size() == 2);
+    auto occurrences = index->FindOccurrences("WIDTH", true);
+    REQUIRE(occurrences.size() == 3);
+    REQUIRE(occurrences[0].uri.ends_with("bus_pkg.sv"));
+    REQUIRE(occurrences[0].range.start.line == 2);
+    REQUIRE(index->FindOccurrences("word_t", false).size() == 1);
+    REQUIRE(index->FindOccurrences("missing", true).empty());
+
+    const auto* module_file = index->GetFile(references[1].uri);
+    REQUIRE(module_file != nullptr);
+    bool found_data = false;
+    for (const auto& symbol : module_file->GetSymbols()) {
+      if (module_file->GetName(symbol.name) == "data") {
+        found_data = true;
+        REQUIRE(module_file->GetName(symbol.container) == "consumer");
+      }
+    }
+    REQUIRE(found_data);
+  });
+}
+
+TEST_CASE(
+    "WorkspaceIndex re-collects only changed files", "[workspace_index]") {
+  WorkspaceIndexFixture fixture;
+  fixture.CreateFile("bus_pkg.sv", kPackage);
+  fixture.CreateFile("consumer.sv", kModule);
+  std::filesystem::remove_all(fixture.GetCacheDir());
+
+  RunAsyncTest([&](asio::any_io_executor executor) -> asio::awaitable<void> {
+    auto first = co_await fixture.BuildIndex(executor, nullptr);
+    REQUIRE(first->GetStats().collected == 2);
+
+    // Same content: shards are shared with the previous snapshot
+    auto second = co_await fixture.BuildIndex(executor, first);
+    REQUIRE(second->GetStats().reused == 2);
+
+    // Fresh start: shards are mapped from the cache directory
+    auto restarted = co_await fixture.BuildIndex(executor, nullptr);
+    REQUIRE(restarted->GetStats().loaded == 2);
+    REQUIRE(restarted->MemoryUsage() < first->MemoryUsage());
+    REQUIRE(restarted->FindOccurrences("WIDTH", true).size() == 3);
+
+    fixture.CreateFile(
+        "consumer.sv", "module consumer; logic [7:0] raw; endmodule\n");
+    auto edited = co_await fixture.BuildIndex(executor, restarted);
+    REQUIRE(edited->GetStats().reused == 1);
+    REQUIRE(edited->GetStats().collected == 1);
+    REQUIRE(edited->FindOccurrences("WIDTH", true).size() == 2);
+  });
+
+  std::filesystem::remove_all(fixture.GetCacheDir());
+}
+
+TEST_CASE(
+    "WorkspaceIndex re-collects every file when defines change",
+    "[workspace_index]") {
+  WorkspaceIndexFixture fixture;
+  fixture.CreateFile("bus_pkg.sv", kPackage);
+  fixture.CreateFile("consumer.sv", kModule);
+  std::filesystem::remove_all(fixture.GetCacheDir());
+
+  RunAsyncTest([&](asio::any_io_executor executor) -> asio::awaitable<void> {
+    auto first = co_await fixture.BuildIndex(executor, nullptr);
+    REQUIRE(first->GetStats().collected == 2);
+
+    // Same text, other preprocessor input: neither the previous snapshot nor
+    // the shards on disk may be used
+    fixture.CreateFile(".slangd", "Defines:\n  - BUS_WIDE\n");
+    auto changed = co_await fixture.BuildIndex(executor, first);
+    REQUIRE(changed->GetStats().reused == 0);
+    REQUIRE(changed->GetStats().loaded == 0);
+    REQUIRE(changed->GetStats().collected == 2);
+
+    auto restarted = co_await fixture.BuildIndex(executor, nullptr);
+    REQUIRE(restarted->GetStats().loaded == 2);
+  });
+
+  std::filesystem::remove_all(fixture.GetCacheDir());
+}
+
+TEST_CASE(
+    "WorkspaceIndex reports files affected by a change", "[workspace_index]") {
+  WorkspaceIndexFixture fixture;
+  fixture.CreateFile("bus_pkg.sv", kPackage);
+  fixture.CreateFile("consumer.sv", kModule);
+  fixture.CreateFile("other.sv", "module other; logic x; endmodule\n");
+
+  RunAsyncTest([&](asio::any_io_executor executor) -> asio::awaitable<void> {
+    auto first = co_await fixture.BuildIndex(executor, nullptr, false);
+    auto unchanged = co_await fixture.BuildIndex(executor, first, false);
+    REQUIRE(unchanged->FilesAffectedSince(*first).empty());
+
+    // A file naming a declaration of the edited file is affected too
+    fixture.CreateFile(
+        "bus_pkg.sv",
+        "package bus_pkg; parameter int WIDTH = 16; "
+        "typedef logic [WIDTH-1:0] word_t; endpackage\n");
+    auto edited = co_await fixture.BuildIndex(executor, first, false);
+    auto affected = edited->FilesAffectedSince(*first);
+    REQUIRE(affected.size() == 2);
+    REQUIRE(affected[0].ends_with("bus_pkg.sv"));
+    REQUIRE(affected[1].ends_with("consumer.sv"));
+
+    fixture.CreateFile("other.sv", "module other; logic y; endmodule\n");
+    auto leaf = co_await fixture.BuildIndex(executor, edited, false);
+    affected = leaf->FilesAffectedSince(*edited);
+    REQUIRE(affected.size() == 1);
+    REQUIRE(affected[0].ends_with("other.sv"));
+  });
+}
+
+TEST_CASE("FileIndex rejects corrupt shards", "[workspace_index]") {
+  WorkspaceIndexFixture fixture;
+  auto shard = fixture.GetTempDir().Path() / "broken.idx";
+  {
+    std::ofstream out(shard, std::ios::binary);
+    out << std::string(64, 'x');
+  }
+
+  REQUIRE(FileIndex::Load(shard, "broken.sv", 0, 0) == nullptr);
+  REQUIRE(
+      FileIndex::Load(shard.string() + ".missing", "x.sv", 0, 0) == nullptr);
+}
+
+TEST_CASE(
+    "WorkspaceIndex imports unchanged files from an index artifact",
+    "[workspace_index]") {
+  WorkspaceIndexFixture fixture;
+  fixture.CreateFile("bus_pkg.sv", kPackage);
+  fixture.CreateFile("consumer.sv", kModule);
+  auto artifact_path = fixture.GetCacheDir().parent_path() /
+                       "slangd_workspace_index_artifact.slia";
+
+  RunAsyncTest([&](asio::any_io_executor executor) -> asio::awaitable<void> {
+    auto built = co_await fixture.BuildIndex(executor, nullptr, false);
+    std::string consumer_uri;
+    std::string package_uri;
+    built->ForEachFile([&](std::string_view uri, const FileIndex& /*shard*/) {
+      (uri.ends_with("consumer.sv") ? consumer_uri : package_uri) = uri;
+    });
+    auto root_uri = fixture.GetTempDir().ToUri() + "/";
+    // `word_t` in consumer.sv, declared in bus_pkg.sv
+    auto word = lsp::Range{
+        .start = {.line = 3, .character = 28},
+        .end = {.line = 3, .character = 34}};
+    auto use = lsp::Range{
+        .start = {.line = 3, .character = 2},
+        .end = {.line = 3, .character = 8}};
+    IndexArtifact::References references;
+    references.emplace(package_uri, ReferenceIndex::FileReferences{});
+    references.emplace(
+        consumer_uri,
+        ReferenceIndex::FileReferences{
+            .def_uris = {root_uri + "bus_pkg.sv", "file:///elsewhere/x.sv"},
+            .references = {
+                {.def_uri = 0,
+                 .def_range = word,
+                 .range = use,
+                 .is_declaration = false},
+                {.def_uri = 1,
+                 .def_range = use,
+                 .range = use,
+                 .is_declaration = true}}});
+    auto written = IndexArtifact::Write(
+        *built, references, 0x5eed, fixture.GetTempDir(), artifact_path);
+    REQUIRE(written == 2);
+
+    // Only the unchanged file is taken from the artifact
+    fixture.CreateFile(
+        "consumer.sv", "module consumer; logic [7:0] raw; endmodule\n");
+    auto artifact = IndexArtifact::Open(artifact_path, fixture.GetTempDir());
+    REQUIRE(artifact.has_value());
+    REQUIRE((*artifact)->FileCount() == 2);
+
+    auto index =
+        co_await fixture.BuildIndex(executor, nullptr, false, *artifact);
+    REQUIRE(index->GetStats().imported == 1);
+    REQUIRE(index->GetStats().collected == 1);
+    REQUIRE(index->FindOccurrences("WIDTH", true).size() == 2);
+    REQUIRE(index->SearchSymbols("word_t", 10).size() == 1);
+
+    // References come back with workspace URIs re-rooted, and only for the
+    // content they were swept from
+    REQUIRE((*artifact)->GetHeaderFingerprint() == 0x5eed);
+    const auto* shard = built->GetFile(consumer_uri);
+    REQUIRE(shard != nullptr);
+    auto consumer_path = std::string(shard->GetPath());
+    auto swept = (*artifact)->FindReferences(
+        consumer_path, shard->GetContentHash(), shard->GetOptionsKey());
+    REQUIRE(swept.has_value());
+    REQUIRE(swept->def_uris.size() == 2);
+    REQUIRE(swept->def_uris[0] == root_uri + "bus_pkg.sv");
+    REQUIRE(swept->def_uris[1] == "file:///elsewhere/x.sv");
+    REQUIRE(swept->references.size() == 2);
+    REQUIRE(swept->references[0].def_range == word);
+    REQUIRE(swept->references[0].range == use);
+    REQUIRE_FALSE(swept->references[0].is_declaration);
+    REQUIRE(swept->references[1].def_uri == 1);
+    REQUIRE(swept->references[1].is_declaration);
+    const auto* package = built->GetFile(package_uri);
+    REQUIRE(package != nullptr);
+    auto package_swept = (*artifact)->FindReferences(
+        package->GetPath(), package->GetContentHash(),
+        package->GetOptionsKey());
+    REQUIRE(package_swept.has_value());
+    REQUIRE(package_swept->references.empty());
+    REQUIRE_FALSE(
+        (*artifact)
+            ->FindReferences(
+                consumer_path, shard->GetContentHash() + 1,
+                shard->GetOptionsKey())
+            .has_value());
+
+    // A server starting from the artifact re-sweeps only the edited file
+    auto affected =
+        index->FilesAffectedSince(*WorkspaceIndex::FromArtifact(**artifact));
+    REQUIRE(affected.size() == 1);
+    REQUIRE(affected[0] == consumer_uri);
+  });
+
+  // Any flipped byte fails the checksum
+  {
+    std::fstream file(
+        artifact_path, std::ios::in | std::ios::out | std::ios::binary);
+    file.seekp(-1, std::ios::end);
+    file.put('\x7f');
+  }
+  auto corrupt = IndexArtifact::Open(artifact_path, fixture.GetTempDir());
+  REQUIRE_FALSE(corrupt.has_value());
+  auto missing = IndexArtifact::Open(
+      artifact_path.string() + ".missing", fixture.GetTempDir());
+  REQUIRE_FALSE(missing.has_value());
+  std::filesystem::remove(artifact_path);
+}
@@ -0,0 +1,115 @@
+#include "slangd/utils/directory_walker.hpp"
+
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+#include <spdlog/spdlog.h>
+
+#include "test/slangd/common/file_fixture.hpp"
+
+constexpr auto kLogLevel = spdlog::level::debug;
+
+auto main(int argc, char* argv[]) -> int {
+  spdlog::set_level(kLogLevel);
+  spdlog::set_pattern("[%l] %v");
+
+  setenv("TEST_SHARD_INDEX", "0", 0);
+  setenv("TEST_TOTAL_SHARDS", "1", 0);
+  setenv("TEST_SHARD_STATUS_FILE", "", 0);
+
+  return Catch::Session().run(argc, argv);
+}
+
+using slangd::CanonicalPath;
+using slangd::utils::DirectoryWalkOptions;
+using slangd::utils::WalkDirectories;
+
+namespace {
+
+class WalkerFixture : public slangd::test::FileTestFixture {
+ public:
+  WalkerFixture() : FileTestFixture("slangd_directory_walker_test") {
+  }
+
+  auto Touch(const std::string& relative) -> void {
+    auto path = GetTempDir().Path() / relative;
+    std::filesystem::create_directories(path.parent_path());
+    CreateFile(relative, "");
+  }
+
+  auto Relative(const std::vector<CanonicalPath>& files)
+      -> std::vector<std::string> {
+    std::vector<std::string> result;
+    for (const auto& file : files) {
+      result.push_back(
+          std::filesystem::relative(file.Path(), GetTempDir().Path())
+              .string());
+    }
+    return result;
+  }
+};
+
+auto SvOptions(size_t num_threads) -> DirectoryWalkOptions {
+  return DirectoryWalkOptions{
+      .should_descend =
+          [](const std::filesystem::path& directory) {
+            return directory.filename() != "skip";
+          },
+      .should_collect =
+          [](std::string_view name) { return name.ends_with(".sv"); },
+      .num_threads = num_threads,
+  };
+}
+
+}  // namespace
+
+TEST_CASE("WalkDirectories collects files and prunes subtrees", "[walker]") {
+  WalkerFixture fixture;
+  fixture.Touch("top.sv");
+  fixture.Touch("notes.txt");
+  fixture.Touch("rtl/a.sv");
+  fixture.Touch("rtl/core/b.sv");
+  fixture.Touch("rtl/skip/c.sv");
+  fixture.Touch("tb/d.sv");
+
+  for (size_t threads : {1, 4}) {
+    auto files = WalkDirectories({fixture.GetTempDir()}, SvOptions(threads));
+    REQUIRE(
+        fixture.Relative(files) ==
+        std::vector<std::string>{"rtl/a.sv", "rtl/core/b.sv", "tb/d.sv",
+                                 "top.sv"});
+  }
+}
+
+TEST_CASE("WalkDirectories walks nested roots once", "[walker]") {
+  WalkerFixture fixture;
+  fixture.Touch("rtl/a.sv");
+  fixture.Touch("rtl/core/b.sv");
+
+  auto root = fixture.GetTempDir();
+  auto files = WalkDirectories({root / "rtl/core", root / "rtl"}, SvOptions(2));
+  REQUIRE(
+      fixture.Relative(files) ==
+      std::vector<std::string>{"rtl/a.sv", "rtl/core/b.sv"});
+}
+
+TEST_CASE("WalkDirectories spreads a deep tree across workers", "[walker]") {
+  WalkerFixture fixture;
+  std::vector<std::string> expected;
+  for (int i = 0; i < 20; ++i) {
+    for (int j = 0; j < 10; ++j) {
+      auto file = "d" + std::to_string(i) + "/s" + std::to_string(j) + "/f.sv";
+      fixture.Touch(file);
+      expected.push_back(file);
+    }
+  }
+
+  auto files = WalkDirectories({fixture.GetTempDir()}, SvOptions(8));
+  auto relative = fixture.Relative(files);
+  std::ranges::sort(relative);
+  std::ranges::sort(expected);
+  REQUIRE(relative == expected);
+}
@@ -0,0 +1,58 @@
+#include "slangd/utils/line_index.hpp"
+
+#include <string>
+
+#include <catch2/catch_all.hpp>
+#include <spdlog/spdlog.h>
+
+constexpr auto kLogLevel = spdlog::level::debug;
+
+auto main(int argc, char* argv[]) -> int {
+  spdlog::set_level(kLogLevel);
+  spdlog::set_pattern("[%l] %v");
+  return Catch::Session().run(argc, argv);
+}
+
+using slangd::utils::LineIndex;
+
+TEST_CASE("LineIndex converts positions to offsets", "[line_index]") {
+  LineIndex index("module m;\n  logic a;\n\nendmodule");
+  REQUIRE(index.LineCount() == 4);
+
+  REQUIRE(index.OffsetAt({.line = 0, .character = 0}) == 0);
+  REQUIRE(index.OffsetAt({.line = 1, .character = 2}) == 12);
+  REQUIRE(index.OffsetAt({.line = 2, .character = 0}) == 21);
+  REQUIRE(index.OffsetAt({.line = 3, .character = 9}) == 31);
+
+  // Columns clamp to the line end, lines to the end of the buffer
+  REQUIRE(index.OffsetAt({.line = 1, .character = 100}) == 20);
+  REQUIRE(index.OffsetAt({.line = 3, .character = 100}) == 31);
+  REQUIRE(index.OffsetAt({.line = 10, .character = 0}) == 31);
+}
+
+TEST_CASE("LineIndex converts offsets to positions", "[line_index]") {
+  std::string text;
+  for (int i = 0; i < 1000; ++i) {
+    text += "line " + std::to_string(i) + "\n";
+  }
+  LineIndex index(text);
+  REQUIRE(index.LineCount() == 1001);
+
+  for (int line : {0, 1, 99, 500, 999}) {
+    auto offset = index.OffsetAt({.line = line, .character = 3});
+    auto position = index.PositionAt(offset);
+    REQUIRE(position.line == line);
+    REQUIRE(position.character == 3);
+  }
+
+  auto end = index.PositionAt(text.size() + 10);
+  REQUIRE(end.line == 1000);
+  REQUIRE(end.character == 0);
+}
+
+TEST_CASE("LineIndex handles empty buffers", "[line_index]") {
+  LineIndex index;
+  REQUIRE(index.LineCount() == 1);
+  REQUIRE(index.OffsetAt({.line = 0, .character = 5}) == 0);
+  REQUIRE(index.PositionAt(0).line == 0);
+}
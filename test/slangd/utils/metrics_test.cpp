@@ -0,0 +1,73 @@
+#include "slangd/utils/metrics.hpp"
+
+#include <catch2/catch_all.hpp>
+#include <spdlog/spdlog.h>
+
+constexpr auto kLogLevel = spdlog::level::debug;
+
+auto main(int argc, char* argv[]) -> int {
+  spdlog::set_level(kLogLevel);
+  spdlog::set_pattern("[%l] %v");
+  return Catch::Session().run(argc, argv);
+}
+
+using slangd::utils::Histogram;
+using slangd::utils::Metrics;
+
+TEST_CASE("Histogram buckets cover values with bounded error", "[metrics]") {
+  for (uint64_t value :
+       {uint64_t{0}, uint64_t{15}, uint64_t{16}, uint64_t{17}, uint64_t{1000},
+        uint64_t{123456789}, UINT64_MAX}) {
+    auto index = Histogram::BucketIndex(value);
+    REQUIRE(index < Histogram::kBucketCount);
+    auto upper = Histogram::BucketUpperBound(index);
+    CHECK(upper >= value);
+    CHECK(upper - value <= value / Histogram::kSubBuckets);
+    if (index > 0) {
+      CHECK(Histogram::BucketUpperBound(index - 1) < value);
+    }
+  }
+}
+
+TEST_CASE("Histogram summary reports percentiles", "[metrics]") {
+  Histogram histogram;
+  for (uint64_t value = 1; value <= 1000; ++value) {
+    histogram.Record(value);
+  }
+
+  auto summary = histogram.Summarize();
+  CHECK(summary.count == 1000);
+  CHECK(summary.sum == 500500);
+  CHECK(summary.min == 1);
+  CHECK(summary.max == 1000);
+  CHECK(summary.p50 >= 500);
+  CHECK(summary.p50 <= 500 + (500 / Histogram::kSubBuckets));
+  CHECK(summary.p99 >= 990);
+  CHECK(summary.p99 <= 1000);
+}
+
+TEST_CASE("Histogram summary of empty histogram is zero", "[metrics]") {
+  Histogram histogram;
+  auto summary = histogram.Summarize();
+  CHECK(summary.count == 0);
+  CHECK(summary.max == 0);
+}
+
+TEST_CASE("Metrics exports registered values and hit rates", "[metrics]") {
+  auto& metrics = Metrics::Instance();
+  metrics.GetCounter("metrics_test.hits").Add(3);
+  metrics.GetCounter("metrics_test.misses").Add();
+  metrics.GetGauge("metrics_test.depth").Set(7);
+  metrics.GetHistogram("metrics_test.latency_us").Record(42);
+
+  // Same name, same instance
+  CHECK(&metrics.GetCounter("metrics_test.hits") ==
+        &metrics.GetCounter("metrics_test.hits"));
+
+  auto json = metrics.ExportJson();
+  CHECK(json["counters"]["metrics_test.hits"] == 3);
+  CHECK(json["gauges"]["metrics_test.depth"] == 7);
+  CHECK(json["histograms"]["metrics_test.latency_us"]["count"] == 1);
+  CHECK(json["histograms"]["metrics_test.latency_us"]["max"] == 42);
+  CHECK(json["hitRates"]["metrics_test"] == 0.75);
+}
@@ -0,0 +1,91 @@
+#include "slangd/utils/position_mapper.hpp"
+
+#include <catch2/catch_all.hpp>
+#include <spdlog/spdlog.h>
+
+constexpr auto kLogLevel = spdlog::level::debug;
+
+auto main(int argc, char* argv[]) -> int {
+  spdlog::set_level(kLogLevel);
+  spdlog::set_pattern("[%l] %v");
+  return Catch::Session().run(argc, argv);
+}
+
+using slangd::utils::PositionMapper;
+
+namespace {
+
+auto Pos(int line, int character) -> lsp::Position {
+  return lsp::Position{.line = line, .character = character};
+}
+
+auto SamePosition(
+    const std::optional<lsp::Position>& actual, const lsp::Position& expected)
+    -> bool {
+  return actual && actual->line == expected.line &&
+         actual->character == expected.character;
+}
+
+}  // namespace
+
+TEST_CASE("PositionMapper default is the identity", "[position_mapper]") {
+  PositionMapper mapper;
+  REQUIRE(mapper.IsIdentity());
+  REQUIRE(SamePosition(mapper.ToOld(Pos(3, 7)), Pos(3, 7)));
+  REQUIRE(SamePosition(mapper.ToNew(Pos(0, 0)), Pos(0, 0)));
+
+  PositionMapper unchanged("module m;\nendmodule\n", "module m;\nendmodule\n");
+  REQUIRE(unchanged.IsIdentity());
+  REQUIRE(SamePosition(unchanged.ToOld(Pos(1, 3)), Pos(1, 3)));
+}
+
+TEST_CASE(
+    "PositionMapper shifts lines after an insertion", "[position_mapper]") {
+  PositionMapper mapper(
+      "module m;\n  logic a;\nendmodule\n",
+      "module m;\n  logic b;\n  logic c;\n  logic a;\nendmodule\n");
+  REQUIRE_FALSE(mapper.IsIdentity());
+
+  // Before the edit: unchanged
+  REQUIRE(SamePosition(mapper.ToOld(Pos(0, 7)), Pos(0, 7)));
+
+  // Inserted lines have no old counterpart
+  REQUIRE_FALSE(mapper.ToOld(Pos(1, 8)).has_value());
+  REQUIRE_FALSE(mapper.ToOld(Pos(2, 8)).has_value());
+
+  // After the edit: two lines down
+  REQUIRE(SamePosition(mapper.ToOld(Pos(3, 8)), Pos(1, 8)));
+  REQUIRE(SamePosition(mapper.ToOld(Pos(4, 0)), Pos(2, 0)));
+  REQUIRE(SamePosition(mapper.ToNew(Pos(1, 8)), Pos(3, 8)));
+}
+
+TEST_CASE(
+    "PositionMapper shifts columns on the edited line", "[position_mapper]") {
+  // Rename `a` to `abc` in the declaration only
+  PositionMapper mapper(
+      "  logic a; assign a = 1;\n", "  logic abc; assign a = 1;\n");
+
+  REQUIRE(SamePosition(mapper.ToOld(Pos(0, 2)), Pos(0, 2)));
+  REQUIRE_FALSE(mapper.ToOld(Pos(0, 9)).has_value());
+  REQUIRE(SamePosition(mapper.ToOld(Pos(0, 21)), Pos(0, 19)));
+  REQUIRE(SamePosition(mapper.ToNew(Pos(0, 19)), Pos(0, 21)));
+}
+
+TEST_CASE("PositionMapper maps ranges", "[position_mapper]") {
+  PositionMapper mapper(
+      "logic a;\nlogic b;\nlogic c;\n", "logic a;\nlogic bb;\nlogic c;\n");
+
+  auto before = mapper.ToNew(lsp::Range{.start = Pos(0, 6), .end = Pos(0, 7)});
+  REQUIRE(before.has_value());
+  REQUIRE(SamePosition(before->start, Pos(0, 6)));
+
+  auto after = mapper.ToNew(lsp::Range{.start = Pos(2, 6), .end = Pos(2, 7)});
+  REQUIRE(after.has_value());
+  REQUIRE(SamePosition(after->start, Pos(2, 6)));
+  REQUIRE(SamePosition(after->end, Pos(2, 7)));
+
+  // A range that covered the edited text is dropped
+  REQUIRE_FALSE(
+      mapper.ToNew(lsp::Range{.start = Pos(1, 0), .end = Pos(2, 0)})
+          .has_value());
+}
@@ -0,0 +1,92 @@
+#include "slangd/utils/priority_scheduler.hpp"
+
+#include <atomic>
+#include <future>
+#include <mutex>
+#include <vector>
+
+#include <asio.hpp>
+#include <catch2/catch_all.hpp>
+#include <spdlog/spdlog.h>
+
+constexpr auto kLogLevel = spdlog::level::debug;
+
+auto main(int argc, char* argv[]) -> int {
+  spdlog::set_level(kLogLevel);
+  spdlog::set_pattern("[%l] %v");
+  return Catch::Session().run(argc, argv);
+}
+
+using slangd::utils::PriorityScheduler;
+using slangd::utils::TaskPriority;
+
+TEST_CASE(
+    "PriorityScheduler runs higher priority tasks first",
+    "[priority_scheduler]") {
+  PriorityScheduler scheduler(1);
+
+  // Block the only worker so everything below is queued
+  std::promise<void> gate;
+  auto gate_future = gate.get_future().share();
+  asio::post(
+      scheduler.GetExecutor(TaskPriority::kBackground),
+      [gate_future]() { gate_future.wait(); });
+
+  std::mutex mutex;
+  std::vector<int> order;
+  auto record = [&](int value) {
+    return [&, value]() {
+      std::lock_guard lock(mutex);
+      order.push_back(value);
+    };
+  };
+
+  asio::post(scheduler.GetExecutor(TaskPriority::kSpeculative), record(4));
+  asio::post(scheduler.GetExecutor(TaskPriority::kBackground), record(3));
+  asio::post(scheduler.GetExecutor(TaskPriority::kBackground), record(31));
+  asio::post(scheduler.GetExecutor(TaskPriority::kVisible), record(2));
+  asio::post(scheduler.GetExecutor(TaskPriority::kFocused), record(1));
+
+  gate.set_value();
+  scheduler.Join();
+
+  REQUIRE(order == std::vector<int>{1, 2, 3, 31, 4});
+}
+
+TEST_CASE(
+    "PriorityScheduler works as an asio executor", "[priority_scheduler]") {
+  PriorityScheduler scheduler(2);
+
+  asio::any_io_executor executor =
+      scheduler.GetExecutor(TaskPriority::kVisible);
+  auto strand = asio::make_strand(executor);
+
+  auto result = asio::co_spawn(
+      strand,
+      []() -> asio::awaitable<int> {
+        auto executor = co_await asio::this_coro::executor;
+        co_await asio::post(executor, asio::use_awaitable);
+        co_return 42;
+      },
+      asio::use_future);
+
+  REQUIRE(result.get() == 42);
+}
+
+TEST_CASE(
+    "PriorityScheduler Join drains tasks posted by running tasks",
+    "[priority_scheduler]") {
+  PriorityScheduler scheduler(4);
+  std::atomic<int> completed{0};
+
+  auto executor = scheduler.GetExecutor(TaskPriority::kBackground);
+  for (int i = 0; i < 16; ++i) {
+    asio::post(executor, [&completed, executor]() {
+      asio::post(executor, [&completed]() { ++completed; });
+      ++completed;
+    });
+  }
+
+  scheduler.Join();
+  REQUIRE(completed == 32);
+}
@@ -0,0 +1,60 @@
+#include "slangd/utils/serial_gate.hpp"
+
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include <asio.hpp>
+#include <catch2/catch_all.hpp>
+#include <spdlog/spdlog.h>
+
+#include "slangd/utils/barrier.hpp"
+#include "test/slangd/common/async_fixture.hpp"
+
+constexpr auto kLogLevel = spdlog::level::debug;
+
+auto main(int argc, char* argv[]) -> int {
+  spdlog::set_level(kLogLevel);
+  spdlog::set_pattern("[%l] %v");
+  return Catch::Session().run(argc, argv);
+}
+
+using slangd::test::RunAsyncTest;
+using slangd::utils::SerialGate;
+using slangd::utils::TaskPriority;
+
+TEST_CASE(
+    "SerialGate hands over to the highest priority waiter", "[serial_gate]") {
+  RunAsyncTest([](asio::any_io_executor executor) -> asio::awaitable<void> {
+    SerialGate gate(executor);
+    std::vector<int> order;
+    auto barrier = std::make_shared<slangd::utils::Barrier>(executor, 3);
+
+    {
+      auto holder = co_await gate.Acquire(TaskPriority::kBackground);
+      auto wait_for_turn = [&](TaskPriority priority, int value) {
+        asio::co_spawn(
+            executor,
+            [&, priority, value, barrier]() -> asio::awaitable<void> {
+              auto lease = co_await gate.Acquire(priority);
+              order.push_back(value);
+              barrier->Arrive();
+            },
+            asio::detached);
+      };
+      wait_for_turn(TaskPriority::kSpeculative, 3);
+      wait_for_turn(TaskPriority::kVisible, 2);
+      wait_for_turn(TaskPriority::kFocused, 1);
+
+      // Let every waiter queue up before the holder releases
+      co_await asio::post(executor, asio::use_awaitable);
+      REQUIRE(order.empty());
+    }
+
+    co_await barrier->AsyncWait(asio::use_awaitable);
+    REQUIRE(order == std::vector<int>{1, 2, 3});
+
+    // Released by the last waiter: free again
+    auto lease = co_await gate.Acquire(TaskPriority::kSpeculative);
+  });
+}
@@ -0,0 +1,50 @@
+#include "slangd/utils/string_interner.hpp"
+
+#include <string>
+#include <utility>
+
+#include <catch2/catch_all.hpp>
+#include <spdlog/spdlog.h>
+
+constexpr auto kLogLevel = spdlog::level::debug;
+
+auto main(int argc, char* argv[]) -> int {
+  spdlog::set_level(kLogLevel);
+  spdlog::set_pattern("[%l] %v");
+  return Catch::Session().run(argc, argv);
+}
+
+using slangd::utils::StringInterner;
+
+TEST_CASE("StringInterner deduplicates strings", "[string_interner]") {
+  StringInterner strings;
+  auto a = strings.Intern("file:///rtl/top.sv");
+  auto b = strings.Intern("counter");
+  auto c = strings.Intern(std::string("file:///rtl/top.sv"));
+
+  REQUIRE(a == c);
+  REQUIRE(a != b);
+  REQUIRE(strings.Size() == 2);
+  REQUIRE(strings.Get(a) == "file:///rtl/top.sv");
+  REQUIRE(strings.Get(b) == "counter");
+}
+
+TEST_CASE("StringInterner keeps views valid", "[string_interner]") {
+  StringInterner strings;
+  auto first = strings.Intern("first_name_that_is_not_a_short_string");
+  auto view = strings.Get(first);
+
+  // Growth must not relocate existing strings
+  for (int i = 0; i < 10000; ++i) {
+    strings.Intern("name_" + std::to_string(i));
+  }
+  REQUIRE(strings.Get(first).data() == view.data());
+  REQUIRE(strings.Intern("name_42") == strings.Intern("name_42"));
+
+  // Neither does moving the interner
+  StringInterner moved = std::move(strings);
+  REQUIRE(moved.Get(first).data() == view.data());
+  REQUIRE(moved.Intern("first_name_that_is_not_a_short_string") == first);
+  REQUIRE(moved.Size() == 10001);
+  REQUIRE(moved.MemoryUsage() > 10001 * sizeof(std::string));
+}
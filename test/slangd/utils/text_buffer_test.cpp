@@ -0,0 +1,116 @@
+#include "slangd/utils/text_buffer.hpp"
+
+#include <string>
+
+#include <catch2/catch_all.hpp>
+#include <spdlog/spdlog.h>
+
+constexpr auto kLogLevel = spdlog::level::debug;
+
+auto main(int argc, char* argv[]) -> int {
+  spdlog::set_level(kLogLevel);
+  spdlog::set_pattern("[%l] %v");
+  return Catch::Session().run(argc, argv);
+}
+
+using slangd::utils::TextBuffer;
+
+namespace {
+
+auto MakeRange(int start_line, int start_char, int end_line, int end_char)
+    -> lsp::Range {
+  return lsp::Range{
+      .start = lsp::Position{.line = start_line, .character = start_char},
+      .end = lsp::Position{.line = end_line, .character = end_char},
+  };
+}
+
+}  // namespace
+
+TEST_CASE("TextBuffer applies single-line edits", "[text_buffer]") {
+  TextBuffer buffer("module m;\n  logic a;\nendmodule\n");
+
+  // Insert
+  buffer.Replace(MakeRange(1, 9, 1, 9), ", b");
+  REQUIRE(buffer.ToString() == "module m;\n  logic a, b;\nendmodule\n");
+
+  // Replace
+  buffer.Replace(MakeRange(1, 2, 1, 7), "wire");
+  REQUIRE(buffer.ToString() == "module m;\n  wire a, b;\nendmodule\n");
+
+  // Delete
+  buffer.Replace(MakeRange(1, 8, 1, 11), "");
+  REQUIRE(buffer.ToString() == "module m;\n  wire a;\nendmodule\n");
+  REQUIRE(buffer.Size() == buffer.ToString().size());
+}
+
+TEST_CASE("TextBuffer applies multi-line edits", "[text_buffer]") {
+  TextBuffer buffer("a\nb\nc\nd\n");
+
+  buffer.Replace(MakeRange(1, 0, 3, 0), "x\ny\nz\n");
+  REQUIRE(buffer.ToString() == "a\nx\ny\nz\nd\n");
+
+  buffer.Replace(MakeRange(0, 1, 4, 0), "");
+  REQUIRE(buffer.ToString() == "ad\n");
+
+  // Append at end of document
+  buffer.Replace(MakeRange(1, 0, 1, 0), "e\n");
+  REQUIRE(buffer.ToString() == "ad\ne\n");
+}
+
+TEST_CASE("TextBuffer edits across chunk boundaries", "[text_buffer]") {
+  std::string expected;
+  for (int i = 0; i < 2000; ++i) {
+    expected += "line " + std::to_string(i) + "\n";
+  }
+  TextBuffer buffer(expected);
+  REQUIRE(buffer.ChunkCount() > 1);
+
+  // Replace a block spanning several chunks, line by line edits after it
+  auto offset_of_line = [&](size_t line) {
+    size_t offset = 0;
+    for (size_t i = 0; i < line; ++i) {
+      offset = expected.find('\n', offset) + 1;
+    }
+    return offset;
+  };
+  auto start = offset_of_line(100);
+  auto end = offset_of_line(1500);
+  expected.replace(start, end - start, "replaced\n");
+  buffer.Replace(MakeRange(100, 0, 1500, 0), "replaced\n");
+  REQUIRE(buffer.ToString() == expected);
+
+  for (int line = 0; line < 500; line += 7) {
+    auto line_start = offset_of_line(static_cast<size_t>(line));
+    expected.insert(line_start + 2, "#");
+    buffer.Replace(MakeRange(line, 2, line, 2), "#");
+  }
+  REQUIRE(buffer.ToString() == expected);
+  REQUIRE(buffer.Size() == expected.size());
+}
+
+TEST_CASE("TextBuffer columns are UTF-16 code units", "[text_buffer]") {
+  // "é" is 1 UTF-16 unit (2 bytes), "😀" is 2 units (4 bytes)
+  TextBuffer buffer("// é😀x\n");
+
+  REQUIRE(buffer.OffsetAt({.line = 0, .character = 4}) == 5);
+  REQUIRE(buffer.OffsetAt({.line = 0, .character = 6}) == 9);
+
+  buffer.Replace(MakeRange(0, 6, 0, 7), "y");
+  REQUIRE(buffer.ToString() == "// é😀y\n");
+}
+
+TEST_CASE("TextBuffer clamps out-of-range positions", "[text_buffer]") {
+  TextBuffer buffer("ab\r\ncd\n");
+
+  // Past end of line stops before the line terminator
+  REQUIRE(buffer.OffsetAt({.line = 0, .character = 10}) == 2);
+  REQUIRE(buffer.OffsetAt({.line = 1, .character = 10}) == 6);
+
+  // Past end of document
+  REQUIRE(buffer.OffsetAt({.line = 5, .character = 0}) == 7);
+
+  TextBuffer empty;
+  empty.Replace(MakeRange(0, 0, 0, 0), "x");
+  REQUIRE(empty.ToString() == "x");
+}
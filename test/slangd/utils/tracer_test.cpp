@@ -0,0 +1,75 @@
+#include "slangd/utils/tracer.hpp"
+
+#include <thread>
+
+#include <catch2/catch_all.hpp>
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+
+constexpr auto kLogLevel = spdlog::level::debug;
+
+auto main(int argc, char* argv[]) -> int {
+  spdlog::set_level(kLogLevel);
+  spdlog::set_pattern("[%l] %v");
+  return Catch::Session().run(argc, argv);
+}
+
+using slangd::utils::TraceSpan;
+using slangd::utils::Tracer;
+
+namespace {
+
+auto EventsNamed(const nlohmann::json& trace, std::string_view name)
+    -> std::vector<nlohmann::json> {
+  std::vector<nlohmann::json> events;
+  for (const auto& event : trace["traceEvents"]) {
+    if (event.value("name", "") == name) {
+      events.push_back(event);
+    }
+  }
+  return events;
+}
+
+}  // namespace
+
+TEST_CASE("Tracer exports same-thread span as complete event", "[tracer]") {
+  {
+    TraceSpan span("tracer_test_complete", "test");
+  }
+
+  auto trace = nlohmann::json::parse(Tracer::Instance().ExportChromeTrace());
+  auto events = EventsNamed(trace, "tracer_test_complete");
+  REQUIRE(events.size() == 1);
+  CHECK(events[0]["ph"] == "X");
+  CHECK(events[0]["cat"] == "test");
+  CHECK(events[0]["dur"].get<int64_t>() >= 0);
+}
+
+TEST_CASE("Tracer exports request span as async pair", "[tracer]") {
+  {
+    TraceSpan span("tracer_test_request", "request", 42);
+  }
+
+  auto trace = nlohmann::json::parse(Tracer::Instance().ExportChromeTrace());
+  auto events = EventsNamed(trace, "tracer_test_request");
+  REQUIRE(events.size() == 2);
+  CHECK(events[0]["ph"] == "b");
+  CHECK(events[1]["ph"] == "e");
+  CHECK(events[0]["id"] == events[1]["id"]);
+}
+
+TEST_CASE("Tracer keeps most recent spans per thread", "[tracer]") {
+  std::jthread worker([]() {
+    Tracer::Instance().SetThreadName("tracer_test_worker");
+    for (size_t i = 0; i < Tracer::kSpansPerThread + 10; ++i) {
+      TraceSpan span(i < 10 ? "tracer_test_dropped" : "tracer_test_kept");
+    }
+  });
+  worker.join();
+
+  auto trace = nlohmann::json::parse(Tracer::Instance().ExportChromeTrace());
+  CHECK(EventsNamed(trace, "tracer_test_dropped").empty());
+  CHECK(
+      EventsNamed(trace, "tracer_test_kept").size() ==
+      Tracer::kSpansPerThread);
+}
@@ -0,0 +1,95 @@
+// Writes a synthetic SystemVerilog project (see project_generator.hpp).
+//
+// Usage: generate_project <out dir> [--scale=<n>] [--packages=<n>]
+//                         [--modules=<n>] [--interfaces=<n>]
+//                         [--class-depth=<n>] [--registers=<n>]
+//
+// --scale picks the base shape (default 1); the other options override
+// single dimensions of it.
+
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "tools/bench/project_generator.hpp"
+
+namespace {
+
+struct GenerateOptions {
+  std::filesystem::path out;
+  slangd::bench::ProjectShape shape;
+};
+
+// Value of `--name=value`, if `arg` is that option
+auto OptionValue(std::string_view arg, std::string_view name)
+    -> std::optional<size_t> {
+  if (!arg.starts_with(name) || arg.size() <= name.size() ||
+      arg[name.size()] != '=') {
+    return std::nullopt;
+  }
+  return std::strtoul(arg.substr(name.size() + 1).data(), nullptr, 10);
+}
+
+auto ParseOptions(const std::vector<std::string>& args)
+    -> std::optional<GenerateOptions> {
+  if (args.size() < 2 || args[1].starts_with("--")) {
+    return std::nullopt;
+  }
+  GenerateOptions options{.out = args[1]};
+
+  size_t scale = 1;
+  for (size_t i = 2; i < args.size(); ++i) {
+    if (auto value = OptionValue(args[i], "--scale")) {
+      scale = *value;
+    }
+  }
+  options.shape = slangd::bench::ProjectShape::Scaled(scale);
+
+  auto& shape = options.shape;
+  for (size_t i = 2; i < args.size(); ++i) {
+    std::string_view arg = args[i];
+    if (OptionValue(arg, "--scale")) {
+      continue;
+    }
+    if (auto value = OptionValue(arg, "--packages")) {
+      shape.packages = *value;
+    } else if (auto value = OptionValue(arg, "--modules")) {
+      shape.modules = *value;
+    } else if (auto value = OptionValue(arg, "--interfaces")) {
+      shape.interfaces = *value;
+    } else if (auto value = OptionValue(arg, "--class-depth")) {
+      shape.class_depth = *value;
+    } else if (auto value = OptionValue(arg, "--registers")) {
+      shape.registers = *value;
+    } else {
+      return std::nullopt;
+    }
+  }
+  return options;
+}
+
+}  // namespace
+
+auto main(int argc, char* argv[]) -> int {
+  std::vector<std::string> args(argv, argv + argc);
+  auto options = ParseOptions(args);
+  if (!options) {
+    std::cerr << "Usage: generate_project <out dir> [--scale=<n>] "
+                 "[--packages=<n>] [--modules=<n>] [--interfaces=<n>] "
+                 "[--class-depth=<n>] [--registers=<n>]\n";
+    return 2;
+  }
+
+  auto project = slangd::bench::GenerateProject(options->shape, options->out);
+  std::cout << fmt::format(
+      "Wrote {} files ({} KB) to {}\nProbe file: {}\n", project.files.size(),
+      project.bytes / 1024, options->out.string(),
+      project.probe_file.string());
+  return 0;
+}
@@ -0,0 +1,212 @@
+// Measures PathMatch/PathExclude filtering of a large file list: the old
+// std::regex constructed per pattern per path against a compiled PathFilter.
+//
+// Usage: path_filter_bench [--paths=<n>] [--repeat=<n>] [--out=<file>]
+//
+// The path list mimics a generated project tree (rtl/tb/ip blocks with
+// generated and scratch directories). Patterns are 4 PathMatch and 8
+// PathExclude entries, one of which needs PathFilter's regex fallback.
+// Results are written as JSON (stdout unless --out is given):
+//   {"benchmarks":[{"name":"regex_per_call","paths":50000,"included":..,
+//                   "unit":"ms","min":..,"median":..,"max":..}, ...]}
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <regex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <fmt/format.h>
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+
+#include "slangd/core/path_filter.hpp"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+using slangd::PathFilter;
+
+const std::vector<std::string> kPathMatch = {
+    "rtl/.*\\.sv$",
+    "rtl/.*\\.svh$",
+    "tb/.*\\.sv$",
+    "ip/.*",
+};
+
+const std::vector<std::string> kPathExclude = {
+    ".*/generated/.*",
+    ".*/obsolete/.*",
+    ".*_bak\\.sv$",
+    "rtl/scratch/.*",
+    ".*/sim_only/.*",
+    "tb/legacy/.*",
+    ".*/tmp_.*",
+    // Alternation: takes the regex fallback
+    ".*/(old|deprecated)/.*",
+};
+
+struct BenchOptions {
+  size_t paths = 50000;
+  size_t repeat = 5;
+  std::optional<std::string> out;
+};
+
+struct Measurement {
+  std::string name;
+  size_t included = 0;
+  std::vector<double> values;
+};
+
+// Value of `--name=value`, if `arg` is that option
+auto OptionValue(std::string_view arg, std::string_view name)
+    -> std::optional<std::string> {
+  if (!arg.starts_with(name) || arg.size() <= name.size() ||
+      arg[name.size()] != '=') {
+    return std::nullopt;
+  }
+  return std::string(arg.substr(name.size() + 1));
+}
+
+auto ParseOptions(const std::vector<std::string>& args)
+    -> std::optional<BenchOptions> {
+  BenchOptions options;
+  for (size_t i = 1; i < args.size(); ++i) {
+    std::string_view arg = args[i];
+    if (auto value = OptionValue(arg, "--paths")) {
+      options.paths = std::strtoul(value->c_str(), nullptr, 10);
+      if (options.paths == 0) {
+        return std::nullopt;
+      }
+    } else if (auto value = OptionValue(arg, "--repeat")) {
+      options.repeat = std::strtoul(value->c_str(), nullptr, 10);
+      if (options.repeat == 0) {
+        return std::nullopt;
+      }
+    } else if (auto value = OptionValue(arg, "--out")) {
+      options.out = *value;
+    } else {
+      return std::nullopt;
+    }
+  }
+  return options;
+}
+
+auto MillisSince(Clock::time_point start) -> double {
+  return std::chrono::duration<double, std::milli>(Clock::now() - start)
+      .count();
+}
+
+auto GeneratePaths(size_t count) -> std::vector<std::string> {
+  constexpr std::array<std::string_view, 4> kRoots = {
+      "rtl", "tb", "ip", "doc"};
+  constexpr std::array<std::string_view, 8> kDirs = {
+      "core", "generated", "scratch", "obsolete",
+      "sim_only", "legacy", "old", "fabric"};
+  constexpr std::array<std::string_view, 4> kSuffixes = {
+      ".sv", ".svh", "_bak.sv", ".txt"};
+
+  std::vector<std::string> paths;
+  paths.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    paths.push_back(fmt::format(
+        "{}/block_{}/{}/{}mod_{}{}", kRoots[i % kRoots.size()], i % 97,
+        kDirs[(i / 4) % kDirs.size()], i % 13 == 0 ? "tmp_" : "", i,
+        kSuffixes[(i / 32) % kSuffixes.size()]));
+  }
+  return paths;
+}
+
+// SlangdConfigFile::ShouldIncludeFile before PathFilter
+auto RegexPerCall(std::string_view relative_path) -> bool {
+  std::string path_str(relative_path);
+  bool matches_any = false;
+  for (const auto& pattern : kPathMatch) {
+    std::regex match_pattern(pattern);
+    if (std::regex_match(path_str, match_pattern)) {
+      matches_any = true;
+      break;
+    }
+  }
+  if (!matches_any) {
+    return false;
+  }
+  for (const auto& pattern : kPathExclude) {
+    std::regex exclude_pattern(pattern);
+    if (std::regex_match(path_str, exclude_pattern)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+auto ToJson(const std::vector<Measurement>& results, size_t paths)
+    -> nlohmann::json {
+  auto benchmarks = nlohmann::json::array();
+  for (auto measurement : results) {
+    std::ranges::sort(measurement.values);
+    const auto& values = measurement.values;
+    benchmarks.push_back(
+        {{"name", measurement.name},
+         {"paths", paths},
+         {"included", measurement.included},
+         {"iterations", values.size()},
+         {"unit", "ms"},
+         {"min", values.front()},
+         {"median", values[values.size() / 2]},
+         {"max", values.back()}});
+  }
+  return {{"benchmarks", benchmarks}};
+}
+
+}  // namespace
+
+auto main(int argc, char* argv[]) -> int {
+  std::vector<std::string> args(argv, argv + argc);
+  auto options = ParseOptions(args);
+  if (!options) {
+    std::cerr << "Usage: path_filter_bench [--paths=<n>] [--repeat=<n>] "
+                 "[--out=<file>]\n";
+    return 2;
+  }
+
+  auto paths = GeneratePaths(options->paths);
+  Measurement regex_per_call{.name = "regex_per_call"};
+  Measurement path_filter{.name = "path_filter"};
+
+  for (size_t run = 0; run < options->repeat; ++run) {
+    auto start = Clock::now();
+    regex_per_call.included = std::ranges::count_if(paths, RegexPerCall);
+    regex_per_call.values.push_back(MillisSince(start));
+
+    // Compiling is part of the cost: it happens once per config load
+    start = Clock::now();
+    auto filter = PathFilter::Compile(kPathMatch, kPathExclude);
+    path_filter.included =
+        std::ranges::count_if(paths, [&](const std::string& path) {
+          return filter.ShouldInclude(path);
+        });
+    path_filter.values.push_back(MillisSince(start));
+  }
+
+  if (regex_per_call.included != path_filter.included) {
+    spdlog::error(
+        "PathFilter included {} paths, std::regex {}", path_filter.included,
+        regex_per_call.included);
+    return 1;
+  }
+
+  auto json = ToJson({regex_per_call, path_filter}, paths.size()).dump(2);
+  if (options->out) {
+    std::ofstream(*options->out) << json << '\n';
+  } else {
+    std::cout << json << '\n';
+  }
+  return 0;
+}
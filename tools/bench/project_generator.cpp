@@ -0,0 +1,220 @@
+#include "tools/bench/project_generator.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <string>
+
+#include <fmt/format.h>
+
+namespace slangd::bench {
+
+namespace {
+
+auto RegisterMapPackage(const ProjectShape& shape) -> std::string {
+  std::string out = "package regmap_pkg;\n";
+
+  out += "  typedef enum logic [31:0] {\n";
+  for (size_t r = 0; r < shape.registers; ++r) {
+    out += fmt::format(
+        "    REG_{}_ADDR = 32'h{:08x}{}\n", r, r * 4,
+        r + 1 < shape.registers ? "," : "");
+  }
+  out += "  } reg_addr_e;\n\n";
+
+  for (size_t r = 0; r < shape.registers; ++r) {
+    out += fmt::format(
+        "  typedef struct packed {{\n"
+        "    logic [7:0] field3;\n"
+        "    logic [7:0] field2;\n"
+        "    logic [7:0] field1;\n"
+        "    logic [7:0] field0;\n"
+        "  }} reg_{0}_t;\n"
+        "  localparam reg_{0}_t REG_{0}_RESET = 32'h{1:08x};\n\n",
+        r, (r * 2654435761U) & 0xffffffffU);
+  }
+
+  out += "endpackage\n";
+  return out;
+}
+
+auto Package(const ProjectShape& shape, size_t i) -> std::string {
+  std::string out = fmt::format(
+      "package pkg_{0};\n"
+      "  import regmap_pkg::*;\n\n"
+      "  parameter int WIDTH_{0} = {1};\n"
+      "  typedef logic [WIDTH_{0}-1:0] word_{0}_t;\n",
+      i, 8 * (1 + (i % 8)));
+  if (i > 0) {
+    out += fmt::format(
+        "  typedef pkg_{0}::word_{0}_t prev_word_{1}_t;\n", i - 1, i);
+  }
+  out += fmt::format(
+      "\n"
+      "  function automatic word_{0}_t scale_{0}(word_{0}_t x);\n"
+      "    return x << 1;\n"
+      "  endfunction\n\n",
+      i);
+
+  for (size_t d = 0; d < shape.class_depth; ++d) {
+    if (d == 0) {
+      out += fmt::format(
+          "  class node_{0}_0;\n"
+          "    int value;\n"
+          "    function new(int v);\n"
+          "      value = v;\n"
+          "    endfunction\n"
+          "    virtual function int compute(int x);\n"
+          "      return x + value;\n"
+          "    endfunction\n"
+          "  endclass\n\n",
+          i);
+    } else {
+      out += fmt::format(
+          "  class node_{0}_{1} extends node_{0}_{2};\n"
+          "    function new(int v);\n"
+          "      super.new(v + {1});\n"
+          "    endfunction\n"
+          "    virtual function int compute(int x);\n"
+          "      return super.compute(x) + value;\n"
+          "    endfunction\n"
+          "  endclass\n\n",
+          i, d, d - 1);
+    }
+  }
+
+  out += fmt::format("  function automatic int run_{}();\n", i);
+  if (shape.class_depth > 0) {
+    out += fmt::format(
+        "    node_{0}_{1} n = new(1);\n"
+        "    return n.compute(2);\n",
+        i, shape.class_depth - 1);
+  } else {
+    out += "    return 0;\n";
+  }
+  out += "  endfunction\nendpackage\n";
+  return out;
+}
+
+auto Interface(size_t j) -> std::string {
+  return fmt::format(
+      "interface bus_if_{} #(parameter int W = 32) (input logic clk);\n"
+      "  logic [W-1:0] data;\n"
+      "  logic valid;\n"
+      "  logic ready;\n"
+      "  modport source(output data, output valid, input ready);\n"
+      "  modport sink(input data, input valid, output ready);\n"
+      "endinterface\n",
+      j);
+}
+
+auto Module(const ProjectShape& shape, size_t k) -> std::string {
+  auto p = k % shape.packages;
+  auto r = k % shape.registers;
+  std::string out = fmt::format(
+      "module mod_{0}\n"
+      "  import pkg_{1}::*;\n"
+      "  import regmap_pkg::*;\n"
+      "(\n"
+      "  input logic clk,\n"
+      "  input logic rst_n,\n"
+      "  bus_if_{2}.sink in_bus\n"
+      ");\n"
+      "  word_{1}_t acc;\n"
+      "  reg_{3}_t status;\n"
+      "  int probe_value;\n\n"
+      "  initial probe_value = run_{1}();\n\n"
+      "  always_ff @(posedge clk or negedge rst_n) begin\n"
+      "    if (!rst_n) begin\n"
+      "      acc <= '0;\n"
+      "      status <= REG_{3}_RESET;\n"
+      "    end else if (in_bus.valid) begin\n"
+      "      acc <= scale_{1}(word_{1}_t'(in_bus.data));\n"
+      "      status.field0 <= acc[7:0];\n"
+      "    end\n"
+      "  end\n\n"
+      "  assign in_bus.ready = 1'b1;\n",
+      k, p, k % shape.interfaces, r);
+
+  for (auto child : {(2 * k) + 1, (2 * k) + 2}) {
+    if (child >= shape.modules) {
+      continue;
+    }
+    out += fmt::format(
+        "\n"
+        "  bus_if_{0} child_bus_{1} (.clk(clk));\n"
+        "  assign child_bus_{1}.data = acc;\n"
+        "  assign child_bus_{1}.valid = in_bus.valid;\n"
+        "  mod_{1} u_mod_{1} (\n"
+        "      .clk(clk),\n"
+        "      .rst_n(rst_n),\n"
+        "      .in_bus(child_bus_{1})\n"
+        "  );\n",
+        child % shape.interfaces, child);
+  }
+  out += "endmodule\n";
+  return out;
+}
+
+auto Top() -> std::string {
+  return "module top;\n"
+         "  logic clk;\n"
+         "  logic rst_n;\n"
+         "  bus_if_0 root_bus (.clk(clk));\n"
+         "  mod_0 u_root (\n"
+         "      .clk(clk),\n"
+         "      .rst_n(rst_n),\n"
+         "      .in_bus(root_bus)\n"
+         "  );\n"
+         "endmodule\n";
+}
+
+}  // namespace
+
+auto ProjectShape::Scaled(size_t scale) -> ProjectShape {
+  scale = std::max<size_t>(scale, 1);
+  return ProjectShape{
+      .packages = 4 * scale,
+      .modules = 32 * scale,
+      .interfaces = 4 * scale,
+      .class_depth = 4 * scale,
+      .registers = 128 * scale};
+}
+
+auto GenerateProject(
+    const ProjectShape& shape, const std::filesystem::path& root)
+    -> GeneratedProject {
+  // Every module references pkg_0, bus_if_0 and REG_0
+  ProjectShape clamped = shape;
+  clamped.packages = std::max<size_t>(shape.packages, 1);
+  clamped.modules = std::max<size_t>(shape.modules, 1);
+  clamped.interfaces = std::max<size_t>(shape.interfaces, 1);
+  clamped.registers = std::max<size_t>(shape.registers, 1);
+
+  GeneratedProject project;
+  auto write = [&](const std::filesystem::path& relative,
+                   const std::string& content) {
+    auto path = root / relative;
+    std::filesystem::create_directories(path.parent_path());
+    std::ofstream(path, std::ios::out | std::ios::trunc) << content;
+    project.files.push_back(path);
+    project.bytes += content.size();
+  };
+
+  write("pkg/regmap_pkg.sv", RegisterMapPackage(clamped));
+  for (size_t i = 0; i < clamped.packages; ++i) {
+    write(fmt::format("pkg/pkg_{}.sv", i), Package(clamped, i));
+  }
+  for (size_t j = 0; j < clamped.interfaces; ++j) {
+    write(fmt::format("if/bus_if_{}.sv", j), Interface(j));
+  }
+  for (size_t k = 0; k < clamped.modules; ++k) {
+    write(fmt::format("rtl/mod_{}.sv", k), Module(clamped, k));
+  }
+  write("rtl/top.sv", Top());
+
+  project.probe_file =
+      root / fmt::format("rtl/mod_{}.sv", (clamped.modules - 1) / 4);
+  return project;
+}
+
+}  // namespace slangd::bench
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <vector>
+
+namespace slangd::bench {
+
+// Size knobs of a generated SystemVerilog project
+struct ProjectShape {
+  // pkg_<i>: typedefs, functions and a class inheritance chain. Each package
+  // imports the register map and refers to the previous package.
+  size_t packages = 4;
+  // mod_<k>: binary tree of instances below `top`, each with an interface
+  // port and one interface instance per child
+  size_t modules = 32;
+  // bus_if_<j>: parameterized interfaces with modports
+  size_t interfaces = 4;
+  // Classes per package, each extending the previous one
+  size_t class_depth = 4;
+  // Registers in regmap_pkg (address enum, struct type, reset value)
+  size_t registers = 128;
+
+  // Scale factor 1 is a small block; sizes grow linearly with `scale`
+  static auto Scaled(size_t scale) -> ProjectShape;
+};
+
+struct GeneratedProject {
+  std::vector<std::filesystem::path> files;
+  size_t bytes = 0;
+  // A module in the upper part of the hierarchy (imports packages, has
+  // interface ports and child instances), used as the benchmark overlay
+  std::filesystem::path probe_file;
+};
+
+// Writes the project into `root` (created if missing, existing files
+// overwritten). The same shape always produces the same files.
+auto GenerateProject(
+    const ProjectShape& shape, const std::filesystem::path& root)
+    -> GeneratedProject;
+
+}  // namespace slangd::bench
@@ -0,0 +1,303 @@
+// Measures how the main build stages scale with project size, on projects
+// written by project_generator.
+//
+// Usage: scaling_bench [--scales=1,4,16] [--repeat=<n>] [--out=<file>]
+//                      [--keep]
+//
+// For each scale factor a project is generated into a temporary directory
+// and every stage is run --repeat times:
+//   preamble  PreambleManager::CreateFromProjectLayout (no PreambleCache)
+//   overlay   OverlaySession::Create for the probe module
+//   index     SemanticIndex::FromCompilation alone (compilation prebuilt)
+//   index_kb  SemanticIndex::MemoryUsage of that index
+//   lookup    LookupDefinitionAt over every reference in the probe module
+// Results are written as JSON (stdout unless --out is given):
+//   {"benchmarks":[{"name":"preamble","scale":1,"files":41,...,
+//                   "unit":"ms","min":..,"median":..,"max":..}, ...]}
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <asio.hpp>
+#include <fmt/format.h>
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+#include <unistd.h>
+
+#include "slangd/core/project_layout_service.hpp"
+#include "slangd/semantic/semantic_index.hpp"
+#include "slangd/services/overlay_session.hpp"
+#include "slangd/services/preamble_manager.hpp"
+#include "slangd/utils/canonical_path.hpp"
+#include "slangd/utils/priority_scheduler.hpp"
+#include "tools/bench/project_generator.hpp"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+using slangd::CanonicalPath;
+using slangd::ProjectLayoutService;
+using slangd::semantic::SemanticIndex;
+using slangd::services::OverlaySession;
+using slangd::services::PreambleManager;
+
+// Lookups timed per repeat; the probe's references are cycled to reach it
+constexpr size_t kMinLookups = 100000;
+
+struct BenchOptions {
+  std::vector<size_t> scales{1, 4, 16};
+  size_t repeat = 3;
+  std::optional<std::filesystem::path> out;
+  bool keep = false;
+};
+
+struct Measurement {
+  std::string name;
+  size_t scale = 0;
+  size_t files = 0;
+  size_t source_bytes = 0;
+  std::string unit;
+  std::vector<double> values;
+};
+
+// Value of `--name=value`, if `arg` is that option
+auto OptionValue(std::string_view arg, std::string_view name)
+    -> std::optional<std::string> {
+  if (!arg.starts_with(name) || arg.size() <= name.size() ||
+      arg[name.size()] != '=') {
+    return std::nullopt;
+  }
+  return std::string(arg.substr(name.size() + 1));
+}
+
+auto ParseScales(const std::string& value) -> std::vector<size_t> {
+  std::vector<size_t> scales;
+  std::stringstream stream(value);
+  std::string item;
+  while (std::getline(stream, item, ',')) {
+    auto scale = std::strtoul(item.c_str(), nullptr, 10);
+    if (scale == 0) {
+      return {};
+    }
+    scales.push_back(scale);
+  }
+  return scales;
+}
+
+auto ParseOptions(const std::vector<std::string>& args)
+    -> std::optional<BenchOptions> {
+  BenchOptions options;
+  for (size_t i = 1; i < args.size(); ++i) {
+    std::string_view arg = args[i];
+    if (auto value = OptionValue(arg, "--scales")) {
+      options.scales = ParseScales(*value);
+      if (options.scales.empty()) {
+        return std::nullopt;
+      }
+    } else if (auto value = OptionValue(arg, "--repeat")) {
+      options.repeat = std::strtoul(value->c_str(), nullptr, 10);
+      if (options.repeat == 0) {
+        return std::nullopt;
+      }
+    } else if (auto value = OptionValue(arg, "--out")) {
+      options.out = *value;
+    } else if (arg == "--keep") {
+      options.keep = true;
+    } else {
+      return std::nullopt;
+    }
+  }
+  return options;
+}
+
+auto MillisSince(Clock::time_point start) -> double {
+  return std::chrono::duration<double, std::milli>(Clock::now() - start)
+      .count();
+}
+
+auto ReadFile(const std::filesystem::path& path) -> std::string {
+  std::ifstream in(path);
+  std::stringstream buffer;
+  buffer << in.rdbuf();
+  return buffer.str();
+}
+
+auto RunScale(
+    size_t scale, const BenchOptions& options,
+    asio::any_io_executor executor, slangd::utils::PriorityScheduler& scheduler,
+    std::vector<Measurement>& results) -> asio::awaitable<bool> {
+  auto logger = spdlog::default_logger();
+  auto root = std::filesystem::temp_directory_path() /
+              fmt::format("slangd-bench-{}-{}", getpid(), scale);
+  std::filesystem::remove_all(root);
+  auto project = slangd::bench::GenerateProject(
+      slangd::bench::ProjectShape::Scaled(scale), root);
+
+  auto layout_service =
+      ProjectLayoutService::Create(executor, CanonicalPath(root), logger);
+  auto uri = CanonicalPath(project.probe_file).ToUri();
+  auto content = ReadFile(project.probe_file);
+
+  auto measurement = [&](std::string name, std::string unit) {
+    return Measurement{
+        .name = std::move(name),
+        .scale = scale,
+        .files = project.files.size(),
+        .source_bytes = project.bytes,
+        .unit = std::move(unit)};
+  };
+  auto preamble_ms = measurement("preamble", "ms");
+  auto overlay_ms = measurement("overlay", "ms");
+  auto index_ms = measurement("index", "ms");
+  auto index_kb = measurement("index_kb", "KB");
+  auto lookup_ns = measurement("lookup", "ns");
+
+  bool ok = true;
+  for (size_t run = 0; run < options.repeat && ok; ++run) {
+    auto start = Clock::now();
+    auto preamble = co_await PreambleManager::CreateFromProjectLayout(
+        layout_service,
+        scheduler.GetExecutor(slangd::utils::TaskPriority::kBackground),
+        logger);
+    preamble_ms.values.push_back(MillisSince(start));
+    if (!preamble) {
+      spdlog::error("Scale {}: preamble failed: {}", scale, preamble.error());
+      ok = false;
+      break;
+    }
+
+    start = Clock::now();
+    auto session = OverlaySession::Create(
+        uri, content, layout_service, *preamble, logger);
+    overlay_ms.values.push_back(MillisSince(start));
+    if (!session) {
+      spdlog::error("Scale {}: overlay session failed", scale);
+      ok = false;
+      break;
+    }
+
+    auto [source_manager, compilation, buffer] =
+        OverlaySession::BuildCompilation(
+            uri, content, layout_service, *preamble, logger);
+    start = Clock::now();
+    auto index = SemanticIndex::FromCompilation(
+        *compilation, *source_manager, uri, buffer, preamble->get(), logger);
+    index_ms.values.push_back(MillisSince(start));
+    if (!index) {
+      spdlog::error("Scale {}: indexing failed: {}", scale, index.error());
+      ok = false;
+      break;
+    }
+    index_kb.values.push_back(
+        static_cast<double>((*index)->MemoryUsage()) / 1024.0);
+
+    std::vector<lsp::Position> positions;
+    for (const auto& entry : session->GetSemanticIndex().GetSemanticEntries()) {
+      if (!entry.is_definition) {
+        positions.push_back(entry.ref_range.start);
+      }
+    }
+    if (positions.empty()) {
+      continue;
+    }
+    const auto& semantic_index = session->GetSemanticIndex();
+    size_t found = 0;
+    size_t lookups = 0;
+    start = Clock::now();
+    while (lookups < kMinLookups) {
+      for (const auto& position : positions) {
+        found += semantic_index.LookupDefinitionAt(uri, position) ? 1 : 0;
+      }
+      lookups += positions.size();
+    }
+    lookup_ns.values.push_back(
+        MillisSince(start) * 1e6 / static_cast<double>(lookups));
+    if (found == 0) {
+      spdlog::warn("Scale {}: no reference in the probe resolved", scale);
+    }
+  }
+
+  for (auto* stage :
+       {&preamble_ms, &overlay_ms, &index_ms, &index_kb, &lookup_ns}) {
+    results.push_back(std::move(*stage));
+  }
+  if (!options.keep) {
+    std::filesystem::remove_all(root);
+  }
+  co_return ok;
+}
+
+auto ToJson(const std::vector<Measurement>& results) -> nlohmann::json {
+  auto benchmarks = nlohmann::json::array();
+  for (auto measurement : results) {
+    if (measurement.values.empty()) {
+      continue;
+    }
+    std::ranges::sort(measurement.values);
+    const auto& values = measurement.values;
+    benchmarks.push_back(
+        {{"name", measurement.name},
+         {"scale", measurement.scale},
+         {"files", measurement.files},
+         {"sourceBytes", measurement.source_bytes},
+         {"iterations", values.size()},
+         {"unit", measurement.unit},
+         {"min", values.front()},
+         {"median", values[values.size() / 2]},
+         {"max", values.back()}});
+  }
+  return {{"benchmarks", benchmarks}};
+}
+
+}  // namespace
+
+auto main(int argc, char* argv[]) -> int {
+  std::vector<std::string> args(argv, argv + argc);
+  auto options = ParseOptions(args);
+  if (!options) {
+    std::cerr << "Usage: scaling_bench [--scales=1,4,16] [--repeat=<n>] "
+                 "[--out=<file>] [--keep]\n";
+    return 2;
+  }
+
+  // Build stages log at info level; keep the timed runs quiet
+  spdlog::set_level(spdlog::level::warn);
+
+  asio::io_context io_context;
+  slangd::utils::PriorityScheduler scheduler(
+      slangd::utils::PriorityScheduler::DefaultThreadCount());
+  std::vector<Measurement> results;
+  bool ok = true;
+
+  asio::co_spawn(
+      io_context,
+      [&]() -> asio::awaitable<void> {
+        for (auto scale : options->scales) {
+          std::cerr << fmt::format("Running scale {}\n", scale);
+          ok = co_await RunScale(
+                   scale, *options, io_context.get_executor(), scheduler,
+                   results) &&
+               ok;
+        }
+      },
+      asio::detached);
+  io_context.run();
+  scheduler.Join();
+
+  auto json = ToJson(results).dump(2);
+  if (options->out) {
+    std::ofstream(*options->out) << json << '\n';
+  } else {
+    std::cout << json << '\n';
+  }
+  return ok ? 0 : 1;
+}
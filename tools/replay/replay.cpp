@@ -0,0 +1,382 @@
+// Replays a recorded LSP session (SLANGD_RECORD=<path>) against an
+// in-process SlangdLspServer and reports latency per method.
+//
+// Usage: replay <recording.jsonl> [--workspace=<dir>] [--speed=<factor>]
+//               [--fast] [--drain-timeout=<seconds>]
+//
+// Client messages are sent with their recorded spacing (scaled by --speed,
+// or back to back with --fast). Request latency is measured up to the
+// response; "diagnostics" is the time from didOpen/didChange to the next
+// publishDiagnostics for that document. The recorded shutdown/exit is
+// replaced by one sent after all requests are answered.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <asio.hpp>
+#include <fmt/format.h>
+#include <jsonrpc/endpoint/endpoint.hpp>
+#include <jsonrpc/transport/transport.hpp>
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+#include <sys/resource.h>
+
+#include "app/app_setup.hpp"
+#include "lsp/recording_transport.hpp"
+#include "slangd/core/slangd_lsp_server.hpp"
+#include "slangd/services/language_service.hpp"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+using jsonrpc::error::RpcError;
+using jsonrpc::error::RpcErrorCode;
+
+constexpr std::string_view kDiagnosticsMethod = "diagnostics";
+constexpr std::string_view kShutdownRequest =
+    R"({"jsonrpc":"2.0","id":"replay-shutdown","method":"shutdown"})";
+constexpr std::string_view kExitNotification =
+    R"({"jsonrpc":"2.0","method":"exit"})";
+
+struct ReplayOptions {
+  std::filesystem::path recording;
+  std::optional<std::filesystem::path> workspace;
+  double speed = 1.0;
+  bool fast = false;
+  std::chrono::seconds drain_timeout{60};
+};
+
+// Value of `--name=value`, if `arg` is that option
+auto OptionValue(std::string_view arg, std::string_view name)
+    -> std::optional<std::string> {
+  if (!arg.starts_with(name) || arg.size() <= name.size() ||
+      arg[name.size()] != '=') {
+    return std::nullopt;
+  }
+  return std::string(arg.substr(name.size() + 1));
+}
+
+auto ParseOptions(const std::vector<std::string>& args)
+    -> std::optional<ReplayOptions> {
+  ReplayOptions options;
+  for (size_t i = 1; i < args.size(); ++i) {
+    std::string_view arg = args[i];
+    if (auto value = OptionValue(arg, "--workspace")) {
+      options.workspace = std::filesystem::absolute(*value);
+    } else if (auto value = OptionValue(arg, "--speed")) {
+      options.speed = std::atof(value->c_str());
+      if (options.speed <= 0.0) {
+        return std::nullopt;
+      }
+    } else if (arg == "--fast") {
+      options.fast = true;
+    } else if (auto value = OptionValue(arg, "--drain-timeout")) {
+      options.drain_timeout = std::chrono::seconds(std::atoi(value->c_str()));
+    } else if (!arg.starts_with("--") && options.recording.empty()) {
+      options.recording = std::string(arg);
+    } else {
+      return std::nullopt;
+    }
+  }
+  if (options.recording.empty()) {
+    return std::nullopt;
+  }
+  return options;
+}
+
+// Workspace URI of the recorded initialize request
+auto RecordedWorkspaceUri(const nlohmann::json& initialize)
+    -> std::optional<std::string> {
+  const auto& params = initialize.value("params", nlohmann::json::object());
+  if (params.contains("workspaceFolders") &&
+      params["workspaceFolders"].is_array() &&
+      !params["workspaceFolders"].empty()) {
+    return params["workspaceFolders"][0].value("uri", "");
+  }
+  if (params.contains("rootUri") && params["rootUri"].is_string()) {
+    return params["rootUri"].get<std::string>();
+  }
+  return std::nullopt;
+}
+
+auto ReplaceAll(std::string& text, std::string_view from, std::string_view to)
+    -> void {
+  for (auto pos = text.find(from); pos != std::string::npos;
+       pos = text.find(from, pos + to.size())) {
+    text.replace(pos, from.size(), to);
+  }
+}
+
+// Client messages to send, with the recorded shutdown/exit removed and the
+// recorded workspace rewritten to `workspace`
+auto PrepareClientMessages(
+    const std::vector<lsp::RecordedMessage>& recording,
+    const std::optional<std::filesystem::path>& workspace)
+    -> std::vector<lsp::RecordedMessage> {
+  std::vector<lsp::RecordedMessage> messages;
+  std::optional<std::string> recorded_root;
+  for (const auto& recorded : recording) {
+    if (recorded.direction != lsp::RecordedMessage::Direction::kIn) {
+      continue;
+    }
+    auto json = nlohmann::json::parse(recorded.message, nullptr, false);
+    auto method = json.is_object() ? json.value("method", "") : "";
+    if (method == "shutdown" || method == "exit") {
+      continue;
+    }
+    if (method == "initialize") {
+      recorded_root = RecordedWorkspaceUri(json);
+    }
+    messages.push_back(recorded);
+  }
+
+  if (workspace && recorded_root && !recorded_root->empty()) {
+    auto new_root = "file://" + workspace->lexically_normal().string();
+    if (new_root.ends_with('/')) {
+      new_root.pop_back();
+    }
+    for (auto& message : messages) {
+      ReplaceAll(message.message, *recorded_root, new_root);
+    }
+  }
+  return messages;
+}
+
+// Latency samples per method, in microseconds
+using LatencySamples = std::map<std::string, std::vector<int64_t>>;
+
+// ReplayTransport: Feeds the recorded client messages to the server and
+// matches its responses (and diagnostics) to measure latency
+class ReplayTransport : public jsonrpc::transport::Transport {
+ public:
+  ReplayTransport(
+      asio::any_io_executor executor,
+      std::vector<lsp::RecordedMessage> messages, const ReplayOptions& options,
+      LatencySamples& samples)
+      : jsonrpc::transport::Transport(executor),
+        executor_(std::move(executor)),
+        messages_(std::move(messages)),
+        options_(options),
+        samples_(samples),
+        start_(Clock::now()) {
+  }
+
+  auto Start() -> asio::awaitable<std::expected<void, RpcError>> override {
+    start_ = Clock::now();
+    co_return std::expected<void, RpcError>{};
+  }
+
+  auto ReceiveMessage()
+      -> asio::awaitable<std::expected<std::string, RpcError>> override {
+    if (next_ < messages_.size()) {
+      const auto& recorded = messages_[next_++];
+      if (!options_.fast) {
+        asio::steady_timer timer(executor_);
+        timer.expires_at(
+            start_ + std::chrono::duration_cast<Clock::duration>(
+                         recorded.time / options_.speed));
+        co_await timer.async_wait(asio::use_awaitable);
+      }
+      OnClientMessage(recorded.message);
+      co_return recorded.message;
+    }
+
+    switch (epilogue_++) {
+      case 0: {
+        // Let outstanding requests finish before shutting down
+        auto deadline = Clock::now() + options_.drain_timeout;
+        asio::steady_timer timer(executor_);
+        while (!pending_requests_.empty() && Clock::now() < deadline) {
+          timer.expires_after(std::chrono::milliseconds(10));
+          co_await timer.async_wait(asio::use_awaitable);
+        }
+        if (!pending_requests_.empty()) {
+          spdlog::warn(
+              "{} requests still unanswered after {}s",
+              pending_requests_.size(), options_.drain_timeout.count());
+        }
+        co_return std::string(kShutdownRequest);
+      }
+      case 1:
+        co_return std::string(kExitNotification);
+      default:
+        co_return RpcError::UnexpectedFromCode(
+            RpcErrorCode::kTransportError, "End of recording");
+    }
+  }
+
+  auto SendMessage(std::string message)
+      -> asio::awaitable<std::expected<void, RpcError>> override {
+    auto json = nlohmann::json::parse(message, nullptr, false);
+    if (!json.is_object()) {
+      co_return std::expected<void, RpcError>{};
+    }
+
+    auto now = Clock::now();
+    if (json.contains("id") && !json.contains("method")) {
+      // Response to a client request
+      auto it = pending_requests_.find(json["id"].dump());
+      if (it != pending_requests_.end()) {
+        Record(it->second.method, now - it->second.sent);
+        pending_requests_.erase(it);
+      }
+    } else if (
+        json.value("method", "") == "textDocument/publishDiagnostics" &&
+        json.contains("params")) {
+      auto uri = json["params"].value("uri", "");
+      if (auto it = pending_diagnostics_.find(uri);
+          it != pending_diagnostics_.end()) {
+        Record(std::string(kDiagnosticsMethod), now - it->second);
+        pending_diagnostics_.erase(it);
+      }
+    }
+    // Server -> client requests are answered by the recorded responses
+    co_return std::expected<void, RpcError>{};
+  }
+
+  auto Close() -> asio::awaitable<std::expected<void, RpcError>> override {
+    co_return std::expected<void, RpcError>{};
+  }
+
+  void CloseNow() override {
+  }
+
+ private:
+  struct PendingRequest {
+    std::string method;
+    Clock::time_point sent;
+  };
+
+  auto OnClientMessage(const std::string& message) -> void {
+    auto json = nlohmann::json::parse(message, nullptr, false);
+    if (!json.is_object() || !json.contains("method")) {
+      return;
+    }
+    auto method = json["method"].get<std::string>();
+    auto now = Clock::now();
+    if (json.contains("id")) {
+      pending_requests_[json["id"].dump()] =
+          PendingRequest{.method = method, .sent = now};
+    } else if (
+        method == "textDocument/didOpen" ||
+        method == "textDocument/didChange") {
+      auto uri = json.value("params", nlohmann::json::object())
+                     .value("textDocument", nlohmann::json::object())
+                     .value("uri", "");
+      // Only the first edit of a burst starts the clock
+      pending_diagnostics_.try_emplace(uri, now);
+    }
+  }
+
+  auto Record(const std::string& method, Clock::duration latency) -> void {
+    samples_[method].push_back(
+        std::chrono::duration_cast<std::chrono::microseconds>(latency)
+            .count());
+  }
+
+  asio::any_io_executor executor_;
+  std::vector<lsp::RecordedMessage> messages_;
+  size_t next_ = 0;
+  int epilogue_ = 0;
+  const ReplayOptions& options_;
+  LatencySamples& samples_;
+  Clock::time_point start_;
+
+  // Serialized request ID -> method and send time
+  std::unordered_map<std::string, PendingRequest> pending_requests_;
+  // Document URI -> first unanswered didOpen/didChange
+  std::unordered_map<std::string, Clock::time_point> pending_diagnostics_;
+};
+
+auto PrintReport(LatencySamples& samples) -> void {
+  auto ms = [](int64_t micros) { return static_cast<double>(micros) / 1000.0; };
+  fmt::print(
+      "{:<32} {:>7} {:>9} {:>9} {:>9} {:>9}\n", "method", "count", "p50 ms",
+      "p95 ms", "p99 ms", "max ms");
+  for (auto& [method, latencies] : samples) {
+    std::ranges::sort(latencies);
+    // Nearest-rank percentile
+    auto at = [&](double percentile) {
+      auto rank = static_cast<size_t>(
+          std::ceil(percentile * static_cast<double>(latencies.size())));
+      return latencies[std::clamp<size_t>(rank, 1, latencies.size()) - 1];
+    };
+    fmt::print(
+        "{:<32} {:>7} {:>9.1f} {:>9.1f} {:>9.1f} {:>9.1f}\n", method,
+        latencies.size(), ms(at(0.50)), ms(at(0.95)), ms(at(0.99)),
+        ms(latencies.back()));
+  }
+
+  rusage usage{};
+  getrusage(RUSAGE_SELF, &usage);
+  // ru_maxrss is in kilobytes on Linux
+  fmt::print("peak RSS: {} MB\n", usage.ru_maxrss / 1024);
+}
+
+}  // namespace
+
+auto main(int argc, char* argv[]) -> int {
+  const std::vector<std::string> args(argv, argv + argc);
+  auto options = ParseOptions(args);
+  if (!options) {
+    spdlog::error(
+        "Usage: replay <recording.jsonl> [--workspace=<dir>] "
+        "[--speed=<factor>] [--fast] [--drain-timeout=<seconds>]");
+    return 1;
+  }
+
+  auto recording = lsp::ReadRecording(options->recording);
+  if (!recording) {
+    spdlog::error("{}", recording.error());
+    return 1;
+  }
+  auto messages = PrepareClientMessages(*recording, options->workspace);
+
+  // Server logs would dominate the run time; SPDLOG_LEVEL still overrides
+  setenv("SPDLOG_LEVEL", "warn", /*overwrite=*/0);
+  auto loggers = app::SetupLoggers();
+
+  asio::io_context io_context;
+  auto executor = io_context.get_executor();
+
+  LatencySamples samples;
+  auto transport = std::make_unique<ReplayTransport>(
+      executor, std::move(messages), *options, samples);
+  auto endpoint = std::make_unique<jsonrpc::endpoint::RpcEndpoint>(
+      executor, std::move(transport), loggers["jsonrpc"]);
+  auto language_service = std::make_shared<slangd::services::LanguageService>(
+      executor, loggers["slangd"]);
+  auto server = std::make_unique<slangd::SlangdLspServer>(
+      executor, std::move(endpoint), language_service, loggers["slangd"]);
+
+  int exit_code = 0;
+  asio::co_spawn(
+      io_context,
+      [&server, &exit_code]() -> asio::awaitable<void> {
+        auto result = co_await server->Start();
+        if (!result.has_value()) {
+          spdlog::error("Server error: {}", result.error().Message());
+          exit_code = 1;
+        }
+      },
+      asio::detached);
+
+  auto wall_start = Clock::now();
+  io_context.run();
+  auto wall_time = std::chrono::duration_cast<std::chrono::milliseconds>(
+      Clock::now() - wall_start);
+
+  PrintReport(samples);
+  fmt::print("wall time: {} ms\n", wall_time.count());
+  return exit_code;
+}